@@ -0,0 +1,118 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <glm/ext/vector_float3.hpp>
+
+namespace gmh {
+    class Polygon;
+    class Polyhedron;
+
+    /**
+     * @brief Instruction sets the batch kernels can run on.
+     */
+    enum class SimdLevel {Scalar, SSE, AVX2};
+
+    /**
+     * Best instruction set supported by both the build and the running CPU.
+     */
+    SimdLevel simd_supported();
+
+    /**
+     * Instruction set currently used by dist_many(), contains_many(), raycast_many() and integrate_many().
+     *
+     * Defaults to simd_supported().
+     */
+    SimdLevel simd_level();
+
+    /**
+     * Select the instruction set used by dist_many(), contains_many(), raycast_many() and integrate_many().
+     *
+     * @param level Requested level, lowered to simd_supported() if the CPU lacks it.
+     */
+    void simd_level(SimdLevel level);
+
+    /**
+     * Distance from many points to one shape.
+     *
+     * Equivalent to calling Point::dist() for every point, but runs over
+     * a structure of arrays copy of the shape's cached plane equations
+     * several points at a time.
+     *
+     * @param obj Shape to measure against.
+     * @param points Array of count points.
+     * @param count Number of points.
+     * @param out Array of count distances to write.
+     */
+    void dist_many(const Polygon& obj, const glm::vec3* points, size_t count, float* out);
+    void dist_many(const Polyhedron& obj, const glm::vec3* points, size_t count, float* out);
+
+    /**
+     * Whether each of many points lies in one shape.
+     *
+     * Same tolerance as Point::contains(): a point is contained when
+     * its distance to the shape is below 1e-5.
+     *
+     * @param obj Shape to test against.
+     * @param points Array of count points.
+     * @param count Number of points.
+     * @param out Array of count results to write.
+     */
+    void contains_many(const Polygon& obj, const glm::vec3* points, size_t count, bool* out);
+    void contains_many(const Polyhedron& obj, const glm::vec3* points, size_t count, bool* out);
+
+    /**
+     * @brief Structure of arrays of rays.
+     *
+     * Ray i starts at (ox[i], oy[i], oz[i]) and runs length[i] along the
+     * unit direction (dx[i], dy[i], dz[i]).
+     */
+    struct RaySpan {
+        const float *ox, *oy, *oz, *dx, *dy, *dz, *length;
+        size_t count;
+    };
+
+    /**
+     * @brief Structure of arrays receiving where the rays of a RaySpan hit.
+     *
+     * t[i] is the distance along ray i to the hit, or inf if it misses,
+     * and (nx[i], ny[i], nz[i]) the unit normal there facing the ray, or
+     * zero for a miss.
+     */
+    struct HitSpan {
+        float *t, *nx, *ny, *nz;
+    };
+
+    /**
+     * First point of one shape along many rays.
+     *
+     * Equivalent to calling raycast() from query.hpp for every ray: a
+     * Polyhedron is solid and clips each ray against its face planes,
+     * and a Polygon is hit where the ray crosses it. Runs several rays
+     * at a time straight off the shape's cached plane equations, without
+     * allocating.
+     *
+     * @param obj Shape to cast against.
+     * @param rays Rays to cast.
+     * @param hits Arrays of rays.count entries to write.
+     */
+    void raycast_many(const Polygon& obj, const RaySpan& rays, const HitSpan& hits);
+    void raycast_many(const Polyhedron& obj, const RaySpan& rays, const HitSpan& hits);
+
+    /**
+     * Explicit Euler step of one coordinate of many bodies, x[i] += dt*v[i].
+     *
+     * @param x Array of count positions to update.
+     * @param v Array of count velocities.
+     * @param count Number of bodies.
+     * @param dt Time step.
+     */
+    void integrate_many(float* x, const float* v, size_t count, float dt);
+
+    template<typename T>
+    std::vector<float> dist_many(const T& obj, const std::vector<glm::vec3>& points){
+        std::vector<float> out(points.size());
+        dist_many(obj, points.data(), points.size(), out.data());
+        return out;
+    }
+}
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <glm/common.hpp>
+#include <glm/geometric.hpp>
+#include <glm/ext/vector_float3.hpp>
+#include <glm/ext/matrix_float4x4.hpp>
+
+namespace gmh {
+    /**
+     * @brief Axis aligned bounding box.
+     */
+    struct AABB {
+        glm::vec3 min, max;
+
+        /**
+         * Box covering all of space, the bounds of unbounded shapes.
+         */
+        static inline AABB everywhere(){
+            float inf = std::numeric_limits<float>::infinity();
+            return {glm::vec3(-inf), glm::vec3(inf)};
+        }
+        /**
+         * Smallest box holding count points, of which there must be at least one.
+         */
+        static inline AABB around(const glm::vec3* points, size_t count){
+            AABB out{points[0], points[0]};
+            for(size_t i = 1; i < count; i++) out.add(points[i]);
+            return out;
+        }
+        inline void add(const glm::vec3& p){
+            min = glm::min(min, p);
+            max = glm::max(max, p);
+        }
+        inline void add(const AABB& other){
+            min = glm::min(min, other.min);
+            max = glm::max(max, other.max);
+        }
+        /**
+         * Whether two boxes overlap, counting boxes that only touch.
+         */
+        inline bool overlaps(const AABB& other) const {
+            return min.x <= other.max.x && other.min.x <= max.x &&
+                min.y <= other.max.y && other.min.y <= max.y &&
+                min.z <= other.max.z && other.min.z <= max.z;
+        }
+        inline bool contains(const AABB& other) const {
+            return min.x <= other.min.x && other.max.x <= max.x &&
+                min.y <= other.min.y && other.max.y <= max.y &&
+                min.z <= other.min.z && other.max.z <= max.z;
+        }
+        /**
+         * Distance between the closest points of two boxes, 0 if they overlap.
+         */
+        inline float gap(const AABB& other) const {
+            return glm::length(glm::max(glm::max(other.min - max, min - other.max), glm::vec3(0)));
+        }
+        inline AABB grown(float margin) const {return {min - margin, max + margin};}
+        /**
+         * Box covering this one as it moves by d.
+         */
+        inline AABB swept(const glm::vec3& d) const {return {glm::min(min, min + d), glm::max(max, max + d)};}
+        /**
+         * Box holding this one once moved by mat, from the absolute value of
+         * each entry of its rotation part. Exact for translations, and at
+         * most √3 times as wide as it needs to be otherwise.
+         */
+        inline AABB transformed(const glm::mat4& mat) const {
+            glm::vec3 center = mat*glm::vec4(0.5f*(min + max), 1.0), half(0), size = 0.5f*(max - min);
+            for(unsigned int i = 0; i < 3; i++)
+                for(unsigned int j = 0; j < 3; j++) half[i] += std::abs(mat[j][i])*size[j];
+            return {center - half, center + half};
+        }
+        inline bool operator==(const AABB& other) const {return min == other.min && max == other.max;}
+        inline bool operator!=(const AABB& other) const {return !(*this == other);}
+    };
+
+    /**
+     * @brief Bounding sphere.
+     */
+    struct Sphere {
+        glm::vec3 center;
+        float radius;
+
+        static inline Sphere everywhere(){
+            return {glm::vec3(0), std::numeric_limits<float>::infinity()};
+        }
+        /**
+         * Sphere about center holding count points.
+         */
+        static inline Sphere around(const glm::vec3& center, const glm::vec3* points, size_t count){
+            float r = 0;
+            for(size_t i = 0; i < count; i++) r = std::max(r, glm::distance(center, points[i]));
+            return {center, r};
+        }
+        /**
+         * Distance between the closest points of two spheres, 0 if they overlap.
+         */
+        inline float gap(const Sphere& other) const {
+            return std::max(0.0f, glm::distance(center, other.center) - radius - other.radius);
+        }
+        /**
+         * Sphere holding this one once moved by mat, grown by the longest
+         * axis of mat so that scaling keeps it conservative.
+         */
+        inline Sphere transformed(const glm::mat4& mat) const {
+            float scale = std::max({glm::length(glm::vec3(mat[0])), glm::length(glm::vec3(mat[1])), glm::length(glm::vec3(mat[2]))});
+            return {glm::vec3(mat*glm::vec4(center, 1.0)), scale*radius};
+        }
+    };
+
+    /**
+     * @brief Box and sphere that each hold all of a shape.
+     *
+     * Either can be the tighter of the two, a sphere for round shapes and
+     * a box for long ones, so a lower bound of the distance between two
+     * shapes takes the larger of their gaps.
+     */
+    struct Extent {
+        AABB box;
+        Sphere sphere;
+
+        static inline Extent everywhere(){
+            return {AABB::everywhere(), Sphere::everywhere()};
+        }
+        /**
+         * Box of count points, of which there must be at least one, and the sphere about its center.
+         */
+        static inline Extent around(const glm::vec3* points, size_t count){
+            AABB box = AABB::around(points, count);
+            return {box, Sphere::around(0.5f*(box.min + box.max), points, count)};
+        }
+        inline float gap(const Extent& other) const {
+            return std::max(box.gap(other.box), sphere.gap(other.sphere));
+        }
+        inline Extent transformed(const glm::mat4& mat) const {
+            return {box.transformed(mat), sphere.transformed(mat)};
+        }
+    };
+}
@@ -0,0 +1,89 @@
+#pragma once
+
+#include <set>
+#include <array>
+#include <vector>
+#include <utility>
+#include <glm/ext/vector_float3.hpp>
+#include "Graphics/bounds.hpp"
+#include "Graphics/snapshot.hpp"
+
+namespace gmh {
+    class Point;
+
+    /**
+     * Bounding box of a bounded shape, from the box of Point::extent().
+     *
+     * Exact unless a rotation is pending on the shape, see
+     * AABB::transformed(). Safe to call on one shape from several threads.
+     *
+     * @param obj Shape to bound.
+     * @param margin Distance to grow the box by on every side.
+     */
+    AABB bounds(const Point& obj, float margin = 0);
+
+    /**
+     * @brief Incremental sweep and prune broadphase.
+     *
+     * Keeps the endpoints of every box sorted along each axis, together
+     * with the set of overlapping pairs. Moving a box re-sorts its
+     * endpoints by insertion sort, and every endpoint it passes adds or
+     * removes one candidate pair. For bodies that move a little between
+     * frames the lists stay nearly sorted, so an update costs close to
+     * O(n + changed pairs) rather than the O(n²) of testing every pair.
+     *
+     * Boxes inserted together are sorted and swept in one pass the next
+     * time the structure is used, instead of one at a time.
+     */
+    class SweepAndPrune {
+        struct Endpoint {
+            float value;
+            unsigned int proxy;
+            bool max;
+        };
+        struct Proxy {
+            AABB box;
+            std::array<unsigned int, 3> min, max;
+        };
+        std::array<std::vector<Endpoint>, 3> axes;
+        std::vector<Proxy> proxies;
+        std::vector<unsigned int> unused;
+        std::set<std::pair<unsigned int, unsigned int>> overlap;
+        bool pending = false;
+        void build();
+        void sift(unsigned int axis, unsigned int i);
+        void place(unsigned int axis, unsigned int i);
+        void pair(unsigned int a, unsigned int b, bool add);
+        public:
+            /**
+             * Add a box.
+             *
+             * @return Proxy id of the box, reused after it is removed.
+             */
+            unsigned int insert(const AABB& box);
+
+            /**
+             * Move a box, updating the overlapping pairs.
+             *
+             * Does nothing if the box has not changed.
+             */
+            void update(unsigned int proxy, const AABB& box);
+            void remove(unsigned int proxy);
+            const AABB& box(unsigned int proxy) const {return proxies[proxy].box;}
+
+            /**
+             * Pairs of proxy ids whose boxes overlap, the smaller id first.
+             */
+            const std::set<std::pair<unsigned int, unsigned int>>& pairs();
+
+            /**
+             * Write the sorted endpoints, boxes and overlapping pairs to out.
+             */
+            void snapshot(Snapshot& out) const;
+            /**
+             * Read back what snapshot() wrote, rather than moving every
+             * box back and re-sorting.
+             */
+            void restore(SnapshotReader& in);
+    };
+}
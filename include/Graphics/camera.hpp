@@ -18,6 +18,16 @@ namespace gmh {
             Direction dir;
             Camera(glm::vec3 pos, glm::vec3 up, float yaw, float pitch);
             glm::mat4 view();
+            /**
+             * Direction from pos through a point of the window, for picking with SceneQuery::raycast().
+             *
+             * Matches a projection of glm::perspective(zoom, width/height, ...).
+             *
+             * @param x Cursor position in pixels from the left, as InputHandler reports it.
+             * @param y Cursor position in pixels from the top.
+             * @return Unit direction of the ray.
+             */
+            glm::vec3 through(double x, double y, unsigned int width, unsigned int height) const;
             void update(float dt);
             void set_dir(Direction d);
             void rotate(float dx, float dy, bool constrain = true);
@@ -1,31 +1,311 @@
 #pragma once
 
+#include <map>
 #include <vector>
-#include <unordered_set>
-#include "Graphics/hash.hpp"
+#include <cstdint>
+#include <algorithm>
+#include <tuple>
+#include <unordered_map>
+#include "Graphics/slotmap.hpp"
+#include "Graphics/snapshot.hpp"
+#include "Graphics/broadphase.hpp"
+#include "Graphics/threads.hpp"
+#include "Graphics/gjk.hpp"
+#include "Graphics/sat.hpp"
+#include "Graphics/shape.hpp"
 
 namespace gmh {
     struct Physical {
         Point* obj;
         float mass;
         bool fixed;
+        /** Whether the body is swept for its time of impact, see CHandler::operator()(float). */
+        bool fast = false;
+        /** Resolved type of obj, filled in by CHandler::add(). */
+        Shape shape;
+        /** Bounds of obj as of the last CHandler step. */
+        AABB bounds;
+        /** Broadphase proxy id, none for unbounded shapes. */
+        unsigned int proxy = none;
+        /** Whether the body is asleep, see CHandler::sleeping(). */
+        bool asleep = false;
+        /** Consecutive steps the body has moved slower than the sleep speed. */
+        unsigned int still = 0;
+        /** Island the body sleeps in, while asleep. */
+        SlotId island;
+        /** Translation of the body not yet applied to obj, see CHandler::translate(). */
+        glm::vec3 offset{0};
+        static constexpr unsigned int none = ~0u;
         Point* operator->() const {
             return obj;
         }
     };
 
+    /**
+     * Stable handle to a body registered with a CHandler.
+     */
+    using BodyId = SlotId;
+
+    /**
+     * @brief Contact state of a pair of bodies, kept by CHandler across frames.
+     *
+     * While the pair stays in contact the reference face is only checked
+     * again rather than searched for, and the contact points are refreshed
+     * by clipping against it.
+     */
+    struct Manifold {
+        static constexpr unsigned int none = ~0u;
+        /** Warm start state for gjk(). */
+        Simplex cache;
+        /** Reference face, by index into the faces of the body given by owner (0 or 1), none when not in contact or touching edge to edge. */
+        unsigned int feature = none;
+        unsigned int owner = 0;
+        /** Normal of the reference face, pointing from the first body towards the second. */
+        glm::vec3 normal{0};
+        /** Points of the incident face on or behind the reference face, for Polyhedron pairs. */
+        std::array<glm::vec3, 8> points;
+        unsigned int count = 0;
+        /** Last axis found by sat(), for ContactMethod::SAT. */
+        SatAxis axis;
+        /** Normal impulse the solver converged to on the last step, which the next one starts from. */
+        float impulse = 0;
+        /** Last step the pair reached the narrowphase. */
+        unsigned int stamp = 0;
+    };
+
+    /**
+     * How CHandler finds the contacts of a pair of Polyhedra.
+     *
+     * Clip tests overlap with gjk(), then picks the body whose edges cut
+     * the other least and searches its faces for the reference face.
+     * SAT runs sat() instead of gjk(), which gives the axis of least
+     * penetration and the contact points in one pass, and skips pairs
+     * still apart along the axis that separated them on the last step.
+     * Pairs involving an Instance always use SAT, as an Instance has no
+     * faces of its own to clip against.
+     */
+    enum class ContactMethod {Clip, SAT};
+
     class CHandler {
+        /** A touching pair as seen by the contact solver. */
+        struct Row {
+            Physical* body1;
+            Physical* body2;
+            /** Inverse masses, 0 for fixed bodies. */
+            float w1, w2;
+            /** Contact normal, pointing from body1 towards body2. */
+            glm::vec3 normal;
+            /** Normal velocity the solver drives the pair towards, from restitution. */
+            float target;
+            /** Normal impulse accumulated over the iterations of this step, starting from the last step's, never negative. */
+            float impulse = 0;
+            Manifold* contact;
+            /** Positions of the bodies in iteration order, for coloring. */
+            size_t index1 = 0, index2 = 0;
+        };
         const float elasticity;
-        std::unordered_set<Physical> tangible;
-        std::vector<std::vector<Physical>> get_check() const;
+        ContactMethod method = ContactMethod::Clip;
+        unsigned int solver_iterations = 8;
+        SlotMap<Physical> bodies;
+        std::unordered_map<const Point*, BodyId> ids;
+        std::map<std::pair<BodyId, BodyId>, Manifold> manifolds;
+        unsigned int step = 0;
+        SweepAndPrune broad;
+        /** Bodies by broadphase proxy id. */
+        std::vector<BodyId> proxied;
+        ThreadPool pool;
+        /** Pairs passed to the narrowphase, with their cached contact state. */
+        std::vector<std::tuple<BodyId, BodyId, Manifold*>> candidates;
+        /** Pairs passed to the narrowphase on the last step. */
+        std::vector<std::pair<BodyId, BodyId>> checked;
+        /** Touching pairs found by each thread of the pool. */
+        std::vector<std::vector<std::tuple<BodyId, BodyId, Manifold*>>> contacts;
+        /** World space meshes of the Instances of the pair each thread is checking. */
+        mutable std::vector<std::array<Mesh, 2>> scratch;
+        float sleep_speed = 0.05f;
+        unsigned int sleep_steps = 60;
+        /** Members of each sleeping island. */
+        SlotMap<std::vector<BodyId>> islands;
+        std::vector<unsigned int> group;
+        std::vector<SlotId> root_island;
+        std::vector<char> ready;
+        /** Fraction of what is left of the step each body moves by in a sweep of operator()(float). */
+        std::vector<float> advance;
+        /** Fraction of the step each body has yet to move by in operator()(float). */
+        std::vector<float> left;
+        /** Most sweeps operator()(float) spends on the rest of a step after fast bodies hit something. */
+        static constexpr unsigned int max_sweeps = 4;
+        /** Rows of the touching pairs, then the same grouped by color. */
+        std::vector<Row> rows, colored;
+        /** Start of each color in colored, followed by the start of the pairs solved serially. */
+        std::vector<size_t> colors;
+        /** Colors used by each body so far, one bit each. */
+        std::vector<std::uint64_t> used;
+        const std::set<std::pair<unsigned int, unsigned int>>& get_check();
+        void sleep(const std::vector<std::tuple<BodyId, BodyId, Manifold*>>& touching);
+        void wake_island(SlotId island);
+        bool touching(const Physical& obj1, const Physical& obj2, Manifold& contact, unsigned int worker = 0) const;
+        bool prepare(const Physical& obj1, const Physical& obj2, Manifold& contact) const;
+        bool row(Physical& obj1, Physical& obj2, Manifold& contact, Row& out) const;
+        void color();
+        /** Run f on every row, the rows of a color in parallel. */
+        void sweep(void (*f)(Row&));
+        /** Apply the impulse a row starts with. */
+        static void warm(Row& row);
+        static void solve(Row& row);
         public:
             CHandler();
-            CHandler(float elasticity);
-            void operator()() const;
-            void add(Point* v, float mass = 1.0f, bool fixed = false);
-            void add(Physical t);
+            /**
+             * @param elasticity Coefficient of restitution, between 0 and 1.
+             * @param threads Threads to run the bounds update and narrowphase on, including the caller.
+             *
+             * Contacts are colored and solved in order of body id, so the result does not depend on threads.
+             */
+            CHandler(float elasticity, unsigned int threads = std::thread::hardware_concurrency());
+            void operator()();
+            inline void contact_method(ContactMethod m) {method = m;}
+            inline ContactMethod contact_method() const {return method;}
+            /**
+             * Set how many times the contact solver visits every touching pair per step.
+             *
+             * Contacts are solved as sequential impulses: each pair in
+             * turn gets the normal impulse that brings its relative normal
+             * velocity to the one restitution asks for, accumulated over
+             * the iterations and never pulling the pair together. Pairs
+             * still in contact are warm started with the impulse they
+             * ended the last step with, so resting stacks keep converging
+             * across steps. Pairs are colored so that no two of a color
+             * share a body that moves, and the pairs of a color are
+             * solved in parallel. More iterations let impulses travel
+             * further through stacks.
+             */
+            inline void iterations(unsigned int n) {solver_iterations = std::max(n, 1u);}
+            inline unsigned int iterations() const {return solver_iterations;}
+            /**
+             * Move awake bodies by their velocity over dt, then resolve contacts.
+             *
+             * A fast body first has its motion swept against every body
+             * whose bounds its path crosses, and only moves up to its
+             * earliest time of impact, so that it is stopped by the
+             * contact rather than passing through thin shapes. Once the
+             * contacts are resolved, fast bodies that were stopped sweep
+             * again over the rest of the step with their new velocity, and
+             * so on for up to max_sweeps sweeps in all, each followed by
+             * a contact step. What is left of the step after the last is
+             * dropped. Pairs already touching at the start of a sweep are
+             * left to the contact step, and unbounded shapes are not
+             * swept against.
+             */
+            void operator()(float dt);
+            /**
+             * Register a body.
+             *
+             * @return Handle to the body, or the existing handle if v is already registered.
+             */
+            BodyId add(Point* v, float mass = 1.0f, bool fixed = false, bool fast = false);
+            BodyId add(Physical t);
+            void remove(BodyId id);
             void remove(Point* v);
             void remove(Physical t);
+            /**
+             * @return The body, or nullptr if id was removed.
+             */
+            inline Physical* get(BodyId id) {return bodies.get(id);}
+            inline const Physical* get(BodyId id) const {return bodies.get(id);}
+            /**
+             * @return Handle to the body of v, or an invalid handle if v is not registered.
+             */
+            BodyId id(const Point* v) const;
+            inline size_t size() const {return bodies.size();}
+            /**
+             * Position of a body in iteration order, which changes when other bodies are removed.
+             */
+            inline size_t position(BodyId id) const {return bodies.position(id);}
+            /**
+             * Move a body by d without touching its shape.
+             *
+             * The translation is added to the body's offset and bounds, and
+             * only applied to obj once a query needs its vertices: when the
+             * body reaches the narrowphase, or on materialize(). Until then
+             * obj->pos lags behind by offset.
+             */
+            void translate(BodyId id, const glm::vec3& d);
+            /**
+             * Apply the pending translation of a body, or of every body, to its shape.
+             */
+            void materialize(BodyId id);
+            void materialize();
+            /**
+             * Fraction of its motion over dt a body can make before first
+             * touching another, as used by operator()(float).
+             */
+            float impact(const Physical& body, float dt) const;
+            /**
+             * Set when bodies fall asleep.
+             *
+             * Bodies are grouped into islands connected by contact, not
+             * counting fixed bodies. Once every body of an island has been
+             * slower than speed for steps consecutive steps, the island
+             * sleeps: velocities are zeroed and its bodies skip the bounds
+             * update and the narrowphase until an awake body touches one
+             * of them, or wake() or velocity() is called on one.
+             *
+             * @param speed Speed below which a body counts as still.
+             * @param steps Steps to stay still before sleeping, 0 to never sleep.
+             */
+            void sleeping(float speed, unsigned int steps);
+            /**
+             * Wake a body and the island it sleeps in.
+             *
+             * Needs to be called after moving a sleeping body or setting
+             * its velocity directly.
+             */
+            void wake(BodyId id);
+            /**
+             * Set the velocity of a body, waking it.
+             */
+            void velocity(BodyId id, const glm::vec3& vel);
+            /**
+             * First body hit by a shape moved in a straight line, by toi()
+             * against the bodies whose bounds its path crosses.
+             *
+             * obj is not moved and is skipped if registered. Bounds are
+             * those of the last step, and unbounded bodies are never hit.
+             *
+             * @param obj Bounded shape at the start of the motion.
+             * @param translation Motion of obj.
+             * @param out Fraction of the translation, normal and points of the first impact, only written on a hit.
+             * @return The body hit, or an invalid handle if none is.
+             */
+            BodyId shape_cast(const Point& obj, const glm::vec3& translation, Impact& out) const;
+            /**
+             * Append the state of every body, its shape and velocity, and
+             * the cached contact and sleep state to out.
+             */
+            void snapshot(Snapshot& out) const;
+            /**
+             * Bring back the state written by snapshot(), so that the
+             * following steps repeat bit for bit those that followed it.
+             *
+             * The handler must hold the same bodies as when the snapshot
+             * was taken, and shapes must only have been moved through the
+             * handler since. Only shapes whose vertices moved are rewritten.
+             *
+             * @throws std::invalid_argument If the number of bodies differs.
+             */
+            void restore(SnapshotReader& in);
+            inline void restore(const Snapshot& from){
+                SnapshotReader in(from);
+                restore(in);
+            }
+            /**
+             * @return Cached contact state of a pair, or nullptr if their bounds did not overlap on the last step.
+             */
+            const Manifold* manifold(BodyId id1, BodyId id2) const;
             void collision(Physical& obj1, Physical& obj2) const;
+            /**
+             * Resolve a touching pair on its own, reusing and then updating its cached contact state.
+             */
+            void collision(Physical& obj1, Physical& obj2, Manifold& contact) const;
     };
 }
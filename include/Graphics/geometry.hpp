@@ -4,9 +4,15 @@
 #include <vector>
 #include <memory>
 #include <algorithm>
+#include <atomic>
+#include <mutex>
 #include <glm/ext/vector_float3.hpp>
 #include <glm/ext/matrix_float4x4.hpp>
 #include <glm/gtc/type_ptr.hpp>
+#include "Graphics/mesh.hpp"
+#include "Graphics/bounds.hpp"
+#include "Graphics/intersection.hpp"
+#include "Graphics/snapshot.hpp"
 
 namespace gmh {
 
@@ -58,16 +64,136 @@ class Polygon;
  */
 class Polyhedron;
 
+/**
+ * @brief Read only view of a vector kept by a shape, fetched through
+ * read on every access.
+ *
+ * Lets the vertices, edges and faces members be used like the const
+ * vector references they always were, while read brings the shape up to
+ * date first. Bound to its owner for life, so it is neither copied nor
+ * assigned along with it.
+ */
+template<typename Owner, typename T, const std::vector<T>& (Owner::*read)() const>
+class View {
+    const Owner* owner;
+    public:
+        using const_iterator = typename std::vector<T>::const_iterator;
+        using const_reverse_iterator = typename std::vector<T>::const_reverse_iterator;
+        inline explicit View(const Owner* owner): owner(owner) {}
+        View(const View&) = delete;
+        View& operator=(const View&) = delete;
+        inline operator const std::vector<T>&() const {return (owner->*read)();}
+        inline size_t size() const {return (owner->*read)().size();}
+        inline size_t capacity() const {return (owner->*read)().capacity();}
+        inline bool empty() const {return (owner->*read)().empty();}
+        inline const T& operator[](size_t i) const {return (owner->*read)()[i];}
+        inline const T& at(size_t i) const {return (owner->*read)().at(i);}
+        inline const T& front() const {return (owner->*read)().front();}
+        inline const T& back() const {return (owner->*read)().back();}
+        inline const T* data() const {return (owner->*read)().data();}
+        inline const_iterator begin() const {return (owner->*read)().begin();}
+        inline const_iterator end() const {return (owner->*read)().end();}
+        inline const_iterator cbegin() const {return begin();}
+        inline const_iterator cend() const {return end();}
+        inline const_reverse_iterator rbegin() const {return (owner->*read)().rbegin();}
+        inline const_reverse_iterator rend() const {return (owner->*read)().rend();}
+};
+
 class Point {
     protected:
+        /**
+         * Move of the vertices not yet applied, for shapes that move them lazily.
+         *
+         * Const queries apply the move, and build the vertices, under lock,
+         * and only clear stale and set built once the shape is up to date,
+         * so readers that find neither flag to act on need no lock. Copies
+         * take the move but a lock of their own.
+         */
+        struct Deferred {
+            glm::mat4 mat{1};
+            std::atomic<bool> stale{false};
+            /** Whether v has been built, see expand(). */
+            std::atomic<bool> built{false};
+            mutable std::mutex lock;
+            Deferred() = default;
+            Deferred(const Deferred& other): mat(other.mat), stale(other.stale.load()), built(other.built.load()) {}
+            Deferred& operator=(const Deferred& other){
+                mat = other.mat;
+                stale = other.stale.load();
+                built = other.built.load();
+                return *this;
+            }
+        };
         glm::mat4 model;
         std::vector<std::shared_ptr<Point>> v;
+        /**
+         * Contiguous copy of the vertex positions kept up to date by
+         * refresh(), or nullptr if there is none. Shapes built from
+         * vertices passed by value keep their positions only here until
+         * vertices is read, see expand().
+         */
+        inline virtual glm::vec3* vertex_cache() {return nullptr;}
+        inline const glm::vec3* vertex_cache() const {return const_cast<Point*>(this)->vertex_cache();}
+        /**
+         * Number of vertices, whether or not v holds them yet.
+         */
+        inline virtual size_t vertex_count() const {return v.size();}
+        /**
+         * Build v, and the edges and faces of shapes that have them, from
+         * vertex_cache(). Only called while v is empty.
+         */
+        inline virtual void expand() {}
+        /**
+         * Whether every vertex lies within 1e-5 of obj, for contains().
+         * Shapes that keep their vertices outside v and vertex_cache() override it.
+         */
+        virtual bool inside(const Point &obj) const;
+        /**
+         * Pending move of the vertices, or nullptr for shapes that move
+         * them right away. Shapes whose derived data is costly to rebuild
+         * (Polygon, Polyhedron) override it, see sync().
+         */
+        inline virtual Deferred* deferred() {return nullptr;}
+        inline const Deferred* deferred() const {return const_cast<Point*>(this)->deferred();}
+        /**
+         * Apply the pending move to the vertices, without refresh().
+         *
+         * Leaves stale set for sync() to clear once refresh() is done.
+         */
+        void settle();
+        /**
+         * Vertices brought up to date by sync(), and built first if the
+         * shape only kept their positions, see vertices.
+         */
+        inline const std::vector<std::shared_ptr<Point>>& read_vertices() const {
+            sync();
+            if(Deferred* later = const_cast<Point*>(this)->deferred(); later && !later->built){
+                std::lock_guard<std::mutex> hold(later->lock);
+                if(v.empty()) const_cast<Point*>(this)->expand();
+                later->built = true;
+            }
+            return v;
+        }
     public:
-        const std::vector<std::shared_ptr<Point>>& vertices = v;
+        /**
+         * Vertices of the object, brought up to date by sync() on every access.
+         *
+         * A lazy move only reaches the vertices on the next query, so a
+         * vertex kept from before a translate() or transform() shows the
+         * old position until this, or any other query, is read again.
+         *
+         * Polygons and Polyhedra built from vertices passed by value
+         * only allocate these, and their edges and faces, on the first
+         * access, and from then on carry them along like shapes built
+         * from shared vertices. Like sync(), the first access writes to
+         * the shape.
+         */
+        const View<Point, std::shared_ptr<Point>, &Point::read_vertices> vertices{this};
         glm::vec3 pos;
         glm::vec3 vel;
         Point();
         Point(glm::vec3 pos);
+        Point(const Point& p);
         inline virtual unsigned int dim() const {return 0;}
         inline virtual bool isSpace() const {return true;}
         virtual float dist(const Point &obj) const;
@@ -76,18 +202,115 @@ class Point {
         virtual float dist(const Plane &obj) const;
         virtual float dist(const Polygon &obj) const;
         virtual float dist(const Polyhedron &obj) const;
-        virtual std::unique_ptr<Point> intersect(const Point &obj) const;
-        virtual std::unique_ptr<Point> intersect(const Line &obj) const;
-        virtual std::unique_ptr<Point> intersect(const LinSeg &obj) const;
-        virtual std::unique_ptr<Point> intersect(const Plane &obj) const;
-        virtual std::unique_ptr<Point> intersect(const Polygon &obj) const;
-        virtual std::unique_ptr<Point> intersect(const Polyhedron &obj) const;
+        virtual Intersection intersection(const Point &obj) const;
+        virtual Intersection intersection(const Line &obj) const;
+        virtual Intersection intersection(const LinSeg &obj) const;
+        virtual Intersection intersection(const Plane &obj) const;
+        virtual Intersection intersection(const Polygon &obj) const;
+        virtual Intersection intersection(const Polyhedron &obj) const;
+        /**
+         * Heap allocated form of intersection(), kept for existing callers.
+         */
+        inline std::unique_ptr<Point> intersect(const Point &obj) const {return intersection(obj).object();}
+        inline std::unique_ptr<Point> intersect(const Line &obj) const {return intersection(obj).object();}
+        inline std::unique_ptr<Point> intersect(const LinSeg &obj) const {return intersection(obj).object();}
+        inline std::unique_ptr<Point> intersect(const Plane &obj) const {return intersection(obj).object();}
+        inline std::unique_ptr<Point> intersect(const Polygon &obj) const {return intersection(obj).object();}
+        inline std::unique_ptr<Point> intersect(const Polyhedron &obj) const {return intersection(obj).object();}
         glm::vec3 direction(const Point &obj) const;
+        /**
+         * Box and sphere holding the object, in world space.
+         *
+         * Infinite for lines and planes. Polygons and Polyhedra keep theirs
+         * from the last refresh() and carry it through a pending move, so
+         * like support() it reads through the move and leaves the shape
+         * alone. A pending rotation loosens the box, see AABB::transformed().
+         */
+        virtual Extent extent() const;
+        /**
+         * Lower bound of dist(obj) from the extents of both objects, 0 if they overlap.
+         */
+        inline float gap(const Point &obj) const {return extent().gap(obj.extent());}
+        /**
+         * Whether dist(obj) < r, answered from the extents alone for objects r or more apart.
+         *
+         * Picks the overload of dist() from the static type of obj, as a call to dist() would.
+         */
+        template<typename T>
+        inline bool within(const T &obj, float r) const {return gap(obj) < r && dist(obj) < r;}
         bool contains(const Point &obj) const;
         bool equals(const Point &obj) const;
         void update(float dt);
+        /**
+         * Move the object and its vertices by d, in world space.
+         *
+         * The translation is applied after the model matrix, as
+         * transform() applies mat, so a rotated object moves along the
+         * world axes like its vertices rather than along its own.
+         *
+         * The model matrix and pos move right away. Polygons and
+         * Polyhedra only record the move, which costs the same whatever
+         * the vertex count, and apply it on their next query, see sync().
+         */
+        void translate(const glm::vec3& d);
         void transform(glm::mat4 mat);
+        /**
+         * Recompute data derived from vertex positions.
+         *
+         * Called by update() and transform() on shapes that move their
+         * vertices right away, and by sync() otherwise. Needs to be called
+         * manually if shared vertices are moved through another object.
+         */
+        inline virtual void refresh() {}
+        /**
+         * Bring the vertices and the data derived from them up to date with
+         * the moves recorded since the last query.
+         *
+         * dist(), intersection(), contains() and mesh() call it
+         * themselves, while support() and extent() read through the
+         * pending move and leave the shape alone. The move is applied
+         * under the lock of the shape, so const queries may run on one
+         * shape from several threads, though not alongside a move.
+         */
+        inline void sync() const {
+            Point* self = const_cast<Point*>(this);
+            if(Deferred* later = self->deferred(); later && later->stale){
+                std::lock_guard<std::mutex> hold(later->lock);
+                if(!later->stale) return;
+                self->settle();
+                self->refresh();
+                later->stale = false;
+            }
+        }
+        /**
+         * Furthest point of the object in a direction.
+         *
+         * Used by gjk() and epa(). Only meaningful for bounded objects.
+         *
+         * @param dir Direction to search in, need not be normalized.
+         * @return Vertex with the largest projection onto dir, or pos if there are no vertices.
+         */
+        virtual glm::vec3 support(const glm::vec3& dir) const;
+        /**
+         * Furthest point in a direction, starting the search from a caller
+         * owned vertex index which is updated to the vertex found.
+         *
+         * Shapes that search their mesh (Polygon, Polyhedron) use start as
+         * the hill-climbing seed, others ignore it. Touches no state in the
+         * shape, so queries on one shape can run concurrently as long as
+         * each keeps its own start.
+         */
+        virtual glm::vec3 support(const glm::vec3& dir, unsigned int& start) const;
         inline const float* model_ptr() const {return glm::value_ptr(model);}
+        /**
+         * Write the model matrix, position, velocity, pending move and vertex positions to out.
+         */
+        void snapshot(Snapshot& out) const;
+        /**
+         * Read back what snapshot() wrote. The vertices are only written,
+         * and refresh() only called, if any of them moved since.
+         */
+        void restore(SnapshotReader& in);
         Point& operator=(const Point&);
 };
 
@@ -105,12 +328,12 @@ class Line: public Point {
         virtual float dist(const Plane &obj) const override;
         virtual float dist(const Polygon &obj) const override;
         virtual float dist(const Polyhedron &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Point &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Line &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const LinSeg &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Plane &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Polygon &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Polyhedron &obj) const override;
+        virtual Intersection intersection(const Point &obj) const override;
+        virtual Intersection intersection(const Line &obj) const override;
+        virtual Intersection intersection(const LinSeg &obj) const override;
+        virtual Intersection intersection(const Plane &obj) const override;
+        virtual Intersection intersection(const Polygon &obj) const override;
+        virtual Intersection intersection(const Polyhedron &obj) const override;
         glm::vec3 dirVec() const;
         Point project(const Point &obj) const;
         float angle(const Line &lobj, glm::vec3* axisptr = nullptr);
@@ -126,16 +349,19 @@ class LinSeg: public Line {
         virtual float dist(const Plane &obj) const override;
         virtual float dist(const Polygon &obj) const override;
         virtual float dist(const Polyhedron &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Point &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Line &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const LinSeg &obj) const;
-        virtual std::unique_ptr<Point> intersect(const Plane &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Polygon &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Polyhedron &obj) const override;
+        virtual Intersection intersection(const Point &obj) const override;
+        virtual Intersection intersection(const Line &obj) const override;
+        virtual Intersection intersection(const LinSeg &obj) const override;
+        virtual Intersection intersection(const Plane &obj) const override;
+        virtual Intersection intersection(const Polygon &obj) const override;
+        virtual Intersection intersection(const Polyhedron &obj) const override;
         float length() const;
 };
 
 class Plane: public Point {
+    protected:
+        glm::vec3 n;
+        float d;
     public:
         Plane();
         Plane(Point p1, Point p2, Point p3);
@@ -143,7 +369,10 @@ class Plane: public Point {
         Plane(std::shared_ptr<Point> p1, std::shared_ptr<Point> p2, std::shared_ptr<Point> p3);
         Plane(std::vector<std::shared_ptr<Point>> vert);
         inline virtual unsigned int dim() const override {return 2;}
-        glm::vec3 normVec() const;
+        inline glm::vec3 normVec() const {
+            sync();
+            return n;
+        }
         Point project(const Point &obj) const;
         template<typename T>
         T project(const T &obj) const {
@@ -153,26 +382,53 @@ class Plane: public Point {
             });
             return T(vert);
         }
-        float sign_dist(const Point &obj) const;
+        inline float sign_dist(const Point &obj) const {
+            sync();
+            return glm::dot(n, obj.pos) - d;
+        }
         virtual float dist(const Point &obj) const override;
         virtual float dist(const Line &obj) const override;
         virtual float dist(const LinSeg &obj) const override;
         virtual float dist(const Plane &obj) const override;
         virtual float dist(const Polygon &obj) const override;
         virtual float dist(const Polyhedron &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Point &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Line &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const LinSeg &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Plane &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Polygon &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Polyhedron &obj) const override;
+        virtual Intersection intersection(const Point &obj) const override;
+        virtual Intersection intersection(const Line &obj) const override;
+        virtual Intersection intersection(const LinSeg &obj) const override;
+        virtual Intersection intersection(const Plane &obj) const override;
+        virtual Intersection intersection(const Polygon &obj) const override;
+        virtual Intersection intersection(const Polyhedron &obj) const override;
+        /**
+         * Recompute the cached plane equation n.x = d from the first three vertices.
+         */
+        virtual void refresh() override;
 };
 
 class Polygon: public Plane {
     protected:
         std::vector<std::shared_ptr<LinSeg>> e;
+        Mesh m;
+        /** Extent of the vertices as of the last refresh(), before any pending move. */
+        Extent ext;
+        Deferred moved;
+        /** Tag for the constructor taking a vertex loop already in order. */
+        struct Ordered {};
+        /**
+         * Face of a Polyhedron, sharing its vertices, in the order and
+         * winding of loop and without checking them.
+         */
+        Polygon(std::vector<std::shared_ptr<Point>> loop, Ordered);
+        void index();
+        inline const std::vector<std::shared_ptr<LinSeg>>& read_edges() const {
+            read_vertices();
+            return e;
+        }
+        friend class Polyhedron;
     public:
-        const std::vector<std::shared_ptr<LinSeg>>& edges = e;
+        /**
+         * Edges in order around the polygon, brought up to date like vertices.
+         */
+        const View<Polygon, std::shared_ptr<LinSeg>, &Polygon::read_edges> edges{this};
         Polygon();
         template <typename... Points>
         Polygon(Point p1, Point p2, Point p3, Points... args): Polygon(std::vector<Point>{p1, p2, p3, args...}){};
@@ -180,6 +436,7 @@ class Polygon: public Plane {
         template <typename... Points>
         Polygon(std::shared_ptr<Point> p1, std::shared_ptr<Point> p2, std::shared_ptr<Point> p3, Points... args): Polygon(std::vector<std::shared_ptr<Point>>{p1, p2, p3, args...}){};
         Polygon(std::vector<std::shared_ptr<Point>> vert);
+        Polygon(const Polygon& poly);
         inline virtual bool isSpace() const override {return false;}
         virtual float dist(const Point &obj) const override;
         virtual float dist(const Line &obj) const override;
@@ -187,23 +444,61 @@ class Polygon: public Plane {
         virtual float dist(const Plane &obj) const override;
         virtual float dist(const Polygon &obj) const override;
         virtual float dist(const Polyhedron &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Point &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Line &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const LinSeg &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Plane &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Polygon &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Polyhedron &obj) const override;
+        virtual Intersection intersection(const Point &obj) const override;
+        virtual Intersection intersection(const Line &obj) const override;
+        virtual Intersection intersection(const LinSeg &obj) const override;
+        virtual Intersection intersection(const Plane &obj) const override;
+        virtual Intersection intersection(const Polygon &obj) const override;
+        virtual Intersection intersection(const Polyhedron &obj) const override;
         float area() const;
+        inline const Mesh& mesh() const {
+            sync();
+            return m;
+        }
+        virtual glm::vec3 support(const glm::vec3& dir) const override;
+        virtual glm::vec3 support(const glm::vec3& dir, unsigned int& start) const override;
+        virtual Extent extent() const override;
+        virtual void refresh() override;
         Polygon& operator=(const Polygon& poly);
+    protected:
+        inline virtual glm::vec3* vertex_cache() override {return m.verts.data();}
+        inline virtual size_t vertex_count() const override {return m.verts.size();}
+        virtual void expand() override;
+        inline virtual Deferred* deferred() override {return &moved;}
 };
 
 class Polyhedron: public Point {
     protected:
         std::vector<std::shared_ptr<LinSeg>> e;
         std::vector<std::shared_ptr<Polygon>> f;
+        Mesh m;
+        /** Extent of the vertices as of the last refresh(), before any pending move. */
+        Extent ext;
+        Deferred moved;
+        void hull(const std::vector<glm::vec3>& points);
+        void index();
+        /**
+         * Build the edges and faces from v and the mesh.
+         */
+        void graph();
+        inline const std::vector<std::shared_ptr<LinSeg>>& read_edges() const {
+            read_vertices();
+            return e;
+        }
+        inline const std::vector<std::shared_ptr<Polygon>>& read_faces() const {
+            read_vertices();
+            return f;
+        }
     public:
-        const std::vector<std::shared_ptr<LinSeg>>& edges = e;
-        const std::vector<std::shared_ptr<Polygon>>& faces = f;
+        /**
+         * Edges and faces of the hull, brought up to date like vertices.
+         *
+         * The faces share their vertices with the Polyhedron and are
+         * refreshed by it, never moved on their own, so a face kept from
+         * before a move is stale until these are read again.
+         */
+        const View<Polyhedron, std::shared_ptr<LinSeg>, &Polyhedron::read_edges> edges{this};
+        const View<Polyhedron, std::shared_ptr<Polygon>, &Polyhedron::read_faces> faces{this};
         Polyhedron();
         template <typename... Points>
         Polyhedron(Point p1, Point p2, Point p3, Point p4, Points... args): Polyhedron(std::vector<Point>{p1, p2, p3, p4, args...}){};
@@ -211,6 +506,14 @@ class Polyhedron: public Point {
         template <typename... Points>
         Polyhedron(std::shared_ptr<Point> p1, std::shared_ptr<Point> p2, std::shared_ptr<Point> p3, std::shared_ptr<Point> p4, Points... args): Polyhedron(std::vector<std::shared_ptr<Point>>{p1, p2, p3, p4, args...}){};
         Polyhedron(std::vector<std::shared_ptr<Point>> vert);
+        /**
+         * Polyhedron with the faces of mesh as they are, without taking a hull.
+         *
+         * mesh must already be a closed convex hull, such as the mesh of
+         * another Polyhedron moved as a whole. It is not checked.
+         */
+        explicit Polyhedron(Mesh mesh);
+        Polyhedron(const Polyhedron& poly);
         inline virtual unsigned int dim() const override {return 3;}
         inline virtual bool isSpace() const override {return false;}
         virtual float dist(const Point &obj) const override;
@@ -219,14 +522,36 @@ class Polyhedron: public Point {
         virtual float dist(const Plane &obj) const override;
         virtual float dist(const Polygon &obj) const override;
         virtual float dist(const Polyhedron &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Point &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Line &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const LinSeg &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Plane &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Polygon &obj) const override;
-        virtual std::unique_ptr<Point> intersect(const Polyhedron &obj) const override;
+        virtual Intersection intersection(const Point &obj) const override;
+        virtual Intersection intersection(const Line &obj) const override;
+        virtual Intersection intersection(const LinSeg &obj) const override;
+        virtual Intersection intersection(const Plane &obj) const override;
+        virtual Intersection intersection(const Polygon &obj) const override;
+        virtual Intersection intersection(const Polyhedron &obj) const override;
         float volume() const;
+        inline const Mesh& mesh() const {
+            sync();
+            return m;
+        }
+        /**
+         * Vertex furthest in a direction, hill-climbing over the mesh from
+         * its first vertex.
+         *
+         * Keeps no state between calls, so queries on one shape can run
+         * concurrently. Callers asking in nearby directions should keep
+         * a start of their own and pass it to the other overload, as gjk()
+         * does with Simplex::start.
+         */
+        virtual glm::vec3 support(const glm::vec3& dir) const override;
+        virtual glm::vec3 support(const glm::vec3& dir, unsigned int& start) const override;
+        virtual Extent extent() const override;
+        virtual void refresh() override;
         Polyhedron& operator=(const Polyhedron& poly);
+    protected:
+        inline virtual glm::vec3* vertex_cache() override {return m.verts.data();}
+        inline virtual size_t vertex_count() const override {return m.verts.size();}
+        virtual void expand() override;
+        inline virtual Deferred* deferred() override {return &moved;}
 };
 
 }
@@ -2,6 +2,7 @@
 
 #include <glad/glad.h>
 #include "Graphics/geometry.hpp"
+#include "Graphics/instance.hpp"
 
 namespace gmh {
     class Visual;
@@ -19,6 +20,11 @@ namespace gmh {
             std::vector<unsigned int> IBO_DATA;
         public:
             Visual();
+            /**
+             * Buffers of a template in model space, drawn once for each of
+             * its Instances with the Instance's model matrix.
+             */
+            explicit Visual(const ShapeTemplate& shape);
             Visual(const Visual& obj);
             Visual(Visual&& obj);
             ~Visual();
@@ -0,0 +1,112 @@
+#pragma once
+
+#include <array>
+#include <glm/ext/vector_float3.hpp>
+
+namespace gmh {
+    class Point;
+
+    /**
+     * @brief Warm start state for gjk().
+     *
+     * Stores the support directions that produced the final simplex
+     * of a query. Passing the same Simplex to the next query between
+     * the same pair of shapes rebuilds that simplex on the moved shapes,
+     * which usually converges in one or two iterations.
+     */
+    struct Simplex {
+        std::array<glm::vec3, 4> dir;
+        unsigned int size = 0;
+        /** Hill-climbing start on each shape, see Point::support(). */
+        std::array<unsigned int, 2> start{};
+    };
+
+    /**
+     * Result of a gjk() query.
+     *
+     * p1 and p2 are the closest points on the first and second shape.
+     * When the shapes overlap, dist is 0 and p1, p2 are unspecified.
+     */
+    struct Separation {
+        float dist;
+        glm::vec3 p1, p2;
+    };
+
+    /**
+     * Result of an epa() query.
+     *
+     * normal points from the first shape towards the second, so moving
+     * the second shape by depth*normal separates them. p1 and p2 are the
+     * deepest points of each shape along the normal.
+     */
+    struct Penetration {
+        float depth;
+        glm::vec3 normal;
+        glm::vec3 p1, p2;
+    };
+
+    /**
+     * Result of a toi() query.
+     *
+     * t is the fraction of the motion at which the shapes first come
+     * within tolerance, normal points from the first shape towards the
+     * second and p1, p2 are the closest points at that time.
+     */
+    struct Impact {
+        float t;
+        glm::vec3 normal;
+        glm::vec3 p1, p2;
+    };
+
+    /**
+     * Distance between two convex shapes using GJK.
+     *
+     * Works on any pair of bounded shapes through Point::support()
+     * (Point, LinSeg, Polygon, Polyhedron). Lines and Planes are
+     * unbounded and are not supported. Hill-climbing starts are kept in
+     * cache rather than in the shapes, so queries sharing a shape can run
+     * on several threads as long as each has its own cache.
+     *
+     * @param obj1 First shape.
+     * @param obj2 Second shape.
+     * @param cache Optional warm start state, read and then updated.
+     * @return Distance and closest points of the two shapes.
+     */
+    Separation gjk(const Point& obj1, const Point& obj2, Simplex* cache = nullptr);
+
+    /**
+     * Penetration depth and normal of two overlapping convex shapes using EPA.
+     *
+     * @param obj1 First shape.
+     * @param obj2 Second shape.
+     * @param out Penetration of the shapes, only written on success.
+     * @return False if the shapes do not overlap or do not span three dimensions.
+     */
+    bool epa(const Point& obj1, const Point& obj2, Penetration& out);
+
+    /**
+     * Time of impact of two convex shapes moving in straight lines, using
+     * conservative advancement.
+     *
+     * The shapes are not moved; each step queries gjk() on the translated
+     * shapes and advances by the largest time over which they cannot meet.
+     * The result is never past the first contact. Shapes still apart
+     * after 32 steps, as on a grazing near miss where they barely close
+     * in, are taken to miss rather than be stopped short of contact.
+     *
+     * @param obj1 First shape.
+     * @param d1 Translation of the first shape over the motion.
+     * @param obj2 Second shape.
+     * @param d2 Translation of the second shape over the motion.
+     * @param out Time, normal and points of impact, only written on success.
+     * @param tolerance Distance at which the shapes count as touching.
+     * @return False if the shapes do not come within tolerance during the motion.
+     */
+    bool toi(const Point& obj1, const glm::vec3& d1, const Point& obj2, const glm::vec3& d2, Impact& out, float tolerance = 1e-5f);
+
+    /**
+     * Time of impact of two shapes that start the motion translated by s1 and s2 from where they are.
+     */
+    bool toi(const Point& obj1, const glm::vec3& s1, const glm::vec3& d1, const Point& obj2, const glm::vec3& s2, const glm::vec3& d2,
+             Impact& out, float tolerance = 1e-5f);
+}
@@ -2,6 +2,8 @@
 
 #include <vector>
 #include <array>
+#include <cstddef>
+#include <iterator>
 #include <glm/ext/vector_float3.hpp>
 
 namespace gmh {
@@ -34,21 +36,105 @@ namespace gmh {
             v3[0]*(v1[1]*v2[2] - v2[1]*v1[2]);
     }
 
-    template <typename T, class iter>
-    std::vector<std::vector<T>> combinations(iter first, iter last, int k){
-        std::vector<std::vector<T>> out;
-        if(k == 1){
-            for(iter i = first; i != last; i++) out.emplace_back(std::vector<T>{*i});
-            return out;
-        }
-        for(iter i = first; i != last; i++){
-            std::vector<T> next;
-            for(std::vector<T> end: combinations<T>(std::next(i, 1), last, k-1)){
-                next = {*i};
-                next.insert(next.end(), end.begin(), end.end());
-                out.push_back(next);
-            }
-        }
+    /**
+     * Binomial coefficient.
+     *
+     * @return Number of ways to choose k of n items.
+     */
+    constexpr size_t choose(size_t n, size_t k){
+        if(k > n) return 0;
+        size_t out = 1;
+        for(size_t i = 0; i < k; i++) out = out*(n - i)/(i + 1);
         return out;
     }
+
+    /**
+     * Lazy range over the k element combinations of [first, last).
+     *
+     * Combinations are visited in lexicographic order of position and
+     * each one is a std::array of k iterators into the range, so nothing
+     * is copied or allocated while iterating. The range must outlive
+     * this object and not change while it is in use.
+     *
+     * To split the work across threads, divide [0, size()) into chunks
+     * and start each chunk from at().
+     */
+    template<class iter, size_t k>
+    class Combinations {
+        static_assert(k > 0, "Combinations must have at least one element");
+        iter first, last;
+        size_t n;
+        public:
+            class iterator {
+                std::array<iter, k> idx;
+                iter last;
+                friend class Combinations;
+                iterator(iter last): last(last) {idx.fill(last);}
+                public:
+                    using iterator_category = std::forward_iterator_tag;
+                    using value_type = std::array<iter, k>;
+                    using difference_type = std::ptrdiff_t;
+                    using pointer = const value_type*;
+                    using reference = const value_type&;
+
+                    reference operator*() const {return idx;}
+                    pointer operator->() const {return &idx;}
+                    iterator& operator++(){
+                        for(size_t j = k; j-- > 0;){
+                            iter it = std::next(idx[j]);
+                            size_t m = j;
+                            for(; m < k && it != last; m++, ++it) idx[m] = it;
+                            if(m == k) return *this;
+                        }
+                        idx.fill(last);
+                        return *this;
+                    }
+                    iterator operator++(int){
+                        iterator out = *this;
+                        ++*this;
+                        return out;
+                    }
+                    bool operator==(const iterator& other) const {return idx == other.idx;}
+                    bool operator!=(const iterator& other) const {return !(*this == other);}
+            };
+
+            Combinations(iter first, iter last): first(first), last(last), n(std::distance(first, last)) {}
+
+            /**
+             * @return Number of combinations, n choose k.
+             */
+            size_t size() const {return choose(n, k);}
+            iterator begin() const {return at(0);}
+            iterator end() const {return iterator(last);}
+
+            /**
+             * Combination at a position in iteration order.
+             *
+             * @param r Position of the combination.
+             * @return Iterator to it, or end() if r >= size().
+             */
+            iterator at(size_t r) const {
+                iterator out(last);
+                if(r >= size()) return out;
+                iter it = first;
+                size_t i = 0;
+                for(size_t j = 0; j < k; j++, ++it, i++){
+                    for(size_t c; r >= (c = choose(n - i - 1, k - j - 1)); ++it, i++) r -= c;
+                    out.idx[j] = it;
+                }
+                return out;
+            }
+    };
+
+    /**
+     * All k element combinations of [first, last), generated lazily.
+     *
+     * @code
+     * for(auto [a, b]: combinations<2>(objects.begin(), objects.end())) check(*a, *b);
+     * @endcode
+     */
+    template<size_t k, class iter>
+    Combinations<iter, k> combinations(iter first, iter last){
+        return Combinations<iter, k>(first, last);
+    }
 }
@@ -4,13 +4,10 @@
 
 namespace gmh {
     class Point;
-    struct Physical;
 
     bool operator==(const Point& p1, const Point& p2);
 
     bool operator!=(const Point& p1, const Point& p2);
-
-    bool operator==(const Physical& p1, const Physical& p2);
 }
 
 template<>
@@ -18,7 +15,3 @@ struct std::hash<gmh::Point>{
     size_t operator()(const gmh::Point& p) const;
 };
 
-template<>
-struct std::hash<gmh::Physical>{
-    size_t operator()(const gmh::Physical& p) const;
-};
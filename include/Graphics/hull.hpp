@@ -0,0 +1,44 @@
+#pragma once
+
+#include <vector>
+#include <glm/ext/vector_float3.hpp>
+
+namespace gmh {
+    /**
+     * Outcome of a convex hull construction.
+     *
+     * Anything other than Ok means the input does not span
+     * three dimensions and no hull was produced.
+     */
+    enum class HullStatus {
+        Ok, TooFewPoints, Coincident, Collinear, Coplanar
+    };
+
+    /**
+     * @brief Convex hull of a point set as indices into the input.
+     *
+     * Each face is a convex loop of input indices, with coplanar
+     * triangles already merged. Loops are wound so that the normal
+     * given by the first three indices points into the hull, which
+     * is the orientation Polyhedron uses for its faces.
+     */
+    struct Hull {
+        std::vector<unsigned int> vertices;
+        std::vector<std::vector<unsigned int>> faces;
+    };
+
+    /**
+     * Convex hull of a point set using Quickhull.
+     *
+     * Runs in O(n log n) expected time. Points within eps of the
+     * hull surface are not considered hull vertices, so callers
+     * can compare out.vertices against the input to detect
+     * interior, edge or face points.
+     *
+     * @param points Input points.
+     * @param out Hull of the points, left empty on failure.
+     * @param eps Distance below which a point counts as on a plane.
+     * @return HullStatus::Ok on success, or the kind of degeneracy found.
+     */
+    HullStatus quickhull(const std::vector<glm::vec3>& points, Hull& out, float eps = 1e-5f);
+}
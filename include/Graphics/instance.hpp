@@ -0,0 +1,202 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <glm/ext/vector_float3.hpp>
+#include <glm/ext/matrix_float3x3.hpp>
+#include <glm/ext/matrix_float4x4.hpp>
+#include "Graphics/mesh.hpp"
+#include "Graphics/geometry.hpp"
+
+namespace gmh {
+    /**
+     * @brief Convex hull shared by any number of Instances.
+     *
+     * Holds everything about a shape that does not change when it moves:
+     * the mesh with its plane equations in model space, its mass
+     * properties and the triangles it is drawn with. Templates are only
+     * handed out as std::shared_ptr<const ShapeTemplate>, and live for as
+     * long as an Instance points to them.
+     */
+    class ShapeTemplate {
+        Mesh m;
+        Extent ext;
+        std::vector<unsigned int> tris;
+        float vol;
+        glm::vec3 center;
+        glm::mat3 covariance;
+        explicit ShapeTemplate(const Polyhedron& hull);
+        public:
+            /**
+             * Build a template from the convex hull of points, in model space.
+             *
+             * @throws std::invalid_argument On the same inputs as Polyhedron.
+             */
+            static std::shared_ptr<const ShapeTemplate> make(const std::vector<glm::vec3>& points);
+            inline const Mesh& mesh() const {return m;}
+            /**
+             * Extent of the hull in model space.
+             */
+            inline const Extent& extent() const {return ext;}
+            /**
+             * Vertex indices of the faces split into triangles, three per triangle, wound like the faces.
+             */
+            inline const std::vector<unsigned int>& triangles() const {return tris;}
+            inline float volume() const {return vol;}
+            inline float mass(float density = 1) const {return density*vol;}
+            /**
+             * Center of mass in model space, for a uniform density.
+             */
+            inline const glm::vec3& centroid() const {return center;}
+            /**
+             * Inertia tensor about the centroid, for a uniform density.
+             */
+            glm::mat3 inertia(float density = 1) const;
+    };
+
+    /**
+     * @brief A ShapeTemplate placed in the world.
+     *
+     * Stores no geometry of its own, only the template, the model matrix
+     * and the position and velocity every Point has, so that thousands
+     * of copies of one shape take little more memory than their
+     * transforms. Moving an Instance never touches the template.
+     *
+     * support() and the distances to bounded shapes run gjk() on the
+     * template through the model matrix, so an Instance can be added to a
+     * CHandler like any other body, and touching Instances are resolved
+     * with sat() on meshes brought to world space for the query.
+     * The intersections and the distance to a Line take the other shape
+     * to model space by the inverse of the model matrix and clip it to
+     * the planes of the template there, so none of them builds the hull
+     * in the world.
+     *
+     * Other shapes see an Instance through their dist(const Point&) and
+     * intersection(const Point&), which hand it back to the Instance, so
+     * both orders of a pair give the same answer. The Instance's own
+     * overloads for a Point resolve the dynamic type of their argument,
+     * so a Line or Plane passed as a Point is still treated as unbounded.
+     */
+    class Instance: public Point {
+        std::shared_ptr<const ShapeTemplate> geom;
+        public:
+            /**
+             * @param shape Template to instance, which must not be null.
+             * @param model Placement of the template in the world.
+             */
+            explicit Instance(std::shared_ptr<const ShapeTemplate> shape, const glm::mat4& model = glm::mat4(1));
+            inline virtual unsigned int dim() const override {return 3;}
+            inline virtual bool isSpace() const override {return false;}
+            inline const ShapeTemplate& geometry() const {return *geom;}
+            inline const std::shared_ptr<const ShapeTemplate>& shared() const {return geom;}
+            /**
+             * Model matrix taking the template to the world.
+             */
+            inline const glm::mat4& placement() const {return model;}
+            virtual float dist(const Point &obj) const override;
+            virtual float dist(const Line &obj) const override;
+            virtual float dist(const LinSeg &obj) const override;
+            virtual float dist(const Plane &obj) const override;
+            virtual float dist(const Polygon &obj) const override;
+            virtual float dist(const Polyhedron &obj) const override;
+            float dist(const Instance &obj) const;
+            virtual Intersection intersection(const Point &obj) const override;
+            virtual Intersection intersection(const Line &obj) const override;
+            virtual Intersection intersection(const LinSeg &obj) const override;
+            virtual Intersection intersection(const Plane &obj) const override;
+            virtual Intersection intersection(const Polygon &obj) const override;
+            virtual Intersection intersection(const Polyhedron &obj) const override;
+            Intersection intersection(const Instance &obj) const;
+            virtual glm::vec3 support(const glm::vec3& dir) const override;
+            virtual glm::vec3 support(const glm::vec3& dir, unsigned int& start) const override;
+            /**
+             * Extent of the template through the model matrix.
+             */
+            inline virtual Extent extent() const override {return geom->extent().transformed(model);}
+            /**
+             * Copy the template mesh to out and bring it to world space.
+             *
+             * Reuses the storage of out, so a mesh kept around for the
+             * purpose does not allocate once it has held this template.
+             */
+            void world(Mesh& out) const;
+            /**
+             * Standalone Polyhedron in the place of the Instance.
+             *
+             * Built from the template mesh brought to world space, without
+             * taking the hull again.
+             */
+            Polyhedron polyhedron() const;
+        protected:
+            virtual bool inside(const Point &obj) const override;
+    };
+
+    /**
+     * @brief Many placements of one ShapeTemplate, kept as arrays.
+     *
+     * For scenery of many copies of a shape, such as crates and ramps,
+     * that is drawn and queried more often than it is needed as objects.
+     * Each placement keeps the linear part and origin of its model
+     * matrix and its velocity, 60 B, against 144 B for an Instance, which
+     * has to carry everything a Point has.
+     *
+     * instance() makes an Instance of a placement for queries or a
+     * CHandler, and store() writes it back once it has moved. placement()
+     * is the model matrix to draw a placement with a Visual of the
+     * template.
+     */
+    class InstanceArray {
+        std::shared_ptr<const ShapeTemplate> geom;
+        std::vector<glm::mat3> basis;
+        std::vector<glm::vec3> origin;
+        std::vector<glm::vec3> speed;
+        public:
+            /**
+             * @param shape Template of every placement, which must not be null.
+             */
+            explicit InstanceArray(std::shared_ptr<const ShapeTemplate> shape);
+            /**
+             * Add a placement of the template.
+             *
+             * @param model Placement in the world, of which only the affine part is kept.
+             * @param vel Velocity of the placement.
+             * @return Index of the placement.
+             */
+            size_t add(const glm::mat4& model, const glm::vec3& vel = glm::vec3(0));
+            void reserve(size_t count);
+            inline size_t size() const {return origin.size();}
+            inline const ShapeTemplate& geometry() const {return *geom;}
+            inline const std::shared_ptr<const ShapeTemplate>& shared() const {return geom;}
+            /**
+             * Model matrix of placement i.
+             */
+            glm::mat4 placement(size_t i) const;
+            inline glm::vec3& velocity(size_t i) {return speed[i];}
+            inline const glm::vec3& velocity(size_t i) const {return speed[i];}
+            /**
+             * Extent of placement i, as Instance::extent() gives it.
+             */
+            inline Extent extent(size_t i) const {return geom->extent().transformed(placement(i));}
+            /**
+             * Move placement i by d in world space, like Point::translate().
+             */
+            inline void translate(size_t i, const glm::vec3& d) {origin[i] += d;}
+            /**
+             * Move every placement by its velocity over dt, like Point::update().
+             */
+            void update(float dt);
+            /**
+             * Instance in the place of placement i, with its velocity.
+             */
+            Instance instance(size_t i) const;
+            /**
+             * Take the placement and velocity of obj for placement i, such as
+             * after a CHandler moved an Instance made by instance().
+             */
+            void store(size_t i, const Instance& obj);
+            /**
+             * Bytes held by the arrays, not counting the template.
+             */
+            size_t footprint() const;
+    };
+}
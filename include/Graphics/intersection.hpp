@@ -0,0 +1,113 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <memory>
+#include <glm/ext/vector_float3.hpp>
+#include <glm/ext/vector_float4.hpp>
+#include <glm/ext/matrix_float4x4.hpp>
+#include "Graphics/mesh.hpp"
+
+namespace gmh {
+    class Point;
+
+    /**
+     * @brief Value type result of Point::intersection().
+     *
+     * Holds the kind of shape two objects intersect in and the points
+     * defining it: one for a Point, the two ends of a Segment, two
+     * points on a Line, three points on a Plane, and the vertices of a
+     * Polygon (counterclockwise around its normal) or Polyhedron.
+     * Up to capacity points are stored inline, so Point, Segment, Line
+     * and Plane results and small polygons never touch the heap.
+     */
+    class Intersection {
+        public:
+            enum class Kind {Empty, Point, Segment, Line, Plane, Polygon, Polyhedron};
+            static constexpr unsigned int capacity = 8;
+
+            Intersection() = default;
+            static Intersection point(const glm::vec3& p);
+            static Intersection segment(const glm::vec3& a, const glm::vec3& b);
+            static Intersection line(const glm::vec3& a, const glm::vec3& b);
+            static Intersection plane(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c);
+            /**
+             * Polygon through the vertices of face.
+             */
+            static Intersection polygon(const Mesh::Face& face);
+            /**
+             * Clip a convex face to the intersection of half spaces.
+             *
+             * Sutherland-Hodgman clipping, keeping points p with
+             * dot(plane, p) >= plane.w within 1e-5. The output stays in
+             * the face's winding, so it is neither sorted nor deduplicated
+             * afterwards. Mesh::planes of a Polyhedron and the Mesh::edge_planes
+             * of a face are both in this form.
+             *
+             * @param face Convex face to clip.
+             * @param planes Array of count planes (n, w).
+             * @param count Number of planes.
+             * @return Empty, Point, Segment or Polygon left of the face.
+             */
+            static Intersection clip(const Mesh::Face& face, const glm::vec4* planes, unsigned int count);
+            /**
+             * Clip face, with its vertices moved by mat first, like clip() for faces.
+             */
+            static Intersection clip(const Mesh::Face& face, const glm::mat4& mat, const glm::vec4* planes, unsigned int count);
+            /**
+             * Clip the segment from a to b to the intersection of half spaces, like clip() for faces.
+             */
+            static Intersection clip(const glm::vec3& a, const glm::vec3& b, const glm::vec4* planes, unsigned int count);
+            /**
+             * Clip the whole line through a and b to the intersection of half spaces.
+             *
+             * @return Empty, Point or Segment, or the Line itself if no plane bounds it.
+             */
+            static Intersection clip_line(const glm::vec3& a, const glm::vec3& b, const glm::vec4* planes, unsigned int count);
+
+            inline Kind kind() const {return k;}
+            inline explicit operator bool() const {return k != Kind::Empty;}
+            inline unsigned int size() const {return n;}
+            inline const glm::vec3* begin() const {return spill.empty() ? local.data() : spill.data();}
+            inline const glm::vec3* end() const {return begin() + n;}
+            inline const glm::vec3& operator[](unsigned int i) const {return begin()[i];}
+            /**
+             * Add a point unless one within 1e-5 of it is already stored.
+             */
+            void add(const glm::vec3& p);
+            /**
+             * Set the kind from the points added so far.
+             *
+             * Keeps at most max points, then becomes Empty, Point, Segment
+             * or Polygon depending on how many are left. If solid is set,
+             * more than three points that are not coplanar make a Polyhedron.
+             *
+             * @param max Maximum number of points to keep.
+             * @param solid Whether the points can span three dimensions.
+             * @return Reference to this.
+             */
+            Intersection& resolve(unsigned int max = ~0u, bool solid = false);
+            /**
+             * Move the points by mat, keeping the kind.
+             *
+             * @return Reference to this.
+             */
+            Intersection& transform(const glm::mat4& mat);
+            /**
+             * Heap allocated object equivalent to this intersection.
+             *
+             * @return Matching Point, LinSeg, Line, Plane, Polygon or Polyhedron, or nullptr if Empty.
+             */
+            std::unique_ptr<Point> object() const;
+
+        private:
+            Kind k = Kind::Empty;
+            unsigned int n = 0;
+            std::array<glm::vec3, capacity> local;
+            std::vector<glm::vec3> spill;
+            void push(const glm::vec3& p);
+            bool collapse();
+            /** Clip the polygon held by in, see clip() for faces. */
+            static Intersection cut(Intersection in, const glm::vec4* planes, unsigned int count);
+    };
+}
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <array>
+#include <vector>
+#include <glm/ext/vector_float3.hpp>
+#include <glm/ext/vector_float4.hpp>
+#include <glm/geometric.hpp>
+
+namespace gmh {
+    /**
+     * @brief Contiguous, index based topology of a Polygon or Polyhedron.
+     *
+     * Vertex positions are stored by value in one array, edges as
+     * pairs of vertex indices and faces as runs of vertex indices in
+     * a single array, face i spanning [face_start[i], face_start[i+1]).
+     * Face loops keep the winding of the owning shape, so their normals
+     * point the same way as the corresponding Polygon's normVec().
+     *
+     * Each face also caches its plane equation (n, d) and, for every
+     * edge of its loop, the plane through that edge perpendicular to
+     * the face with its normal pointing into the face. These are only
+     * valid after update_planes(), which the owning shape calls whenever
+     * vertex positions change.
+     *
+     * Closed meshes can also be linked into half-edges with link().
+     * Half-edge k runs from face_idx[k] to the next vertex of the same
+     * face loop, so half-edges share the indexing of face_idx, and each
+     * one knows its twin on the neighboring face. The topology does not
+     * change when vertices move, so links survive update_planes().
+     *
+     * Edge and Face are non owning views into the mesh and are only
+     * valid while the mesh is alive and unmodified.
+     */
+    class Mesh {
+        public:
+            class Edge {
+                const Mesh* m;
+                unsigned int i;
+                public:
+                    Edge(const Mesh* mesh, unsigned int index): m(mesh), i(index) {}
+                    inline const glm::vec3& a() const {return m->verts[m->edge_idx[i][0]];}
+                    inline const glm::vec3& b() const {return m->verts[m->edge_idx[i][1]];}
+                    inline unsigned int index(unsigned int k) const {return m->edge_idx[i][k];}
+                    float dist(const glm::vec3& p) const;
+            };
+
+            class Face {
+                const Mesh* m;
+                unsigned int i;
+                public:
+                    Face(const Mesh* mesh, unsigned int index): m(mesh), i(index) {}
+                    inline unsigned int size() const {return m->face_start[i + 1] - m->face_start[i];}
+                    inline unsigned int index(unsigned int k) const {return m->face_idx[m->face_start[i] + k];}
+                    inline const glm::vec3& operator[](unsigned int k) const {return m->verts[index(k)];}
+                    inline glm::vec3 normal() const {return glm::vec3(m->planes[i]);}
+                    inline float sign_dist(const glm::vec3& p) const {return glm::dot(normal(), p) - m->planes[i].w;}
+                    inline bool inside(const glm::vec3& p) const;
+                    float dist(const glm::vec3& p) const;
+            };
+
+            /**
+             * @brief Directed edge of a face loop.
+             *
+             * twin is none for boundary edges and edge is none if the
+             * edge is missing from edge_idx.
+             */
+            struct HalfEdge {
+                unsigned int origin;
+                unsigned int twin;
+                unsigned int next;
+                unsigned int face;
+                unsigned int edge;
+            };
+            static constexpr unsigned int none = ~0u;
+
+            std::vector<glm::vec3> verts;
+            std::vector<std::array<unsigned int, 2>> edge_idx;
+            std::vector<unsigned int> face_idx;
+            std::vector<unsigned int> face_start{0};
+            std::vector<glm::vec4> planes;
+            std::vector<glm::vec4> edge_planes;
+            std::vector<HalfEdge> half;
+            std::vector<unsigned int> vert_half;
+            std::vector<unsigned int> edge_half;
+
+            inline unsigned int edge_count() const {return static_cast<unsigned int>(edge_idx.size());}
+            inline unsigned int face_count() const {return static_cast<unsigned int>(face_start.size() - 1);}
+            inline Edge edge(unsigned int i) const {return Edge(this, i);}
+            inline Face face(unsigned int i) const {return Face(this, i);}
+            void clear();
+            void add_face(const std::vector<unsigned int>& loop);
+            void update_planes();
+            /**
+             * Build half-edges from the face loops.
+             *
+             * Fills half, one outgoing half-edge per vertex in vert_half and
+             * one half-edge per edge in edge_half.
+             *
+             * @return Whether every half-edge found a twin, ie the mesh is closed.
+             */
+            bool link();
+            inline bool linked() const {return !half.empty();}
+            inline unsigned int target(unsigned int h) const {return half[half[h].next].origin;}
+            /**
+             * Call f with the index of every vertex sharing an edge with vertex v.
+             *
+             * Only complete on closed meshes; on an open one the walk stops at the first boundary edge.
+             */
+            template<typename F>
+            void vertex_ring(unsigned int v, F&& f) const;
+            /**
+             * Call f with the index of every face sharing an edge with face i.
+             */
+            template<typename F>
+            void face_ring(unsigned int i, F&& f) const;
+            /**
+             * Faces on either side of edge i, the second being none on a boundary.
+             */
+            std::array<unsigned int, 2> edge_faces(unsigned int i) const;
+            /**
+             * Vertex furthest in a direction.
+             *
+             * Linked meshes hill-climb from start over vertex_ring(), which
+             * reaches the extreme vertex of a convex mesh while visiting
+             * only a small part of it, and very few vertices when start is
+             * the answer to a nearby direction. Others scan every vertex.
+             *
+             * @param dir Direction to search in.
+             * @param start Vertex to start climbing from.
+             * @return Index of the vertex with the largest projection onto dir.
+             */
+            unsigned int support(const glm::vec3& dir, unsigned int start = 0) const;
+            size_t footprint() const;
+    };
+
+    /**
+     * Whether the projection of p onto the face lies within it.
+     */
+    inline bool Mesh::Face::inside(const glm::vec3& p) const {
+        for(unsigned int k = m->face_start[i]; k < m->face_start[i + 1]; k++){
+            const glm::vec4& e = m->edge_planes[k];
+            if(glm::dot(glm::vec3(e), p) < e.w) return false;
+        }
+        return true;
+    }
+
+    template<typename F>
+    void Mesh::vertex_ring(unsigned int v, F&& f) const {
+        unsigned int start = vert_half[v];
+        unsigned int h = start;
+        do{
+            f(target(h));
+            if(half[h].twin == none) return;
+            h = half[half[h].twin].next;
+        } while(h != start);
+    }
+
+    template<typename F>
+    void Mesh::face_ring(unsigned int i, F&& f) const {
+        for(unsigned int h = face_start[i]; h < face_start[i + 1]; h++)
+            if(half[h].twin != none) f(half[half[h].twin].face);
+    }
+}
@@ -0,0 +1,109 @@
+#pragma once
+
+#include <vector>
+#include <limits>
+#include <glm/ext/vector_float3.hpp>
+#include "Graphics/bounds.hpp"
+#include "Graphics/shape.hpp"
+
+namespace gmh {
+    /**
+     * @brief Where a ray meets a shape.
+     */
+    struct RayHit {
+        /** Shape hit, or nullptr if the ray hit nothing. */
+        const Point* shape = nullptr;
+        /** Distance from the origin of the ray. */
+        float dist = std::numeric_limits<float>::infinity();
+        glm::vec3 point{0};
+        /** Unit normal of the surface hit, facing the ray. */
+        glm::vec3 normal{0};
+        inline explicit operator bool() const {return shape != nullptr;}
+    };
+
+    /**
+     * First point of a shape along a ray.
+     *
+     * Polyhedra and Instances are solid, so a ray starting inside one
+     * hits it at its origin, with the normal facing back along the ray.
+     * Polygons and planes are hit where the ray crosses them. Points,
+     * lines and segments are never hit. Syncs the shape like dist().
+     *
+     * @param obj Shape to cast against.
+     * @param origin Start of the ray.
+     * @param dir Direction of the ray, of unit length.
+     * @param max Length of the ray.
+     * @return The hit, or a RayHit without a shape if the ray misses.
+     */
+    RayHit raycast(const Shape& obj, const glm::vec3& origin, const glm::vec3& dir, float max = std::numeric_limits<float>::infinity());
+
+    /**
+     * @brief Bounding volume hierarchy answering spatial queries over a set of shapes.
+     *
+     * The tree is built top down over the boxes of Point::extent(),
+     * splitting each node where the surface area heuristic estimates the
+     * cheapest traversal, from a fixed number of bins along each axis.
+     * Nodes are stored depth first in one array, a node's first child
+     * right after it, so refit() updates the boxes in a single backward
+     * pass without rebuilding.
+     *
+     * Lines and planes have no bounds, and are kept in a list tested
+     * with every query instead. The shapes are not owned and must
+     * outlive the structure. Queries only read it, so several threads
+     * can query at once, a shape moved since its last query being
+     * synced under its own lock by the first of them.
+     */
+    class SceneQuery {
+        struct Node {
+            AABB box;
+            /** First item of a leaf, or the index of the second child of an inner node. */
+            unsigned int start;
+            /** Number of items of a leaf, 0 for inner nodes. */
+            unsigned int count;
+        };
+        /** Bounded shapes in the order the leaves reference them, and their boxes. */
+        std::vector<Shape> items;
+        std::vector<AABB> boxes;
+        std::vector<Node> nodes;
+        std::vector<Shape> unbounded;
+        void split(std::vector<unsigned int>& order, const std::vector<glm::vec3>& centers, unsigned int start, unsigned int count, unsigned int depth);
+        public:
+            SceneQuery() = default;
+            explicit SceneQuery(const std::vector<const Point*>& shapes);
+            /**
+             * Replace the contents with a tree over shapes.
+             */
+            void build(const std::vector<const Point*>& shapes);
+            /**
+             * Bring the boxes up to date with the shapes after they moved.
+             *
+             * Keeps the layout of the tree, so queries slow down as the
+             * shapes drift from where they were at build(). Rebuild once
+             * they have moved far.
+             */
+            void refit();
+            inline size_t size() const {return items.size() + unbounded.size();}
+            /**
+             * Closest shape along a ray, see raycast(const Shape&, ...).
+             *
+             * @param dir Direction of the ray, need not be normalized.
+             */
+            RayHit raycast(const glm::vec3& origin, const glm::vec3& dir, float max = std::numeric_limits<float>::infinity()) const;
+            /**
+             * Append the shapes whose bounding boxes overlap box to out.
+             */
+            void overlap(const AABB& box, std::vector<const Point*>& out) const;
+            /**
+             * Append the shapes within the radius of the center of sphere to out.
+             */
+            void overlap(const Sphere& sphere, std::vector<const Point*>& out) const;
+            /**
+             * Closest shape to a point.
+             *
+             * @param max Distance beyond which shapes are ignored.
+             * @param dist Set to the distance of the shape found, if not nullptr.
+             * @return The closest shape, or nullptr if none is within max.
+             */
+            const Point* nearest(const glm::vec3& p, float max = std::numeric_limits<float>::infinity(), float* dist = nullptr) const;
+    };
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <array>
+#include <glm/ext/vector_float3.hpp>
+
+namespace gmh {
+    class Mesh;
+
+    /**
+     * @brief Axis found by sat(), named by the features it came from.
+     *
+     * Passing the same SatAxis to the next query between the same pair
+     * tests that axis first, so a pair that stays apart usually costs a
+     * single support query. A pair that overlaps along it is searched
+     * again, but one resting on the other keeps the axis unless another
+     * is shallower by more than a small slop.
+     */
+    struct SatAxis {
+        enum class Kind: unsigned char {None, Face1, Face2, Edges};
+        Kind kind = Kind::None;
+        /** Face of the first or second mesh, or edge of the first mesh for Edges. */
+        unsigned int i = 0;
+        /** Edge of the second mesh for Edges. */
+        unsigned int j = 0;
+        /** Vertex of the other mesh furthest along a face axis, where the next support query starts. */
+        unsigned int start = 0;
+    };
+
+    /**
+     * Result of a sat() query.
+     *
+     * separation is positive if the meshes are apart along normal, which
+     * points from the first mesh towards the second, and minus the depth
+     * of penetration otherwise. When they are within tolerance, points
+     * holds the contact points: the face of one mesh most opposed to the
+     * reference face, clipped to it, or the closest points of two edges.
+     */
+    struct SatContact {
+        float separation;
+        glm::vec3 normal;
+        std::array<glm::vec3, 8> points;
+        unsigned int count = 0;
+    };
+
+    /**
+     * Separating axis test of two convex, closed meshes.
+     *
+     * Tests the face normals of both meshes and, for the pairs of edges
+     * whose Gauss map arcs cross, the cross product of their directions.
+     * The axis of largest separation is returned, preferring face axes to
+     * edge axes and faces of the first mesh to faces of the second when
+     * they are within tolerance of each other.
+     *
+     * @param m1 First mesh.
+     * @param m2 Second mesh.
+     * @param axis Axis to try first, updated to the axis found.
+     * @param tolerance Separation up to which the meshes count as touching and get contact points.
+     */
+    SatContact sat(const Mesh& m1, const Mesh& m2, SatAxis& axis, float tolerance = 1e-5f);
+
+    /**
+     * Clip the face of other most opposed to face ref_face of ref against
+     * the side planes of ref_face, keeping the points on or behind it.
+     *
+     * @return Number of points written to out.
+     */
+    unsigned int clip_contacts(const Mesh& ref, unsigned int ref_face, const Mesh& other, std::array<glm::vec3, 8>& out);
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include <variant>
+#include <cstddef>
+#include "Graphics/geometry.hpp"
+#include "Graphics/instance.hpp"
+
+namespace gmh {
+    /**
+     * @brief Non-owning handle to a shape with its concrete type resolved.
+     *
+     * The alternatives are ordered by rank. Pair queries on two handles
+     * are dispatched through a table built at compile time by std::visit
+     * and call the implementation on the higher ranked shape directly,
+     * without going through the vtable, so each unordered pair of types
+     * runs one implementation whichever side it is called from.
+     */
+    using Shape = std::variant<const Point*, const Line*, const LinSeg*, const Plane*, const Polygon*, const Polyhedron*, const Instance*>;
+
+    /**
+     * Resolve the concrete type of obj once.
+     *
+     * Classes derived from the geometry types, like Surface and Solid,
+     * resolve to the geometry type they derive from. Instances resolve
+     * to Instance.
+     *
+     * @param obj Object to make a handle to, which must outlive the handle.
+     * @return Handle to obj.
+     * @throws std::invalid_argument If obj derives from Point alone.
+     */
+    Shape shape(const Point& obj);
+
+    /**
+     * Concrete object behind a handle.
+     *
+     * @return Pointer to the object if obj holds a T, nullptr otherwise.
+     */
+    template<typename T>
+    inline const T* shape_cast(const Shape& obj){
+        const T* const* p = std::get_if<const T*>(&obj);
+        return p ? *p:nullptr;
+    }
+
+    namespace detail {
+        template<typename T>
+        constexpr size_t rank = Shape(static_cast<const T*>(nullptr)).index();
+
+        template<typename X, typename Y>
+        inline float dist(const X* x, const Y* y){
+            if constexpr(rank<X> >= rank<Y>) return x->X::dist(*y);
+            else return y->Y::dist(*x);
+        }
+
+        template<typename X, typename Y>
+        inline Intersection intersection(const X* x, const Y* y){
+            if constexpr(rank<X> >= rank<Y>) return x->X::intersection(*y);
+            else return y->Y::intersection(*x);
+        }
+    }
+
+    /**
+     * Distance between two shapes, equal to a->dist(*b).
+     */
+    inline float dist(const Shape& a, const Shape& b){
+        return std::visit([](auto* x, auto* y){return detail::dist(x, y);}, a, b);
+    }
+
+    /**
+     * Intersection of two shapes, equal to a->intersection(*b) up to the order of its points.
+     */
+    inline Intersection intersection(const Shape& a, const Shape& b){
+        return std::visit([](auto* x, auto* y){return detail::intersection(x, y);}, a, b);
+    }
+
+    /**
+     * Distance from one shape to many.
+     *
+     * The type of obj is dispatched once for the whole batch.
+     *
+     * @param obj Shape to measure from.
+     * @param others Array of count shapes.
+     * @param count Number of shapes.
+     * @param out Array of count distances to write.
+     */
+    inline void dist_many(const Shape& obj, const Shape* others, size_t count, float* out){
+        std::visit([others, count, out](auto* x){
+            for(size_t i = 0; i < count; i++) out[i] = std::visit([x](auto* y){return detail::dist(x, y);}, others[i]);
+        }, obj);
+    }
+}
@@ -0,0 +1,334 @@
+#pragma once
+
+/**
+ * Kernels behind dist_many(), contains_many(), raycast_many() and integrate_many().
+ *
+ * Only meant to be included by batch.cpp and batch_avx2.cpp. Everything
+ * apart from Planes and the AVX2 entry points has internal linkage, so
+ * each translation unit keeps its own copy compiled for its own
+ * instruction set and the linker cannot mix them up. For the same
+ * reason the vector kernels must not call inline glm or standard
+ * library functions, which would be emitted with AVX2 encodings and
+ * could be picked up by the rest of the library.
+ */
+
+#include <cmath>
+#include <limits>
+#include <cstddef>
+#include "Graphics/batch.hpp"
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define GH_SIMD_SSE 1
+#include <immintrin.h>
+#endif
+
+namespace gmh::simd {
+    /**
+     * @brief Structure of arrays view of a shape's plane equations.
+     *
+     * Face f has plane (fx, fy, fz).p = fd with an inward normal, and
+     * edge planes e in [fstart[f], fstart[f+1]) pointing into the face.
+     * Segment s starts at (sx, sy, sz), has direction (tx, ty, tz) and
+     * il is one over its squared length. solid marks a Polyhedron, whose
+     * interior is at distance 0.
+     */
+    struct Planes {
+        const float *fx, *fy, *fz, *fd;
+        const unsigned int* fstart;
+        unsigned int faces;
+        const float *ex, *ey, *ez, *ed;
+        const float *sx, *sy, *sz, *tx, *ty, *tz, *il;
+        unsigned int segs;
+        bool solid;
+    };
+
+    /**
+     * @brief View of a shape's plane equations as Mesh stores them, four floats each.
+     *
+     * A solid is the inner side of all count face planes. Otherwise the
+     * shape is the first face, bounded by its edge_count edge planes.
+     */
+    struct Faces {
+        const float* planes;
+        unsigned int count;
+        const float* edges;
+        unsigned int edge_count;
+        bool solid;
+    };
+
+    extern const bool avx2_built;
+    void dist_avx2(const Planes& s, const float* xyz, size_t count, float* out);
+    void contains_avx2(const Planes& s, const float* xyz, size_t count, bool* out);
+    void cast_avx2(const Faces& s, const RaySpan& rays, const HitSpan& hits);
+    void integrate_avx2(float* x, const float* v, size_t count, float dt);
+
+    namespace {
+        constexpr float inf = std::numeric_limits<float>::infinity();
+        constexpr float eps = 1e-5f;
+
+        struct Scalar {
+            using V = float;
+            using M = bool;
+            static constexpr unsigned int W = 1;
+            static inline V set(float a){return a;}
+            static inline V load(const float* p){return *p;}
+            static inline V loadu(const float* p){return *p;}
+            static inline void store(float* p, V v){*p = v;}
+            static inline void storeu(float* p, V v){*p = v;}
+            static inline V add(V a, V b){return a + b;}
+            static inline V sub(V a, V b){return a - b;}
+            static inline V mul(V a, V b){return a*b;}
+            static inline V div(V a, V b){return a/b;}
+            static inline V fma(V a, V b, V c){return a*b + c;}
+            static inline V min(V a, V b){return a < b ? a : b;}
+            static inline V max(V a, V b){return a > b ? a : b;}
+            static inline V sqrt(V a){return std::sqrt(a);}
+            static inline V abs(V a){return a < 0 ? -a : a;}
+            static inline M lt(V a, V b){return a < b;}
+            static inline M ge(V a, V b){return a >= b;}
+            static inline M none(){return false;}
+            static inline M all(){return true;}
+            static inline M and_(M a, M b){return a && b;}
+            static inline M or_(M a, M b){return a || b;}
+            static inline V select(M m, V a, V b){return m ? a : b;}
+            static inline unsigned int bits(M m){return m ? 1 : 0;}
+        };
+
+#ifdef GH_SIMD_SSE
+        struct SSE {
+            using V = __m128;
+            using M = __m128;
+            static constexpr unsigned int W = 4;
+            static inline V set(float a){return _mm_set1_ps(a);}
+            static inline V load(const float* p){return _mm_load_ps(p);}
+            static inline V loadu(const float* p){return _mm_loadu_ps(p);}
+            static inline void store(float* p, V v){_mm_store_ps(p, v);}
+            static inline void storeu(float* p, V v){_mm_storeu_ps(p, v);}
+            static inline V add(V a, V b){return _mm_add_ps(a, b);}
+            static inline V sub(V a, V b){return _mm_sub_ps(a, b);}
+            static inline V mul(V a, V b){return _mm_mul_ps(a, b);}
+            static inline V div(V a, V b){return _mm_div_ps(a, b);}
+            static inline V fma(V a, V b, V c){return _mm_add_ps(_mm_mul_ps(a, b), c);}
+            static inline V min(V a, V b){return _mm_min_ps(a, b);}
+            static inline V max(V a, V b){return _mm_max_ps(a, b);}
+            static inline V sqrt(V a){return _mm_sqrt_ps(a);}
+            static inline V abs(V a){return _mm_andnot_ps(_mm_set1_ps(-0.0f), a);}
+            static inline M lt(V a, V b){return _mm_cmplt_ps(a, b);}
+            static inline M ge(V a, V b){return _mm_cmpge_ps(a, b);}
+            static inline M none(){return _mm_setzero_ps();}
+            static inline M all(){return _mm_castsi128_ps(_mm_set1_epi32(-1));}
+            static inline M and_(M a, M b){return _mm_and_ps(a, b);}
+            static inline M or_(M a, M b){return _mm_or_ps(a, b);}
+            static inline V select(M m, V a, V b){return _mm_or_ps(_mm_and_ps(m, a), _mm_andnot_ps(m, b));}
+            static inline unsigned int bits(M m){return static_cast<unsigned int>(_mm_movemask_ps(m));}
+        };
+#endif
+
+#ifdef __AVX2__
+        struct AVX2 {
+            using V = __m256;
+            using M = __m256;
+            static constexpr unsigned int W = 8;
+            static inline V set(float a){return _mm256_set1_ps(a);}
+            static inline V load(const float* p){return _mm256_load_ps(p);}
+            static inline V loadu(const float* p){return _mm256_loadu_ps(p);}
+            static inline void store(float* p, V v){_mm256_store_ps(p, v);}
+            static inline void storeu(float* p, V v){_mm256_storeu_ps(p, v);}
+            static inline V add(V a, V b){return _mm256_add_ps(a, b);}
+            static inline V sub(V a, V b){return _mm256_sub_ps(a, b);}
+            static inline V mul(V a, V b){return _mm256_mul_ps(a, b);}
+            static inline V div(V a, V b){return _mm256_div_ps(a, b);}
+            static inline V fma(V a, V b, V c){return _mm256_fmadd_ps(a, b, c);}
+            static inline V min(V a, V b){return _mm256_min_ps(a, b);}
+            static inline V max(V a, V b){return _mm256_max_ps(a, b);}
+            static inline V sqrt(V a){return _mm256_sqrt_ps(a);}
+            static inline V abs(V a){return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), a);}
+            static inline M lt(V a, V b){return _mm256_cmp_ps(a, b, _CMP_LT_OQ);}
+            static inline M ge(V a, V b){return _mm256_cmp_ps(a, b, _CMP_GE_OQ);}
+            static inline M none(){return _mm256_setzero_ps();}
+            static inline M all(){return _mm256_castsi256_ps(_mm256_set1_epi32(-1));}
+            static inline M and_(M a, M b){return _mm256_and_ps(a, b);}
+            static inline M or_(M a, M b){return _mm256_or_ps(a, b);}
+            static inline V select(M m, V a, V b){return _mm256_blendv_ps(b, a, m);}
+            static inline unsigned int bits(M m){return static_cast<unsigned int>(_mm256_movemask_ps(m));}
+        };
+#endif
+
+        /**
+         * Distance of L::W points to the shape.
+         *
+         * With contains set, points that are certainly further than eps
+         * get inf instead of their distance, skipping the edge loop.
+         */
+        template<typename L>
+        inline typename L::V block(const Planes& s, typename L::V x, typename L::V y, typename L::V z, bool contains){
+            using V = typename L::V;
+            using M = typename L::M;
+            constexpr unsigned int full = (1u << L::W) - 1;
+            V result = L::set(inf);
+            M decided = L::none();
+            if(s.solid){
+                V depth = L::set(-inf);
+                for(unsigned int f = 0; f < s.faces; f++){
+                    V sd = L::fma(L::set(s.fx[f]), x, L::fma(L::set(s.fy[f]), y, L::fma(L::set(s.fz[f]), z, L::set(-s.fd[f]))));
+                    depth = L::max(depth, L::sub(L::set(0), sd));
+                }
+                M in = L::ge(L::set(0), depth);
+                decided = contains ? L::or_(in, L::ge(depth, L::set(eps))) : in;
+                result = L::select(in, L::set(0), result);
+            }
+            else if(contains){
+                V sd = L::fma(L::set(s.fx[0]), x, L::fma(L::set(s.fy[0]), y, L::fma(L::set(s.fz[0]), z, L::set(-s.fd[0]))));
+                decided = L::ge(L::abs(sd), L::set(eps));
+            }
+            if(L::bits(decided) == full) return result;
+            V best = L::set(inf);
+            M hit = decided;
+            for(unsigned int f = 0; f < s.faces; f++){
+                V sd = L::fma(L::set(s.fx[f]), x, L::fma(L::set(s.fy[f]), y, L::fma(L::set(s.fz[f]), z, L::set(-s.fd[f]))));
+                M inside = s.solid ? L::lt(sd, L::set(0)) : L::all();
+                for(unsigned int e = s.fstart[f]; e < s.fstart[f + 1] && L::bits(inside); e++){
+                    V ed = L::fma(L::set(s.ex[e]), x, L::fma(L::set(s.ey[e]), y, L::fma(L::set(s.ez[e]), z, L::set(-s.ed[e]))));
+                    inside = L::and_(inside, L::ge(ed, L::set(0)));
+                }
+                best = L::min(best, L::select(inside, L::abs(sd), L::set(inf)));
+                hit = L::or_(hit, inside);
+            }
+            if(L::bits(hit) != full){
+                V best2 = L::set(inf);
+                for(unsigned int i = 0; i < s.segs; i++){
+                    V dx = L::sub(x, L::set(s.sx[i]));
+                    V dy = L::sub(y, L::set(s.sy[i]));
+                    V dz = L::sub(z, L::set(s.sz[i]));
+                    V tx = L::set(s.tx[i]), ty = L::set(s.ty[i]), tz = L::set(s.tz[i]);
+                    V t = L::mul(L::fma(dx, tx, L::fma(dy, ty, L::mul(dz, tz))), L::set(s.il[i]));
+                    t = L::min(L::max(t, L::set(0)), L::set(1));
+                    dx = L::sub(dx, L::mul(t, tx));
+                    dy = L::sub(dy, L::mul(t, ty));
+                    dz = L::sub(dz, L::mul(t, tz));
+                    best2 = L::min(best2, L::fma(dx, dx, L::fma(dy, dy, L::mul(dz, dz))));
+                }
+                best = L::min(best, L::sqrt(best2));
+            }
+            return L::select(decided, result, best);
+        }
+
+        /**
+         * Run block() over count points stored as xyz triples.
+         *
+         * Writes distances to dist, or containment to contained if it is not null.
+         */
+        template<typename L>
+        void run(const Planes& s, const float* xyz, size_t count, float* dist, bool* contained){
+            alignas(32) float px[L::W], py[L::W], pz[L::W], out[L::W];
+            for(size_t i = 0; i < count; i += L::W){
+                size_t n = count - i < L::W ? count - i : L::W;
+                for(unsigned int k = 0; k < L::W; k++){
+                    const float* p = xyz + 3*(i + (k < n ? k : n - 1));
+                    px[k] = p[0];
+                    py[k] = p[1];
+                    pz[k] = p[2];
+                }
+                L::store(out, block<L>(s, L::load(px), L::load(py), L::load(pz), contained != nullptr));
+                for(unsigned int k = 0; k < n; k++){
+                    if(contained) contained[i + k] = out[k] < eps;
+                    else dist[i + k] = out[k];
+                }
+            }
+        }
+
+        /**
+         * Distance t along L::W rays to the shape, inf for those that
+         * miss, and the normal n there facing the ray.
+         *
+         * A solid is clipped as in Cyrus-Beck: the ray enters through the
+         * last plane it crosses going in and leaves through the first it
+         * crosses going out. Rays starting inside hit at 0, with the
+         * normal facing back along the ray.
+         */
+        template<typename L>
+        inline void ray_block(const Faces& s, const typename L::V o[3], const typename L::V d[3], typename L::V length, typename L::V& t, typename L::V n[3]){
+            using V = typename L::V;
+            using M = typename L::M;
+            constexpr unsigned int full = (1u << L::W) - 1;
+            V zero = L::set(0);
+            M hit;
+            if(s.solid){
+                V in = zero, out = length;
+                for(unsigned int k = 0; k < 3; k++) n[k] = L::sub(zero, d[k]);
+                for(unsigned int f = 0; f < s.count; f++){
+                    const float* p = s.planes + 4*f;
+                    V sd = L::fma(L::set(p[0]), o[0], L::fma(L::set(p[1]), o[1], L::fma(L::set(p[2]), o[2], L::set(-p[3]))));
+                    V speed = L::fma(L::set(p[0]), d[0], L::fma(L::set(p[1]), d[1], L::mul(L::set(p[2]), d[2])));
+                    V cross = L::div(sd, L::sub(zero, speed));
+                    M enters = L::and_(L::lt(zero, speed), L::lt(in, cross));
+                    in = L::select(enters, cross, in);
+                    for(unsigned int k = 0; k < 3; k++) n[k] = L::select(enters, L::set(-p[k]), n[k]);
+                    out = L::select(L::and_(L::lt(speed, zero), L::lt(cross, out)), cross, out);
+                    // Parallel to the plane and outside it, so never entering.
+                    out = L::select(L::and_(L::lt(sd, zero), L::and_(L::ge(speed, zero), L::ge(zero, speed))), L::set(-inf), out);
+                    if(L::bits(L::lt(out, in)) == full) break;
+                }
+                hit = L::ge(out, in);
+                t = in;
+            }
+            else{
+                const float* p = s.planes;
+                V sd = L::fma(L::set(p[0]), o[0], L::fma(L::set(p[1]), o[1], L::fma(L::set(p[2]), o[2], L::set(-p[3]))));
+                V speed = L::fma(L::set(p[0]), d[0], L::fma(L::set(p[1]), d[1], L::mul(L::set(p[2]), d[2])));
+                t = L::div(sd, L::sub(zero, speed));
+                hit = L::and_(L::or_(L::lt(speed, zero), L::lt(zero, speed)), L::and_(L::ge(t, zero), L::ge(length, t)));
+                V x = L::fma(t, d[0], o[0]), y = L::fma(t, d[1], o[1]), z = L::fma(t, d[2], o[2]);
+                for(unsigned int e = 0; e < s.edge_count && L::bits(hit); e++){
+                    const float* q = s.edges + 4*e;
+                    V ed = L::fma(L::set(q[0]), x, L::fma(L::set(q[1]), y, L::fma(L::set(q[2]), z, L::set(-q[3]))));
+                    hit = L::and_(hit, L::ge(ed, zero));
+                }
+                M facing = L::lt(speed, zero);
+                for(unsigned int k = 0; k < 3; k++) n[k] = L::select(facing, L::set(p[k]), L::set(-p[k]));
+            }
+            t = L::select(hit, t, L::set(inf));
+            for(unsigned int k = 0; k < 3; k++) n[k] = L::select(hit, n[k], zero);
+        }
+
+        /**
+         * Run ray_block() over every ray of a RaySpan.
+         */
+        template<typename L>
+        void cast(const Faces& s, const RaySpan& rays, const HitSpan& hits){
+            using V = typename L::V;
+            const float* in[7] = {rays.ox, rays.oy, rays.oz, rays.dx, rays.dy, rays.dz, rays.length};
+            float* out[4] = {hits.t, hits.nx, hits.ny, hits.nz};
+            alignas(32) float buf[7][L::W], res[4][L::W];
+            V r[7], t, n[3];
+            for(size_t i = 0; i < rays.count; i += L::W){
+                size_t m = rays.count - i < L::W ? rays.count - i : L::W;
+                if(m == L::W) for(unsigned int j = 0; j < 7; j++) r[j] = L::loadu(in[j] + i);
+                else for(unsigned int j = 0; j < 7; j++){
+                    for(unsigned int k = 0; k < L::W; k++) buf[j][k] = in[j][i + (k < m ? k : m - 1)];
+                    r[j] = L::load(buf[j]);
+                }
+                ray_block<L>(s, r, r + 3, r[6], t, n);
+                if(m == L::W){
+                    L::storeu(out[0] + i, t);
+                    for(unsigned int k = 0; k < 3; k++) L::storeu(out[k + 1] + i, n[k]);
+                    continue;
+                }
+                L::store(res[0], t);
+                for(unsigned int k = 0; k < 3; k++) L::store(res[k + 1], n[k]);
+                for(unsigned int j = 0; j < 4; j++)
+                    for(unsigned int k = 0; k < m; k++) out[j][i + k] = res[j][k];
+            }
+        }
+
+        /**
+         * x += dt*v over count floats, with no alignment requirement.
+         */
+        template<typename L>
+        void integrate(float* x, const float* v, size_t count, float dt){
+            size_t i = 0;
+            for(; i + L::W <= count; i += L::W) L::storeu(x + i, L::fma(L::loadu(v + i), L::set(dt), L::loadu(x + i)));
+            for(; i < count; i++) x[i] = Scalar::fma(v[i], dt, x[i]);
+        }
+    }
+}
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <vector>
+#include <cstddef>
+#include <utility>
+#include "Graphics/snapshot.hpp"
+
+namespace gmh {
+    /**
+     * @brief Stable handle to an element of a SlotMap.
+     *
+     * The generation changes whenever a slot is freed, so a handle to a
+     * removed element never refers to whatever later reuses its slot.
+     */
+    struct SlotId {
+        unsigned int index = ~0u;
+        unsigned int generation = 0;
+        inline bool operator==(const SlotId& other) const {return index == other.index && generation == other.generation;}
+        inline bool operator!=(const SlotId& other) const {return !(*this == other);}
+        inline bool operator<(const SlotId& other) const {
+            return index < other.index || (index == other.index && generation < other.generation);
+        }
+    };
+
+    /**
+     * @brief Generational slot map.
+     *
+     * Elements are stored contiguously and iterate in that order. Insert
+     * and erase are O(1): erasing moves the last element into the hole,
+     * and a table of slots maps each SlotId to the element's current
+     * position.
+     */
+    template<typename T>
+    class SlotMap {
+        struct Slot {
+            unsigned int dense;
+            unsigned int generation;
+        };
+        std::vector<T> values;
+        std::vector<unsigned int> owner;
+        std::vector<Slot> slots;
+        std::vector<unsigned int> unused;
+        public:
+            SlotId insert(T value){
+                unsigned int index;
+                if(unused.empty()){
+                    index = slots.size();
+                    slots.push_back({0, 0});
+                }
+                else{
+                    index = unused.back();
+                    unused.pop_back();
+                }
+                slots[index].dense = values.size();
+                values.push_back(std::move(value));
+                owner.push_back(index);
+                return {index, slots[index].generation};
+            }
+
+            /**
+             * Remove an element.
+             *
+             * @return Whether id referred to an element.
+             */
+            bool erase(SlotId id){
+                if(!contains(id)) return false;
+                unsigned int dense = slots[id.index].dense;
+                if(dense + 1 != values.size()){
+                    values[dense] = std::move(values.back());
+                    owner[dense] = owner.back();
+                    slots[owner[dense]].dense = dense;
+                }
+                values.pop_back();
+                owner.pop_back();
+                slots[id.index].generation++;
+                unused.push_back(id.index);
+                return true;
+            }
+
+            inline bool contains(SlotId id) const {
+                return id.index < slots.size() && slots[id.index].generation == id.generation;
+            }
+
+            /**
+             * @return Pointer to the element, or nullptr if id was removed.
+             */
+            inline T* get(SlotId id){return contains(id) ? &values[slots[id.index].dense]:nullptr;}
+            inline const T* get(SlotId id) const {return contains(id) ? &values[slots[id.index].dense]:nullptr;}
+
+            /**
+             * Position of an element in iteration order, which changes when other elements are erased.
+             */
+            inline size_t position(SlotId id) const {return slots[id.index].dense;}
+
+            /**
+             * Handle to the element at a position in iteration order.
+             */
+            inline SlotId id(size_t i) const {return {owner[i], slots[owner[i]].generation};}
+
+            /**
+             * Write the elements and slot table to out, so that restore()
+             * brings back the same elements under the same handles.
+             */
+            void snapshot(Snapshot& out) const {
+                out.write(values);
+                out.write(owner);
+                out.write(slots);
+                out.write(unused);
+            }
+            void restore(SnapshotReader& in){
+                in.read(values);
+                in.read(owner);
+                in.read(slots);
+                in.read(unused);
+            }
+
+            inline size_t size() const {return values.size();}
+            inline bool empty() const {return values.empty();}
+            inline T& operator[](size_t i){return values[i];}
+            inline const T& operator[](size_t i) const {return values[i];}
+            inline typename std::vector<T>::iterator begin(){return values.begin();}
+            inline typename std::vector<T>::iterator end(){return values.end();}
+            inline typename std::vector<T>::const_iterator begin() const {return values.begin();}
+            inline typename std::vector<T>::const_iterator end() const {return values.end();}
+    };
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include <vector>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+#include <stdexcept>
+#include <type_traits>
+
+namespace gmh {
+    /**
+     * @brief Contiguous byte buffer holding the dynamic state of a simulation.
+     *
+     * Filled by the snapshot() methods of CHandler and PhysicsWorld and
+     * read back by their restore(). Values are copied as raw bytes, so a
+     * snapshot is only meaningful to the process and the objects it was
+     * taken from. Taking a snapshot into the same Snapshot again reuses
+     * its storage.
+     */
+    class Snapshot {
+        /** Storage, of which the first used bytes are written. It only grows, so writes seldom touch the allocator. */
+        std::vector<unsigned char> bytes;
+        size_t used = 0;
+        public:
+            inline void clear() {used = 0;}
+            inline size_t size() const {return used;}
+            inline const unsigned char* data() const {return bytes.data();}
+
+            template<typename T>
+            void write(const T* values, size_t count){
+                static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values are written as bytes");
+                size_t n = count*sizeof(T);
+                if(used + n > bytes.size()) bytes.resize(std::max(2*bytes.size(), used + n));
+                if(n > 0) std::memcpy(bytes.data() + used, values, n);
+                used += n;
+            }
+
+            template<typename T>
+            void write(const T& value){
+                write(&value, 1);
+            }
+
+            template<typename A, typename B>
+            void write(const std::pair<A, B>& value){
+                write(value.first);
+                write(value.second);
+            }
+
+            /**
+             * Write the size of a vector followed by its elements.
+             */
+            template<typename T>
+            void write(const std::vector<T>& values){
+                write(values.size());
+                if constexpr(std::is_trivially_copyable<T>::value) write(values.data(), values.size());
+                else for(const T& v: values) write(v);
+            }
+    };
+
+    /**
+     * @brief Reads a Snapshot back in the order it was written.
+     */
+    class SnapshotReader {
+        const Snapshot& from;
+        size_t at = 0;
+        public:
+            explicit SnapshotReader(const Snapshot& from): from(from) {}
+
+            /**
+             * Bytes of the next count values, without copying them out.
+             */
+            template<typename T>
+            const unsigned char* peek(size_t count) const {
+                if(at + count*sizeof(T) > from.size()) throw std::out_of_range("Read past the end of the snapshot");
+                return from.data() + at;
+            }
+
+            inline void skip(size_t n) {at += n;}
+            inline size_t position() const {return at;}
+            inline void seek(size_t position) {at = position;}
+
+            template<typename T>
+            void read(T* values, size_t count){
+                static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values are read as bytes");
+                const unsigned char* src = peek<T>(count);
+                if(count > 0) std::memcpy(values, src, count*sizeof(T));
+                at += count*sizeof(T);
+            }
+
+            template<typename T>
+            void read(T& value){
+                read(&value, 1);
+            }
+
+            template<typename T>
+            T read(){
+                T value;
+                read(value);
+                return value;
+            }
+
+            template<typename A, typename B>
+            void read(std::pair<A, B>& value){
+                read(value.first);
+                read(value.second);
+            }
+
+            template<typename T>
+            void read(std::vector<T>& values){
+                values.resize(read<size_t>());
+                if constexpr(std::is_trivially_copyable<T>::value) read(values.data(), values.size());
+                else for(T& v: values) read(v);
+            }
+    };
+}
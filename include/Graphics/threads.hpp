@@ -0,0 +1,54 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <mutex>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <condition_variable>
+
+namespace gmh {
+    /**
+     * @brief Fixed set of worker threads for data parallel loops.
+     *
+     * The thread calling run() works alongside the pool, so a pool of
+     * size one has no workers and runs everything inline.
+     */
+    class ThreadPool {
+        using Job = std::function<void(size_t begin, size_t end, unsigned int worker)>;
+        std::vector<std::thread> workers;
+        std::mutex lock;
+        std::condition_variable wake, done;
+        const Job* job = nullptr;
+        size_t count = 0, grain = 1;
+        std::atomic<size_t> next{0};
+        unsigned int busy = 0, epoch = 0;
+        bool stop = false;
+        void work(unsigned int worker);
+        void drain(unsigned int worker);
+        public:
+            /**
+             * @param threads Number of threads including the caller, at least one.
+             */
+            explicit ThreadPool(unsigned int threads = std::thread::hardware_concurrency());
+            ThreadPool(const ThreadPool&) = delete;
+            ThreadPool& operator=(const ThreadPool&) = delete;
+            ~ThreadPool();
+
+            /**
+             * Number of threads including the caller.
+             */
+            inline unsigned int size() const {return workers.size() + 1;}
+
+            /**
+             * Split [0, count) into chunks of at most grain and run f on
+             * them across the pool, returning once every chunk is done.
+             *
+             * Which thread runs which chunk is unspecified. worker is in
+             * [0, size()) and no two concurrent calls of f share one, so
+             * it can index per-thread buffers. f must not throw.
+             */
+            void run(size_t count, size_t grain, const Job& f);
+    };
+}
@@ -0,0 +1,106 @@
+#pragma once
+
+#include <vector>
+#include <thread>
+#include <glm/ext/vector_float3.hpp>
+#include <glm/ext/matrix_float4x4.hpp>
+#include "Graphics/collision.hpp"
+
+namespace gmh {
+    /**
+     * @brief Bodies stepped at a fixed rate, with contacts resolved by a CHandler.
+     *
+     * Frame times are added to an accumulator which is spent in steps of
+     * exactly dt, so the simulation does not depend on the frame rate.
+     * Rendering between steps interpolates from the previous step by the
+     * fraction of a step left over, see alpha().
+     *
+     * Positions and velocities are kept as structure of arrays and
+     * integrated with integrate_many(). Shapes are not moved by a step:
+     * the translation is handed to CHandler::translate(), which moves the
+     * bounds, and vertices are only rewritten for bodies that reach the
+     * narrowphase. Use position() and model() rather than obj->pos or
+     * obj->model_ptr(), or call materialize() first.
+     *
+     * Velocities stay in Point::vel, where contacts write them.
+     */
+    class PhysicsWorld {
+        CHandler handler;
+        const float dt;
+        const unsigned int max_steps;
+        float accumulator = 0;
+        /** Bodies in the order of the handler, along with their positions after the last two steps and velocities. */
+        std::vector<BodyId> ids;
+        std::vector<float> x, y, z, px, py, pz, vx, vy, vz;
+        public:
+            /**
+             * @param dt Length of a step.
+             * @param elasticity Coefficient of restitution, between 0 and 1.
+             * @param threads Threads to resolve contacts on, including the caller.
+             * @param max_steps Most steps run by one update(), after which the simulation drops time rather than fall behind.
+             */
+            explicit PhysicsWorld(float dt = 1/60.f, float elasticity = 1, unsigned int threads = std::thread::hardware_concurrency(), unsigned int max_steps = 8);
+
+            /**
+             * Advance by the time a frame took, in as many whole steps as fit.
+             *
+             * @return Number of steps run.
+             */
+            unsigned int update(float frame);
+            /**
+             * Run a single step of dt.
+             */
+            void step();
+            /**
+             * Fraction of a step accumulated but not yet run, in [0, 1).
+             */
+            inline float alpha() const {return accumulator/dt;}
+            inline float step_size() const {return dt;}
+
+            /**
+             * Register a body, see CHandler::add().
+             */
+            BodyId add(Point* v, float mass = 1.0f, bool fixed = false, bool fast = false);
+            /**
+             * Remove a body, bringing its shape up to date first.
+             */
+            void remove(BodyId id);
+            inline BodyId id(const Point* v) const {return handler.id(v);}
+            inline size_t size() const {return ids.size();}
+
+            /**
+             * Position of a body interpolated between the last two steps by alpha().
+             */
+            glm::vec3 position(BodyId id) const;
+            /**
+             * Model matrix of a body at position().
+             */
+            glm::mat4 model(BodyId id) const;
+            inline const glm::vec3& velocity(BodyId id) const {return handler.get(id)->obj->vel;}
+            /**
+             * Set the velocity of a body, waking it.
+             */
+            inline void velocity(BodyId id, const glm::vec3& vel){handler.velocity(id, vel);}
+            inline void sleeping(float speed, unsigned int steps){handler.sleeping(speed, steps);}
+            inline void contact_method(ContactMethod m){handler.contact_method(m);}
+            inline void iterations(unsigned int n){handler.iterations(n);}
+            inline void wake(BodyId id){handler.wake(id);}
+            /**
+             * Move every shape to its body's position after the last step.
+             */
+            inline void materialize(){handler.materialize();}
+            inline const CHandler& contacts() const {return handler;}
+
+            /**
+             * Replace the contents of out with the dynamic state of the
+             * world: the accumulator, positions, and everything
+             * CHandler::snapshot() writes.
+             */
+            void snapshot(Snapshot& out) const;
+            /**
+             * Go back to the state of a snapshot of this world, after
+             * which steps repeat bit for bit. See CHandler::restore().
+             */
+            void restore(const Snapshot& from);
+    };
+}
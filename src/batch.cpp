@@ -0,0 +1,159 @@
+#include <algorithm>
+#include "Graphics/batch.hpp"
+#include "Graphics/simd.hpp"
+#include "Graphics/geometry.hpp"
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+#include <intrin.h>
+#endif
+
+using namespace gmh;
+
+namespace {
+    /**
+     * Owning structure of arrays copy of a Mesh's plane equations.
+     */
+    struct PlaneSoA {
+        std::vector<float> fx, fy, fz, fd, ex, ey, ez, ed, sx, sy, sz, tx, ty, tz, il;
+        std::vector<unsigned int> fstart;
+        simd::Planes view;
+
+        PlaneSoA(const Mesh& m, bool solid){
+            unsigned int faces = m.face_count();
+            for(std::vector<float>* a: {&fx, &fy, &fz, &fd}) a->reserve(faces);
+            for(const glm::vec4& p: m.planes){
+                fx.push_back(p.x);
+                fy.push_back(p.y);
+                fz.push_back(p.z);
+                fd.push_back(p.w);
+            }
+            for(std::vector<float>* a: {&ex, &ey, &ez, &ed}) a->reserve(m.edge_planes.size());
+            for(const glm::vec4& p: m.edge_planes){
+                ex.push_back(p.x);
+                ey.push_back(p.y);
+                ez.push_back(p.z);
+                ed.push_back(p.w);
+            }
+            fstart = m.face_start;
+            for(std::vector<float>* a: {&sx, &sy, &sz, &tx, &ty, &tz, &il}) a->reserve(m.edge_count());
+            for(unsigned int i = 0; i < m.edge_count(); i++){
+                glm::vec3 a = m.edge(i).a(), t = m.edge(i).b() - a;
+                sx.push_back(a.x);
+                sy.push_back(a.y);
+                sz.push_back(a.z);
+                tx.push_back(t.x);
+                ty.push_back(t.y);
+                tz.push_back(t.z);
+                il.push_back(1/glm::dot(t, t));
+            }
+            view = {fx.data(), fy.data(), fz.data(), fd.data(), fstart.data(), faces, ex.data(), ey.data(), ez.data(), ed.data(),
+                sx.data(), sy.data(), sz.data(), tx.data(), ty.data(), tz.data(), il.data(), m.edge_count(), solid};
+        }
+    };
+
+    bool cpu_avx2(){
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+        int info[4];
+        __cpuid(info, 1);
+        bool osxsave = info[2] & (1 << 27);
+        bool fma = info[2] & (1 << 12);
+        if(!osxsave || !fma || (_xgetbv(0) & 6) != 6) return false;
+        __cpuidex(info, 7, 0);
+        return info[1] & (1 << 5);
+#elif (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+#else
+        return false;
+#endif
+    }
+
+    SimdLevel& current(){
+        static SimdLevel level = simd_supported();
+        return level;
+    }
+
+    void dist_soa(const PlaneSoA& soa, const glm::vec3* points, size_t count, float* out){
+        const float* xyz = reinterpret_cast<const float*>(points);
+        switch(current()){
+            case SimdLevel::AVX2: simd::dist_avx2(soa.view, xyz, count, out); break;
+#ifdef GH_SIMD_SSE
+            case SimdLevel::SSE: simd::run<simd::SSE>(soa.view, xyz, count, out, nullptr); break;
+#endif
+            default: simd::run<simd::Scalar>(soa.view, xyz, count, out, nullptr); break;
+        }
+    }
+
+    void cast_faces(const simd::Faces& s, const RaySpan& rays, const HitSpan& hits){
+        switch(current()){
+            case SimdLevel::AVX2: simd::cast_avx2(s, rays, hits); break;
+#ifdef GH_SIMD_SSE
+            case SimdLevel::SSE: simd::cast<simd::SSE>(s, rays, hits); break;
+#endif
+            default: simd::cast<simd::Scalar>(s, rays, hits); break;
+        }
+    }
+
+    void contains_soa(const PlaneSoA& soa, const glm::vec3* points, size_t count, bool* out){
+        const float* xyz = reinterpret_cast<const float*>(points);
+        switch(current()){
+            case SimdLevel::AVX2: simd::contains_avx2(soa.view, xyz, count, out); break;
+#ifdef GH_SIMD_SSE
+            case SimdLevel::SSE: simd::run<simd::SSE>(soa.view, xyz, count, nullptr, out); break;
+#endif
+            default: simd::run<simd::Scalar>(soa.view, xyz, count, nullptr, out); break;
+        }
+    }
+}
+
+SimdLevel gmh::simd_supported(){
+    static SimdLevel level = simd::avx2_built && cpu_avx2() ? SimdLevel::AVX2 :
+#ifdef GH_SIMD_SSE
+        SimdLevel::SSE;
+#else
+        SimdLevel::Scalar;
+#endif
+    return level;
+}
+
+SimdLevel gmh::simd_level(){
+    return current();
+}
+
+void gmh::simd_level(SimdLevel level){
+    current() = std::min(level, simd_supported());
+}
+
+void gmh::dist_many(const Polygon& obj, const glm::vec3* points, size_t count, float* out){
+    dist_soa(PlaneSoA(obj.mesh(), false), points, count, out);
+}
+
+void gmh::dist_many(const Polyhedron& obj, const glm::vec3* points, size_t count, float* out){
+    dist_soa(PlaneSoA(obj.mesh(), true), points, count, out);
+}
+
+void gmh::contains_many(const Polygon& obj, const glm::vec3* points, size_t count, bool* out){
+    contains_soa(PlaneSoA(obj.mesh(), false), points, count, out);
+}
+
+void gmh::contains_many(const Polyhedron& obj, const glm::vec3* points, size_t count, bool* out){
+    contains_soa(PlaneSoA(obj.mesh(), true), points, count, out);
+}
+
+void gmh::raycast_many(const Polygon& obj, const RaySpan& rays, const HitSpan& hits){
+    const Mesh& m = obj.mesh();
+    cast_faces({&m.planes[0].x, 1, &m.edge_planes[m.face_start[0]].x, m.face_start[1] - m.face_start[0], false}, rays, hits);
+}
+
+void gmh::raycast_many(const Polyhedron& obj, const RaySpan& rays, const HitSpan& hits){
+    const Mesh& m = obj.mesh();
+    cast_faces({&m.planes[0].x, m.face_count(), nullptr, 0, true}, rays, hits);
+}
+
+void gmh::integrate_many(float* x, const float* v, size_t count, float dt){
+    switch(current()){
+        case SimdLevel::AVX2: simd::integrate_avx2(x, v, count, dt); break;
+#ifdef GH_SIMD_SSE
+        case SimdLevel::SSE: simd::integrate<simd::SSE>(x, v, count, dt); break;
+#endif
+        default: simd::integrate<simd::Scalar>(x, v, count, dt); break;
+    }
+}
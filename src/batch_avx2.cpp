@@ -0,0 +1,44 @@
+#include "Graphics/simd.hpp"
+
+// Built with AVX2 and FMA enabled when the compiler targets x86, see CMakeLists.txt.
+// Only reached after batch.cpp has checked the CPU supports both.
+
+using namespace gmh;
+
+#ifdef __AVX2__
+const bool simd::avx2_built = true;
+
+void simd::dist_avx2(const Planes& s, const float* xyz, size_t count, float* out){
+    run<AVX2>(s, xyz, count, out, nullptr);
+}
+
+void simd::contains_avx2(const Planes& s, const float* xyz, size_t count, bool* out){
+    run<AVX2>(s, xyz, count, nullptr, out);
+}
+
+void simd::cast_avx2(const Faces& s, const RaySpan& rays, const HitSpan& hits){
+    cast<AVX2>(s, rays, hits);
+}
+
+void simd::integrate_avx2(float* x, const float* v, size_t count, float dt){
+    integrate<AVX2>(x, v, count, dt);
+}
+#else
+const bool simd::avx2_built = false;
+
+void simd::dist_avx2(const Planes& s, const float* xyz, size_t count, float* out){
+    run<Scalar>(s, xyz, count, out, nullptr);
+}
+
+void simd::contains_avx2(const Planes& s, const float* xyz, size_t count, bool* out){
+    run<Scalar>(s, xyz, count, nullptr, out);
+}
+
+void simd::cast_avx2(const Faces& s, const RaySpan& rays, const HitSpan& hits){
+    cast<Scalar>(s, rays, hits);
+}
+
+void simd::integrate_avx2(float* x, const float* v, size_t count, float dt){
+    integrate<Scalar>(x, v, count, dt);
+}
+#endif
@@ -0,0 +1,154 @@
+#include "Graphics/broadphase.hpp"
+#include <algorithm>
+#include "Graphics/geometry.hpp"
+
+using namespace gmh;
+
+AABB gmh::bounds(const Point& obj, float margin){
+    return obj.extent().box.grown(margin);
+}
+
+// Ties put minimums first so that boxes which only touch count as overlapping.
+static inline bool before(float v1, bool max1, float v2, bool max2){
+    return v1 < v2 || (v1 == v2 && !max1 && max2);
+}
+
+unsigned int SweepAndPrune::insert(const AABB& box){
+    unsigned int id;
+    if(unused.empty()){
+        id = proxies.size();
+        proxies.emplace_back();
+    }
+    else{
+        id = unused.back();
+        unused.pop_back();
+    }
+    proxies[id] = {box, {}, {}};
+    for(unsigned int a = 0; a < 3; a++){
+        axes[a].push_back({box.min[a], id, false});
+        proxies[id].min[a] = axes[a].size() - 1;
+        axes[a].push_back({box.max[a], id, true});
+        proxies[id].max[a] = axes[a].size() - 1;
+    }
+    pending = true;
+    return id;
+}
+
+void SweepAndPrune::update(unsigned int proxy, const AABB& box){
+    if(pending) build();
+    Proxy& p = proxies[proxy];
+    if(p.box == box) return;
+    AABB old = p.box;
+    p.box = box;
+    for(unsigned int a = 0; a < 3; a++){
+        axes[a][p.min[a]].value = box.min[a];
+        axes[a][p.max[a]].value = box.max[a];
+        // Sift the endpoint on the leading side first so neither passes the other.
+        if(box.min[a] < old.min[a]){
+            sift(a, p.min[a]);
+            sift(a, p.max[a]);
+        }
+        else{
+            sift(a, p.max[a]);
+            sift(a, p.min[a]);
+        }
+    }
+}
+
+void SweepAndPrune::remove(unsigned int proxy){
+    Proxy& p = proxies[proxy];
+    for(unsigned int a = 0; a < 3; a++){
+        unsigned int lo = p.min[a], hi = p.max[a];
+        if(lo > hi) std::swap(lo, hi);
+        axes[a].erase(axes[a].begin() + hi);
+        axes[a].erase(axes[a].begin() + lo);
+        for(unsigned int i = lo; i < axes[a].size(); i++) place(a, i);
+    }
+    for(auto it = overlap.begin(); it != overlap.end();){
+        if(it->first == proxy || it->second == proxy) it = overlap.erase(it);
+        else ++it;
+    }
+    unused.push_back(proxy);
+}
+
+const std::set<std::pair<unsigned int, unsigned int>>& SweepAndPrune::pairs(){
+    if(pending) build();
+    return overlap;
+}
+
+void SweepAndPrune::snapshot(Snapshot& out) const {
+    for(const std::vector<Endpoint>& axis: axes) out.write(axis);
+    out.write(proxies);
+    out.write(unused);
+    out.write(pending);
+    out.write(overlap.size());
+    for(const std::pair<unsigned int, unsigned int>& p: overlap) out.write(p);
+}
+
+void SweepAndPrune::restore(SnapshotReader& in){
+    for(std::vector<Endpoint>& axis: axes) in.read(axis);
+    in.read(proxies);
+    in.read(unused);
+    in.read(pending);
+    // The pairs are only rebuilt if they changed since.
+    size_t count = in.read<size_t>(), start = in.position();
+    bool same = count == overlap.size();
+    for(auto it = overlap.begin(); same && it != overlap.end(); ++it) same = in.read<std::pair<unsigned int, unsigned int>>() == *it;
+    if(same) return;
+    in.seek(start);
+    overlap.clear();
+    for(size_t i = 0; i < count; i++) overlap.emplace_hint(overlap.end(), in.read<std::pair<unsigned int, unsigned int>>());
+}
+
+void SweepAndPrune::build(){
+    for(unsigned int a = 0; a < 3; a++){
+        std::sort(axes[a].begin(), axes[a].end(), [](const Endpoint& e1, const Endpoint& e2){
+            return before(e1.value, e1.max, e2.value, e2.max);
+        });
+        for(unsigned int i = 0; i < axes[a].size(); i++) place(a, i);
+    }
+    overlap.clear();
+    std::vector<unsigned int> active;
+    for(const Endpoint& e: axes[0]){
+        if(e.max){
+            active.erase(std::find(active.begin(), active.end(), e.proxy));
+            continue;
+        }
+        for(unsigned int other: active) if(proxies[other].box.overlaps(proxies[e.proxy].box)) pair(other, e.proxy, true);
+        active.push_back(e.proxy);
+    }
+    pending = false;
+}
+
+void SweepAndPrune::sift(unsigned int axis, unsigned int i){
+    std::vector<Endpoint>& list = axes[axis];
+    Endpoint e = list[i];
+    // A minimum passing a maximum towards the left, or a maximum passing a minimum towards the
+    // right, may start an overlap. The opposite passes end one.
+    while(i > 0 && before(e.value, e.max, list[i - 1].value, list[i - 1].max)){
+        const Endpoint& o = list[i - 1];
+        if(e.max != o.max && e.proxy != o.proxy) pair(e.proxy, o.proxy, !e.max && proxies[e.proxy].box.overlaps(proxies[o.proxy].box));
+        list[i] = o;
+        place(axis, i--);
+    }
+    while(i + 1 < list.size() && before(list[i + 1].value, list[i + 1].max, e.value, e.max)){
+        const Endpoint& o = list[i + 1];
+        if(e.max != o.max && e.proxy != o.proxy) pair(e.proxy, o.proxy, e.max && proxies[e.proxy].box.overlaps(proxies[o.proxy].box));
+        list[i] = o;
+        place(axis, i++);
+    }
+    list[i] = e;
+    place(axis, i);
+}
+
+void SweepAndPrune::place(unsigned int axis, unsigned int i){
+    const Endpoint& e = axes[axis][i];
+    if(e.max) proxies[e.proxy].max[axis] = i;
+    else proxies[e.proxy].min[axis] = i;
+}
+
+void SweepAndPrune::pair(unsigned int a, unsigned int b, bool add){
+    std::pair<unsigned int, unsigned int> key = std::minmax(a, b);
+    if(add) overlap.insert(key);
+    else overlap.erase(key);
+}
@@ -1,4 +1,5 @@
 #include "Graphics/camera.hpp"
+#include <cmath>
 #include <glm/geometric.hpp>
 
 using namespace gmh;
@@ -22,6 +23,12 @@ glm::mat4 Camera::view(){
     return glm::lookAt(pos, pos + front, up);
 }
 
+glm::vec3 Camera::through(double x, double y, unsigned int width, unsigned int height) const {
+    float h = std::tan(zoom/2);
+    float dx = static_cast<float>(2*x/width - 1)*h*width/height, dy = static_cast<float>(1 - 2*y/height)*h;
+    return glm::normalize(front + dx*right + dy*up);
+}
+
 void Camera::update(float dt){
     switch (dir){
         case FORWARD:
@@ -1,96 +1,530 @@
 #include "Graphics/collision.hpp"
+#include <limits>
+#include <numeric>
+#include <cstring>
+#include <algorithm>
 #include <glm/geometric.hpp>
 #include "Graphics/gmath.hpp"
 #include "Graphics/geometry.hpp"
 
 using namespace gmh;
 
-std::vector<std::vector<Physical>> CHandler::get_check() const {
-    return combinations<Physical>(tangible.begin(), tangible.end(), 2);
+static inline bool unbounded(const Shape& obj){
+    return shape_cast<Line>(obj) || shape_cast<Plane>(obj);
 }
 
-CHandler::CHandler(): elasticity(2) {}
+static inline bool surface(const Shape& obj){
+    return obj.index() >= Shape(static_cast<const Plane*>(nullptr)).index();
+}
+
+static inline bool instanced(const Physical& obj1, const Physical& obj2){
+    return shape_cast<Instance>(obj1.shape) || shape_cast<Instance>(obj2.shape);
+}
+
+static inline bool solid(const Shape& obj){
+    return shape_cast<Polyhedron>(obj) || shape_cast<Instance>(obj);
+}
+
+// Mesh of a solid in world space, which for an Instance is built in scratch.
+static inline const Mesh& world_mesh(const Shape& obj, Mesh& scratch){
+    if(const Polyhedron* sol = shape_cast<Polyhedron>(obj)) return sol->mesh();
+    shape_cast<Instance>(obj)->world(scratch);
+    return scratch;
+}
+
+// Whether a face is within 1e-5 of the solid with mesh m.
+static inline bool touches(const Mesh::Face& face, const Mesh& m){
+    return static_cast<bool>(Intersection::clip(face, m.planes.data(), m.face_count()));
+}
+
+// Bodies that neither move nor need checking against each other.
+static inline bool resting(const Physical& body){
+    return body.fixed || body.asleep;
+}
+
+// Apply the translation a body was moved by through CHandler::translate() to its shape.
+static inline void apply(Physical& body){
+    if(body.offset == glm::vec3(0)) return;
+    body->translate(body.offset);
+    body.offset = glm::vec3(0);
+}
 
-CHandler::CHandler(float elasticity): elasticity(elasticity + 1.f) {
+const std::set<std::pair<unsigned int, unsigned int>>& CHandler::get_check(){
+    pool.run(bodies.size(), 256, [this](size_t begin, size_t end, unsigned int){
+        for(size_t i = begin; i < end; i++)
+            if(bodies[i].proxy != Physical::none && !bodies[i].asleep && bodies[i].offset == glm::vec3(0)) bodies[i].bounds = bounds(*bodies[i].obj, 1e-5);
+    });
+    for(const Physical& body: bodies)
+        if(body.proxy != Physical::none && !body.asleep) broad.update(body.proxy, body.bounds);
+    return broad.pairs();
+}
+
+CHandler::CHandler(): CHandler(1) {}
+
+CHandler::CHandler(float elasticity, unsigned int threads): elasticity(elasticity + 1.f), pool(threads), contacts(pool.size()), scratch(pool.size()) {
     if(elasticity < 0 || elasticity > 1) throw std::domain_error("Elasticity must be a value between 0 and 1");
 }
 
-void CHandler::operator()() const {
-    std::vector<std::vector<Physical>> objects = get_check();
-    for(std::vector<Physical> v: objects){
-        if(v[0].fixed && v[1].fixed) continue;
-        if(Polygon* v0_surf = dynamic_cast<Polygon*>(v[0].obj)){
-            if(v[1]->dist(*v0_surf) == 0)
-                collision(v[0], v[1]);
+void CHandler::operator()(){
+    step++;
+    candidates.clear();
+    for(const auto& [i, j]: get_check()){
+        BodyId id1 = std::min(proxied[i], proxied[j]), id2 = std::max(proxied[i], proxied[j]);
+        const Physical& obj1 = *bodies.get(id1);
+        const Physical& obj2 = *bodies.get(id2);
+        if(resting(obj1) && resting(obj2)) continue;
+        if(!surface(obj1.shape) && !surface(obj2.shape)) continue;
+        Manifold& contact = manifolds[{id1, id2}];
+        contact.stamp = step;
+        candidates.emplace_back(id1, id2, &contact);
+    }
+    // Drop the manifolds of pairs checked on the last step but not on this one, except for pairs
+    // skipped because both bodies rest, which keep theirs for when they wake.
+    for(const std::pair<BodyId, BodyId>& key: checked){
+        auto it = manifolds.find(key);
+        if(it == manifolds.end() || it->second.stamp == step) continue;
+        const Physical* obj1 = bodies.get(key.first);
+        const Physical* obj2 = bodies.get(key.second);
+        if(obj1 && obj2 && resting(*obj1) && resting(*obj2)) continue;
+        manifolds.erase(it);
+    }
+    checked.clear();
+    // Shapes move their vertices lazily, so they are brought up to date here rather than under lock by the first query on some thread.
+    for(const auto& [id1, id2, contact]: candidates){
+        checked.emplace_back(id1, id2);
+        apply(*bodies.get(id1));
+        apply(*bodies.get(id2));
+        bodies.get(id1)->obj->sync();
+        bodies.get(id2)->obj->sync();
+    }
+    // Each query only reads the shapes and writes its own manifold and thread's buffer.
+    for(std::vector<std::tuple<BodyId, BodyId, Manifold*>>& buffer: contacts) buffer.clear();
+    pool.run(candidates.size(), 64, [this](size_t begin, size_t end, unsigned int worker){
+        for(size_t i = begin; i < end; i++){
+            const auto& [id1, id2, contact] = candidates[i];
+            if(touching(*bodies.get(id1), *bodies.get(id2), *contact, worker)) contacts[worker].push_back(candidates[i]);
+            else{
+                contact->feature = Manifold::none;
+                contact->count = 0;
+                contact->impulse = 0;
+            }
         }
-        else if(Polyhedron* v0_sol = dynamic_cast<Polyhedron*>(v[0].obj)){
-            if(v[1]->dist(*v0_sol) == 0)
-                collision(v[0], v[1]);
+    });
+    std::vector<std::tuple<BodyId, BodyId, Manifold*>>& merged = contacts[0];
+    for(unsigned int t = 1; t < contacts.size(); t++) merged.insert(merged.end(), contacts[t].begin(), contacts[t].end());
+    std::sort(merged.begin(), merged.end());
+    for(const auto& [id1, id2, contact]: merged){
+        Physical& obj1 = *bodies.get(id1);
+        Physical& obj2 = *bodies.get(id2);
+        if(obj1.asleep) wake_island(obj1.island);
+        if(obj2.asleep) wake_island(obj2.island);
+    }
+    // Finding the normals only reads velocities, so every pair is prepared before any is solved.
+    rows.resize(merged.size());
+    pool.run(merged.size(), 64, [this, &merged](size_t begin, size_t end, unsigned int){
+        for(size_t i = begin; i < end; i++){
+            const auto& [id1, id2, contact] = merged[i];
+            if(!row(*bodies.get(id1), *bodies.get(id2), *contact, rows[i])) rows[i].contact = nullptr;
+            else{
+                rows[i].index1 = bodies.position(id1);
+                rows[i].index2 = bodies.position(id2);
+            }
         }
+    });
+    rows.erase(std::remove_if(rows.begin(), rows.end(), [](const Row& r){return !r.contact;}), rows.end());
+    color();
+    // Pairs still touching start from the impulse they converged to on the last step.
+    sweep(warm);
+    for(unsigned int it = 0; it < solver_iterations; it++) sweep(solve);
+    for(const Row& r: colored) r.contact->impulse = r.impulse;
+    sleep(merged);
+}
+
+void CHandler::sweep(void (*f)(Row&)){
+    for(size_t c = 0; c + 1 < colors.size(); c++){
+        pool.run(colors[c + 1] - colors[c], 64, [this, c, f](size_t begin, size_t end, unsigned int){
+            for(size_t i = colors[c] + begin; i < colors[c] + end; i++) f(colored[i]);
+        });
     }
+    for(size_t i = colors.back(); i < colored.size(); i++) f(colored[i]);
 }
 
-void CHandler::add(Point* v, float mass, bool fixed){
-    tangible.insert({v, mass, fixed});
+bool CHandler::row(Physical& obj1, Physical& obj2, Manifold& contact, Row& out) const {
+    if(!prepare(obj1, obj2, contact) || contact.normal == glm::vec3(0)) return false;
+    out = Row{&obj1, &obj2, obj1.fixed ? 0:1/obj1.mass, obj2.fixed ? 0:1/obj2.mass, contact.normal, 0, contact.impulse, &contact};
+    if(out.w1 + out.w2 <= 0) return false;
+    float approach = glm::dot(obj2->vel - obj1->vel, contact.normal);
+    // elasticity is stored plus one.
+    if(approach < 0) out.target = -(elasticity - 1)*approach;
+    return true;
 }
 
-void CHandler::add(Physical t){
-    tangible.insert(t);
+void CHandler::color(){
+    // Greedy coloring by the first color free for both moving bodies. A pair whose bodies have
+    // used up every color spills into a last group which is solved serially.
+    const unsigned int spill = 64;
+    used.assign(bodies.size(), 0);
+    std::vector<unsigned int> of(rows.size());
+    std::vector<size_t> count(spill + 1, 0);
+    for(size_t i = 0; i < rows.size(); i++){
+        const Row& r = rows[i];
+        std::uint64_t taken = (r.w1 > 0 ? used[r.index1]:0) | (r.w2 > 0 ? used[r.index2]:0);
+        unsigned int c = 0;
+        while(c < spill && (taken >> c & 1)) c++;
+        if(c < spill){
+            if(r.w1 > 0) used[r.index1] |= std::uint64_t(1) << c;
+            if(r.w2 > 0) used[r.index2] |= std::uint64_t(1) << c;
+        }
+        of[i] = c;
+        count[c]++;
+    }
+    colors.assign(1, 0);
+    for(unsigned int c = 0; c < spill && count[c] > 0; c++) colors.push_back(colors.back() + count[c]);
+    // Stable counting sort, keeping body id order within each color.
+    std::vector<size_t> start(spill + 1, 0);
+    for(unsigned int c = 1; c <= spill; c++) start[c] = start[c - 1] + count[c - 1];
+    colored.resize(rows.size());
+    for(size_t i = 0; i < rows.size(); i++) colored[start[of[i]]++] = rows[i];
+}
+
+void CHandler::warm(Row& row){
+    if(row.w1 > 0) row.body1->obj->vel -= row.w1*row.impulse*row.normal;
+    if(row.w2 > 0) row.body2->obj->vel += row.w2*row.impulse*row.normal;
+}
+
+void CHandler::solve(Row& row){
+    float approach = glm::dot(row.body2->obj->vel - row.body1->obj->vel, row.normal);
+    float total = std::max(row.impulse + (row.target - approach)/(row.w1 + row.w2), 0.0f);
+    float delta = total - row.impulse;
+    row.impulse = total;
+    // Fixed bodies can be shared by pairs solved at the same time, so they are never written.
+    if(row.w1 > 0) row.body1->obj->vel -= row.w1*delta*row.normal;
+    if(row.w2 > 0) row.body2->obj->vel += row.w2*delta*row.normal;
+}
+
+void CHandler::operator()(float dt){
+    left.assign(bodies.size(), 0);
+    for(unsigned int i = 0; i < bodies.size(); i++) if(!resting(bodies[i])) left[i] = 1;
+    for(unsigned int sweeps = 0; sweeps < max_sweeps; sweeps++){
+        advance.assign(bodies.size(), 1);
+        // Every body is swept from where it starts the sweep, so the order bodies are moved in does not matter.
+        pool.run(bodies.size(), 16, [this, dt](size_t begin, size_t end, unsigned int){
+            for(size_t i = begin; i < end; i++)
+                if(bodies[i].fast && left[i] > 0) advance[i] = impact(bodies[i], left[i]*dt);
+        });
+        bool stopped = false;
+        for(unsigned int i = 0; i < bodies.size(); i++){
+            if(left[i] <= 0) continue;
+            bodies[i]->update(advance[i]*left[i]*dt);
+            left[i] *= 1 - advance[i];
+            stopped = stopped || left[i] > 0;
+        }
+        (*this)();
+        if(!stopped) return;
+    }
+}
+
+float CHandler::impact(const Physical& body, float dt) const {
+    if(body.proxy == Physical::none) return 1;
+    glm::vec3 d1 = body->vel*dt;
+    AABB path = bounds(*body.obj, 1e-5);
+    path = AABB{path.min + body.offset, path.max + body.offset}.swept(d1);
+    float first = 1;
+    for(const Physical& other: bodies){
+        if(&other == &body || other.proxy == Physical::none) continue;
+        if(!surface(body.shape) && !surface(other.shape)) continue;
+        glm::vec3 d2 = resting(other) ? glm::vec3(0):other->vel*dt;
+        if(!path.overlaps(other.bounds.swept(d2))) continue;
+        Impact hit;
+        if(toi(*body.obj, body.offset, d1, *other.obj, other.offset, d2, hit) && hit.t > 0) first = std::min(first, hit.t);
+    }
+    return first;
+}
+
+BodyId CHandler::shape_cast(const Point& obj, const glm::vec3& translation, Impact& out) const {
+    AABB path = bounds(obj, 1e-5).swept(translation);
+    BodyId hit;
+    Impact best{std::numeric_limits<float>::infinity()};
+    for(unsigned int i = 0; i < bodies.size(); i++){
+        const Physical& body = bodies[i];
+        if(body.obj == &obj || body.proxy == Physical::none || !path.overlaps(body.bounds)) continue;
+        Impact cast;
+        if(toi(obj, glm::vec3(0), translation, *body.obj, body.offset, glm::vec3(0), cast) && cast.t < best.t){
+            best = cast;
+            hit = bodies.id(i);
+        }
+    }
+    if(hit != BodyId{}) out = best;
+    return hit;
+}
+
+void CHandler::translate(BodyId id, const glm::vec3& d){
+    Physical* body = bodies.get(id);
+    if(!body) return;
+    body->offset += d;
+    body->bounds.min += d;
+    body->bounds.max += d;
+}
+
+void CHandler::materialize(BodyId id){
+    if(Physical* body = bodies.get(id)) apply(*body);
+}
+
+void CHandler::materialize(){
+    for(Physical& body: bodies) apply(body);
+}
+
+void CHandler::snapshot(Snapshot& out) const {
+    out.write(step);
+    bodies.snapshot(out);
+    for(const Physical& body: bodies) body->snapshot(out);
+    out.write(manifolds.size());
+    for(const auto& [key, contact]: manifolds){
+        out.write(key);
+        out.write(contact);
+    }
+    out.write(checked);
+    islands.snapshot(out);
+    broad.snapshot(out);
+}
+
+void CHandler::restore(SnapshotReader& in){
+    // The body count leads the slot map, after the step.
+    size_t count;
+    std::memcpy(&count, in.peek<unsigned char>(sizeof(step) + sizeof(count)) + sizeof(step), sizeof(count));
+    if(count != bodies.size()) throw std::invalid_argument("Snapshot is of a different set of bodies");
+    in.read(step);
+    bodies.restore(in);
+    for(Physical& body: bodies) body->restore(in);
+    // Restoring a recent snapshot usually finds the same pairs, whose manifolds are overwritten in place.
+    count = in.read<size_t>();
+    size_t start = in.position();
+    bool same = count == manifolds.size();
+    for(auto it = manifolds.begin(); same && it != manifolds.end(); ++it){
+        if(in.read<std::pair<BodyId, BodyId>>() != it->first) same = false;
+        else in.read(it->second);
+    }
+    if(!same){
+        in.seek(start);
+        manifolds.clear();
+        for(size_t i = 0; i < count; i++){
+            std::pair<BodyId, BodyId> key = in.read<std::pair<BodyId, BodyId>>();
+            manifolds.emplace_hint(manifolds.end(), key, in.read<Manifold>());
+        }
+    }
+    in.read(checked);
+    islands.restore(in);
+    broad.restore(in);
+}
+
+void CHandler::sleep(const std::vector<std::tuple<BodyId, BodyId, Manifold*>>& touching){
+    if(sleep_steps == 0) return;
+    for(Physical& body: bodies)
+        if(!resting(body)) body.still = glm::length(body->vel) < sleep_speed ? body.still + 1:0;
+    group.resize(bodies.size());
+    std::iota(group.begin(), group.end(), 0);
+    auto find = [this](unsigned int i){
+        while(group[i] != i) i = group[i] = group[group[i]];
+        return i;
+    };
+    for(const auto& [id1, id2, contact]: touching){
+        if(bodies.get(id1)->fixed || bodies.get(id2)->fixed) continue;
+        group[find(bodies.position(id1))] = find(bodies.position(id2));
+    }
+    ready.assign(bodies.size(), true);
+    for(unsigned int i = 0; i < bodies.size(); i++)
+        if(!resting(bodies[i]) && bodies[i].still < sleep_steps) ready[find(i)] = false;
+    root_island.assign(bodies.size(), SlotId{});
+    for(unsigned int i = 0; i < bodies.size(); i++){
+        Physical& body = bodies[i];
+        unsigned int root = find(i);
+        if(resting(body) || !ready[root]) continue;
+        if(root_island[root] == SlotId{}) root_island[root] = islands.insert({});
+        islands.get(root_island[root])->push_back(bodies.id(i));
+        body.asleep = true;
+        body.island = root_island[root];
+        body->vel = glm::vec3(0);
+    }
+}
+
+void CHandler::wake_island(SlotId island){
+    const std::vector<BodyId>* members = islands.get(island);
+    if(!members) return;
+    for(BodyId id: *members){
+        if(Physical* body = bodies.get(id)){
+            body->asleep = false;
+            body->still = 0;
+        }
+    }
+    islands.erase(island);
+}
+
+void CHandler::sleeping(float speed, unsigned int steps){
+    sleep_speed = speed;
+    sleep_steps = steps;
+    if(steps > 0) return;
+    while(!islands.empty()) wake_island(islands.id(0));
+}
+
+void CHandler::wake(BodyId id){
+    Physical* body = bodies.get(id);
+    if(!body) return;
+    if(body->asleep) wake_island(body->island);
+    body->still = 0;
+}
+
+void CHandler::velocity(BodyId id, const glm::vec3& vel){
+    Physical* body = bodies.get(id);
+    if(!body) return;
+    body->obj->vel = vel;
+    wake(id);
+}
+
+BodyId CHandler::add(Point* v, float mass, bool fixed, bool fast){
+    return add(Physical{v, mass, fixed, fast});
+}
+
+BodyId CHandler::add(Physical t){
+    if(auto it = ids.find(t.obj); it != ids.end()) return it->second;
+    t.shape = shape(*t.obj);
+    t.proxy = Physical::none;
+    if(!unbounded(t.shape)){
+        t.bounds = bounds(*t.obj, 1e-5);
+        t.proxy = broad.insert(t.bounds);
+    }
+    BodyId id = bodies.insert(t);
+    ids[t.obj] = id;
+    if(t.proxy != Physical::none){
+        if(proxied.size() <= t.proxy) proxied.resize(t.proxy + 1);
+        proxied[t.proxy] = id;
+    }
+    return id;
+}
+
+void CHandler::remove(BodyId id){
+    Physical* body = bodies.get(id);
+    if(!body) return;
+    apply(*body);
+    if(body->proxy != Physical::none) broad.remove(body->proxy);
+    ids.erase(body->obj);
+    bodies.erase(id);
+    for(auto it = manifolds.begin(); it != manifolds.end();){
+        if(it->first.first == id || it->first.second == id) it = manifolds.erase(it);
+        else ++it;
+    }
 }
 
 void CHandler::remove(Point* v){
-    tangible.erase({v, 0, 0});
+    remove(id(v));
 }
 
 void CHandler::remove(Physical t){
-    tangible.erase(t);
+    remove(t.obj);
 }
 
-void CHandler::collision(Physical& obj1, Physical& obj2) const {
-    float m1 = obj2.fixed ? 0:obj1.mass;
-    float m2 = obj1.fixed ? 0:obj2.mass;
-    glm::vec3 impulse = elasticity*(obj2->vel - obj1->vel)/(m2 + m1);
-    glm::vec3 dirVec{0, 0, 0};
-    if(Polygon* obj1_surf = dynamic_cast<Polygon*>(obj1.obj)){
-        if(glm::dot(obj2->vel - obj1->vel, obj1_surf->normVec()*obj1_surf->sign_dist(*obj2.obj)) < 0)
-            dirVec = obj1_surf->normVec();
-    }
-    else if(Polygon* obj2_surf = dynamic_cast<Polygon*>(obj2.obj)){
-        if(glm::dot(obj1->vel - obj2->vel, obj2_surf->normVec()*obj2_surf->sign_dist(*obj1.obj)) < 0)
-            dirVec = obj2_surf->normVec();
-    }
-    else if(Polyhedron* obj1_sol = dynamic_cast<Polyhedron*>(obj1.obj)) if(Polyhedron* obj2_sol = dynamic_cast<Polyhedron*>(obj2.obj)){
-        float c1 = 0;
-        float c2 = 0;
-        for(std::shared_ptr<LinSeg> edge: obj1_sol->edges){
-            if(std::unique_ptr<Point> inter = obj2_sol->intersect(*edge); LinSeg* line = dynamic_cast<LinSeg*>(inter.get())) c1 += line->length();
+BodyId CHandler::id(const Point* v) const {
+    auto it = ids.find(v);
+    return it == ids.end() ? BodyId{}:it->second;
+}
+
+const Manifold* CHandler::manifold(BodyId id1, BodyId id2) const {
+    auto it = manifolds.find(std::minmax(id1, id2));
+    return it == manifolds.end() ? nullptr:&it->second;
+}
+
+bool CHandler::touching(const Physical& obj1, const Physical& obj2, Manifold& contact, unsigned int worker) const {
+    if(method == ContactMethod::SAT || instanced(obj1, obj2)){
+        if(solid(obj1.shape) && solid(obj2.shape)){
+            std::array<Mesh, 2>& meshes = scratch[worker];
+            SatContact found = sat(world_mesh(obj1.shape, meshes[0]), world_mesh(obj2.shape, meshes[1]), contact.axis);
+            if(found.separation > 1e-5) return false;
+            contact.owner = contact.axis.kind == SatAxis::Kind::Face2 ? 1:0;
+            contact.feature = contact.axis.kind == SatAxis::Kind::Edges ? Manifold::none:contact.axis.i;
+            contact.normal = found.normal;
+            contact.points = found.points;
+            contact.count = found.count;
+            return true;
         }
-        for(std::shared_ptr<LinSeg> edge: obj2_sol->edges){
-            if(std::unique_ptr<Point> inter = obj1_sol->intersect(*edge); LinSeg* line = dynamic_cast<LinSeg*>(inter.get())) c2 += line->length();
+    }
+    return gjk(*obj1.obj, *obj2.obj, &contact.cache).dist < 1e-5;
+}
+
+void CHandler::collision(Physical& obj1, Physical& obj2) const {
+    Manifold contact;
+    if((method == ContactMethod::SAT || instanced(obj1, obj2)) && !touching(obj1, obj2, contact)) return;
+    collision(obj1, obj2, contact);
+}
+
+bool CHandler::prepare(const Physical& obj1, const Physical& obj2, Manifold& contact) const {
+    if(const Polygon* obj1_surf = gmh::shape_cast<Polygon>(obj1.shape)){
+        contact.feature = 0;
+        contact.owner = 0;
+        contact.normal = obj1_surf->normVec()*static_cast<float>(sign(obj1_surf->sign_dist(*obj2.obj)));
+        return true;
+    }
+    else if(const Polygon* obj2_surf = gmh::shape_cast<Polygon>(obj2.shape)){
+        contact.feature = 0;
+        contact.owner = 1;
+        contact.normal = -obj2_surf->normVec()*static_cast<float>(sign(obj2_surf->sign_dist(*obj1.obj)));
+        return true;
+    }
+    // touching() has already found the contact normal and points.
+    else if(method == ContactMethod::SAT || instanced(obj1, obj2)) return true;
+    else if(const Polyhedron* obj1_sol = gmh::shape_cast<Polyhedron>(obj1.shape)) if(const Polyhedron* obj2_sol = gmh::shape_cast<Polyhedron>(obj2.shape)){
+        const Mesh& m1 = obj1_sol->mesh();
+        const Mesh& m2 = obj2_sol->mesh();
+        // A cached reference face is kept for as long as the other body still touches it.
+        if(contact.feature != Manifold::none){
+            const Mesh& ref = contact.owner == 0 ? m1:m2;
+            const Mesh& other = contact.owner == 0 ? m2:m1;
+            if(contact.feature >= ref.face_count() || !touches(ref.face(contact.feature), other)) contact.feature = Manifold::none;
         }
-        if(c1 < c2){
-            float val = 0;
-            for(std::shared_ptr<Polygon> face: obj1_sol->faces){
-                if(obj2->dist(*face) != 0) continue;
-                float check = glm::dot(obj2->vel - obj1->vel, face->normVec()*static_cast<float>(sign(face->sign_dist(*obj2.obj))));
-                if(check < val){
-                    val = check;
-                    dirVec = face->normVec();
-                }
+        if(contact.feature == Manifold::none){
+            float c1 = 0;
+            float c2 = 0;
+            for(unsigned int i = 0; i < m1.edge_count(); i++){
+                if(Intersection inter = Intersection::clip(m1.edge(i).a(), m1.edge(i).b(), m2.planes.data(), m2.face_count()); inter.kind() == Intersection::Kind::Segment) c1 += glm::distance(inter[0], inter[1]);
             }
-        }
-        else{
-            float val = 0;
-            for(std::shared_ptr<Polygon> face: obj2_sol->faces){
-                if(obj1->dist(*face) != 0) continue;
-                float check = glm::dot(obj1->vel - obj2->vel, face->normVec()*static_cast<float>(sign(face->sign_dist(*obj1.obj))));
-                if(check < val){
-                    val = check;
-                    dirVec = face->normVec();
+            for(unsigned int i = 0; i < m2.edge_count(); i++){
+                if(Intersection inter = Intersection::clip(m2.edge(i).a(), m2.edge(i).b(), m1.planes.data(), m1.face_count()); inter.kind() == Intersection::Kind::Segment) c2 += glm::distance(inter[0], inter[1]);
+            }
+            contact.owner = c1 < c2 ? 0:1;
+            const Mesh& ref = contact.owner == 0 ? m1:m2;
+            const Mesh& against = contact.owner == 0 ? m2:m1;
+            const Physical& body = contact.owner == 0 ? obj1:obj2;
+            const Physical& other = contact.owner == 0 ? obj2:obj1;
+            // The face the bodies approach each other fastest through, or for bodies at rest
+            // relative to each other, the one facing the other's center most.
+            float val = std::numeric_limits<float>::infinity(), facing = -std::numeric_limits<float>::infinity();
+            glm::vec3 between = other->pos - body->pos;
+            for(unsigned int i = 0; i < ref.face_count(); i++){
+                Mesh::Face face = ref.face(i);
+                if(!touches(face, against)) continue;
+                glm::vec3 n = face.normal()*static_cast<float>(sign(face.sign_dist(other->pos)));
+                float check = glm::dot(other->vel - body->vel, n), toward = glm::dot(between, n);
+                if(check < val - 1e-5 || (check < val + 1e-5 && toward > facing)){
+                    val = std::min(val, check);
+                    facing = toward;
+                    contact.feature = i;
                 }
             }
         }
+        if(contact.feature != Manifold::none){
+            Mesh::Face face = (contact.owner == 0 ? m1:m2).face(contact.feature);
+            const Physical& other = contact.owner == 0 ? obj2:obj1;
+            glm::vec3 n = face.normal()*static_cast<float>(sign(face.sign_dist(other->pos)));
+            contact.normal = contact.owner == 0 ? n:-n;
+            contact.count = clip_contacts(contact.owner == 0 ? m1:m2, contact.feature, contact.owner == 0 ? m2:m1, contact.points);
+            return true;
+        }
     }
-    obj1->vel += dirVec*glm::dot(dirVec, m2*impulse);
-    obj2->vel -= dirVec*glm::dot(dirVec, m1*impulse);
+    return false;
+}
+
+void CHandler::collision(Physical& obj1, Physical& obj2, Manifold& contact) const {
+    Row r;
+    if(!row(obj1, obj2, contact, r)) return;
+    warm(r);
+    solve(r);
+    contact.impulse = r.impulse;
 }
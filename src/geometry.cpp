@@ -1,15 +1,120 @@
 #include <algorithm>
+#include <set>
+#include <map>
+#include <cstring>
+#include <stdexcept>
+#include <limits>
 #include <glm/gtx/norm.hpp>
 #include "Graphics/geometry.hpp"
 #include "Graphics/gmath.hpp"
+#include "Graphics/hull.hpp"
 
 using namespace gmh;
 
+static float solid_dist(const Mesh& m, const glm::vec3& p){
+    bool contained = true;
+    for(unsigned int i = 0; i < m.face_count() && contained; i++)
+        contained = m.face(i).sign_dist(p) >= 0;
+    if(contained) return 0;
+    float min = std::numeric_limits<float>::infinity();
+    for(unsigned int i = 0; i < m.face_count(); i++)
+        min = std::min(min, m.face(i).dist(p));
+    return min;
+}
+
+static float line_dist(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b){
+    return glm::length(glm::cross(a - p, a - b))/glm::distance(a, b);
+}
+
+static float lines_dist(const glm::vec3& a0, const glm::vec3& a1, const glm::vec3& b0, const glm::vec3& b1){
+    glm::vec3 vec = glm::cross(glm::normalize(a1 - a0), glm::normalize(b1 - b0));
+    return glm::length2(vec) < 1e-5 ? line_dist(b0, a0, a1):std::abs(glm::dot(vec, a0 - b1))/glm::length(vec);
+}
+
+// Point or segment where a convex face meets the plane of another face that is not parallel to it.
+static Intersection section(const Mesh::Face& face, const Mesh::Face& other){
+    glm::vec3 dir = glm::cross(face.normal(), other.normal());
+    float lo = std::numeric_limits<float>::infinity(), hi = -lo;
+    glm::vec3 a, b;
+    auto extend = [&](const glm::vec3& p){
+        float t = glm::dot(p, dir);
+        if(t < lo){
+            lo = t;
+            a = p;
+        }
+        if(t > hi){
+            hi = t;
+            b = p;
+        }
+    };
+    unsigned int count = face.size();
+    for(unsigned int k = 0; k < count; k++){
+        const glm::vec3& p = face[k];
+        const glm::vec3& q = face[(k + 1)%count];
+        float sp = other.sign_dist(p), sq = other.sign_dist(q);
+        if(std::abs(sp) <= 1e-5) extend(p);
+        if(sp > 1e-5 && sq < -1e-5 || sp < -1e-5 && sq > 1e-5) extend(p + (q - p)*(sp/(sp - sq)));
+    }
+    if(lo > hi) return {};
+    return glm::distance(a, b) < 1e-5 ? Intersection::point(a):Intersection::segment(a, b);
+}
+
+// Intersection of the lines through a0, a1 and b0, b1, which must be less than 1e-5 apart.
+static Intersection line_line(const glm::vec3& a0, const glm::vec3& a1, const glm::vec3& b0, const glm::vec3& b1){
+    bool on0 = line_dist(b0, a0, a1) < 1e-5;
+    if(on0 && line_dist(b1, a0, a1) < 1e-5) return Intersection::line(b0, b1);
+    else if(on0) return Intersection::point(b0);
+    else if(line_dist(a0, b0, b1) < 1e-5) return Intersection::point(a0);
+    glm::vec3 da = glm::normalize(a1 - a0), db = glm::normalize(b1 - b0);
+    glm::vec3 vec1 = glm::cross(db, b0 - a0);
+    glm::vec3 vec2 = glm::cross(db, da);
+    return Intersection::point(a0 + (sign(glm::dot(vec1, vec2)))*(glm::length(vec1)/glm::length(vec2))*da);
+}
+
+// Distance from the plane of pl to a convex shape with count vertices at p, as Plane::dist(const LinSeg&) would give over its edges.
+static float plane_dist(const Plane& pl, const glm::vec3* p, size_t count){
+    bool below = false, above = false;
+    float min = std::numeric_limits<float>::infinity();
+    for(size_t i = 0; i < count; i++){
+        float s = pl.sign_dist(Point(p[i]));
+        if(sign(s) < 0) below = true;
+        else above = true;
+        min = std::min(min, std::abs(s));
+    }
+    return below && above ? 0:min;
+}
+
+// Intersection of the line, or segment if seg is set, through a and b with the plane of pl.
+static Intersection line_plane(const glm::vec3& a, const glm::vec3& b, bool seg, const Plane& pl){
+    glm::vec3 n = pl.normVec();
+    float sa = pl.sign_dist(Point(a)), sb = pl.sign_dist(Point(b));
+    glm::vec3 dir = glm::normalize(b - a);
+    float dist = seg ? ((sign(sa) ^ sign(sb)) < 0 ? 0:std::min(std::abs(sa), std::abs(sb))):(std::abs(glm::dot(n, dir)) < 1e-5 ? std::abs(sa):0);
+    if(dist >= 1e-5) return {};
+    if(std::abs(sa) < 1e-5 && std::abs(sb) < 1e-5) return seg ? Intersection::segment(a, b):Intersection::line(a, b);
+    if(glm::length2(glm::cross(dir, n)) < 1e-5) return Intersection::point(a - n*sa);
+    float t = sa/(sa - sb);
+    return Intersection::point(a + (b - a)*(seg ? std::clamp(t, 0.0f, 1.0f):t));
+}
+
+// Points where the edges of m cross the plane of pl.
+static Intersection plane_cut(const Plane& pl, const Mesh& m, unsigned int max){
+    Intersection points;
+    for(unsigned int i = 0; i < m.edge_count(); i++){
+        if(Intersection inter = line_plane(m.edge(i).a(), m.edge(i).b(), true, pl); inter.kind() == Intersection::Kind::Point) points.add(inter[0]);
+    }
+    return points.resolve(max);
+}
+
 Point::Point(): pos({0, 0, 0}), vel(0, 0, 0), model(1.0) {}
 
 Point::Point(glm::vec3 pos): pos(pos), vel(0, 0, 0), model(1.0) {}
 
+// Written out so that vertices is bound to the copy rather than copied from p.
+Point::Point(const Point& p): model(p.model), v(p.v), pos(p.pos), vel(p.vel) {}
+
 float Point::dist(const Point &obj) const {
+    if(typeid(obj) != typeid(Point)) return obj.dist(*this);
     return glm::distance(pos, obj.pos);
 }
 
@@ -22,55 +127,40 @@ float Point::dist(const LinSeg &obj) const {
 }
 
 float Point::dist(const Plane &obj) const {
-    return std::abs(glm::dot(obj.normVec(), pos - obj.vertices[0]->pos));
+    return std::abs(obj.sign_dist(*this));
 }
 
 float Point::dist(const Polygon &obj) const {
-    for(std::shared_ptr<LinSeg> edge: obj.edges)
-        if(glm::dot(glm::cross(edge->v[1]->pos - edge->v[0]->pos, pos - edge->v[0]->pos), obj.normVec()) < 0){
-            std::vector<float> distances(obj.edges.size());
-            std::transform(obj.edges.begin(), obj.edges.end(), distances.begin(), [this](std::shared_ptr<LinSeg> lin){
-                return dist(*lin);
-            });
-            return *std::min_element(distances.begin(), distances.end());
-        }
-    return std::abs(glm::dot(obj.normVec(), pos - obj.vertices[0]->pos));
+    return obj.mesh().face(0).dist(pos);
 }
 
 float Point::dist(const Polyhedron &obj) const {
-    bool contained = std::all_of(obj.faces.begin(), obj.faces.end(), [this](std::shared_ptr<Polygon> face){
-        return face->sign_dist(*this) >= 0;
-    });
-    if(contained) return 0;
-    std::vector<float> distances(obj.faces.size());
-    std::transform(obj.faces.begin(), obj.faces.end(), distances.begin(), [this](std::shared_ptr<Polygon> face){
-        return dist(*face);
-    });
-    return *std::min_element(distances.begin(), distances.end());
+    return solid_dist(obj.mesh(), pos);
 }
 
-std::unique_ptr<Point> Point::intersect(const Point &obj) const {
-    return dist(obj) < 1e-5 ? std::make_unique<Point>(this->pos):nullptr;
+Intersection Point::intersection(const Point &obj) const {
+    if(typeid(obj) != typeid(Point)) return obj.intersection(*this);
+    return within(obj, 1e-5) ? Intersection::point(pos):Intersection();
 }
 
-std::unique_ptr<Point> Point::intersect(const Line &obj) const {
-    return dist(obj) < 1e-5 ? std::make_unique<Point>(this->pos):nullptr;
+Intersection Point::intersection(const Line &obj) const {
+    return within(obj, 1e-5) ? Intersection::point(pos):Intersection();
 }
 
-std::unique_ptr<Point> Point::intersect(const LinSeg &obj) const {
-    return dist(obj) < 1e-5 ? std::make_unique<Point>(this->pos):nullptr;
+Intersection Point::intersection(const LinSeg &obj) const {
+    return within(obj, 1e-5) ? Intersection::point(pos):Intersection();
 }
 
-std::unique_ptr<Point> Point::intersect(const Plane &obj) const {
-    return dist(obj) < 1e-5 ? std::make_unique<Point>(this->pos):nullptr;
+Intersection Point::intersection(const Plane &obj) const {
+    return within(obj, 1e-5) ? Intersection::point(pos):Intersection();
 }
 
-std::unique_ptr<Point> Point::intersect(const Polygon &obj) const {
-    return dist(obj) < 1e-5 ? std::make_unique<Point>(this->pos):nullptr;
+Intersection Point::intersection(const Polygon &obj) const {
+    return within(obj, 1e-5) ? Intersection::point(pos):Intersection();
 }
 
-std::unique_ptr<Point> Point::intersect(const Polyhedron &obj) const {
-    return dist(obj) < 1e-5 ? std::make_unique<Point>(this->pos):nullptr;
+Intersection Point::intersection(const Polyhedron &obj) const {
+    return within(obj, 1e-5) ? Intersection::point(pos):Intersection();
 }
 
 glm::vec3 Point::direction(const Point &obj) const {
@@ -80,10 +170,20 @@ glm::vec3 Point::direction(const Point &obj) const {
 }
 
 bool Point::contains(const Point &obj) const {
+    obj.sync();
+    if(!extent().box.grown(1e-5).contains(obj.extent().box)) return false;
     if(typeid(obj) == typeid(Point)) return dist(obj) < 1e-5;
     else if (obj.isSpace() > isSpace() || obj.dim() > dim()) return false;
-    return std::none_of(obj.vertices.begin(), obj.vertices.end(), [this](std::shared_ptr<Point> vert){
-        return dist(*vert) >= 1e-5;
+    return obj.inside(*this);
+}
+
+bool Point::inside(const Point &obj) const {
+    if(const glm::vec3* cache = vertex_cache()){
+        for(size_t i = 0; i < vertex_count(); i++) if(obj.dist(Point(cache[i])) >= 1e-5) return false;
+        return true;
+    }
+    return std::none_of(vertices.begin(), vertices.end(), [&obj](std::shared_ptr<Point> vert){
+        return obj.dist(*vert) >= 1e-5;
     });
 }
 
@@ -92,17 +192,105 @@ bool Point::equals(const Point &obj) const {
 }
 
 void Point::update(float dt) {
-    model = glm::translate(model, dt*vel);
-    pos += dt*vel;
+    translate(dt*vel);
+}
+
+void Point::translate(const glm::vec3& d) {
+    model = glm::translate(glm::mat4(1), d)*model;
+    pos += d;
+    if(Deferred* later = deferred()){
+        later->mat[3] += glm::vec4(d, 0);
+        later->stale = true;
+        return;
+    }
     for(std::shared_ptr<Point> p: v)
-        p->pos += dt*vel;
+        p->pos += d;
+    refresh();
 }
 
 void Point::transform(glm::mat4 mat) {
     model = mat*model;
     pos = mat*glm::vec4(pos, 1.0);
+    if(Deferred* later = deferred()){
+        later->mat = mat*later->mat;
+        later->stale = true;
+        return;
+    }
     for(std::shared_ptr<Point> p: v)
         p->pos = mat*glm::vec4(p->pos, 1.0);
+    refresh();
+}
+
+void Point::settle(){
+    Deferred* later = deferred();
+    if(!later || !later->stale) return;
+    if(glm::vec3* cache = vertex_cache(); cache && v.empty()){
+        for(size_t i = 0; i < vertex_count(); i++) cache[i] = later->mat*glm::vec4(cache[i], 1.0);
+    }
+    for(std::shared_ptr<Point> p: v)
+        p->pos = later->mat*glm::vec4(p->pos, 1.0);
+    later->mat = glm::mat4(1);
+}
+
+Extent Point::extent() const {
+    if(v.empty()) return {{pos, pos}, {pos, 0}};
+    if(isSpace()) return Extent::everywhere();
+    AABB box{v[0]->pos, v[0]->pos};
+    for(const std::shared_ptr<Point>& p: v) box.add(p->pos);
+    Sphere ball{0.5f*(box.min + box.max), 0};
+    for(const std::shared_ptr<Point>& p: v) ball.radius = std::max(ball.radius, glm::distance(ball.center, p->pos));
+    return {box, ball};
+}
+
+glm::vec3 Point::support(const glm::vec3& dir) const {
+    if(v.empty()) return pos;
+    glm::vec3 best = v[0]->pos;
+    for(std::shared_ptr<Point> p: v)
+        if(glm::dot(p->pos, dir) > glm::dot(best, dir)) best = p->pos;
+    return best;
+}
+
+glm::vec3 Point::support(const glm::vec3& dir, unsigned int& start) const {
+    return support(dir);
+}
+
+void Point::snapshot(Snapshot& out) const {
+    out.write(model);
+    out.write(pos);
+    out.write(vel);
+    if(const Deferred* later = deferred()){
+        out.write(later->mat);
+        out.write(later->stale.load());
+    }
+    out.write(vertex_count());
+    if(const glm::vec3* cache = vertex_cache()) out.write(cache, vertex_count());
+    else for(const std::shared_ptr<Point>& p: v) out.write(p->pos);
+}
+
+void Point::restore(SnapshotReader& in){
+    in.read(model);
+    glm::vec3 saved = in.read<glm::vec3>();
+    in.read(vel);
+    if(Deferred* later = deferred()){
+        in.read(later->mat);
+        later->stale = in.read<bool>();
+    }
+    size_t count = in.read<size_t>();
+    if(count != vertex_count()) throw std::invalid_argument("Snapshot is of a different shape");
+    const unsigned char* verts = in.peek<glm::vec3>(count);
+    bool moved;
+    if(const glm::vec3* cache = vertex_cache()) moved = std::memcmp(cache, verts, count*sizeof(glm::vec3)) != 0;
+    else{
+        moved = false;
+        for(size_t i = 0; i < count && !moved; i++) moved = std::memcmp(&v[i]->pos, verts + i*sizeof(glm::vec3), sizeof(glm::vec3)) != 0;
+    }
+    if(moved){
+        if(glm::vec3* cache = vertex_cache(); cache && v.empty()) std::memcpy(cache, verts, count*sizeof(glm::vec3));
+        for(size_t i = 0; i < v.size(); i++) std::memcpy(&v[i]->pos, verts + i*sizeof(glm::vec3), sizeof(glm::vec3));
+        refresh();
+    }
+    in.skip(count*sizeof(glm::vec3));
+    pos = saved;
 }
 
 Point& Point::operator=(const Point& p){
@@ -134,6 +322,7 @@ Line::Line(std::vector<Point> vert): Line(vert[0], vert[1]){}
 Line::Line(std::vector<std::shared_ptr<Point>> vert): Line(vert[0], vert[1]){}
 
 float Line::dist(const Point &obj) const {
+    if(typeid(obj) != typeid(Point)) return obj.dist(*this);
     return glm::length(glm::cross(v[0]->pos - obj.pos, v[0]->pos - v[1]->pos) / v[0]->dist(*v[1]));
 }
 
@@ -146,7 +335,7 @@ float Line::dist(const LinSeg &obj) const {
     glm::vec3 c = glm::cross(dirVec(), obj.dirVec());
     if(glm::length2(c) < 1e-5) return dist(*obj.vertices[0]);
     float t = glm::determinant(glm::mat3(obj.vertices[0]->pos - v[0]->pos, dirVec(), c))/glm::length2(c);
-    return t < 0 || t > glm::distance(obj.vertices[1]->pos, obj.vertices[0]->pos) ? std::min(dist(*obj.vertices[0]), dist(*obj.vertices[1])):dist(static_cast<Line>(obj));
+    return t < 0 || t > glm::distance(obj.vertices[1]->pos, obj.vertices[0]->pos) ? std::min(dist(*obj.vertices[0]), dist(*obj.vertices[1])):lines_dist(v[0]->pos, v[1]->pos, obj.vertices[0]->pos, obj.vertices[1]->pos);
 }
 
 float Line::dist(const Plane &obj) const {
@@ -154,79 +343,64 @@ float Line::dist(const Plane &obj) const {
 }
 
 float Line::dist(const Polygon &obj) const {
-    std::unique_ptr<Point> p = intersect(static_cast<Plane>(obj));
-    if(p && obj.contains(*p)) return 0;
-    std::vector<float> distances(obj.edges.size());
-    std::transform(obj.edges.begin(), obj.edges.end(), distances.begin(), [this](std::shared_ptr<LinSeg> lin){
-        return dist(*lin);
-    });
-    return *std::min_element(distances.begin(), distances.end());
+    obj.sync();
+    Intersection p = line_plane(v[0]->pos, v[1]->pos, false, obj);
+    if(p.kind() == Intersection::Kind::Point && obj.contains(Point(p[0]))) return 0;
+    float min = std::numeric_limits<float>::infinity();
+    for(std::shared_ptr<LinSeg> edge: obj.edges) min = std::min(min, dist(*edge));
+    return min;
 }
 
 float Line::dist(const Polyhedron &obj) const {
-    std::vector<float> distances(obj.faces.size());
-    std::transform(obj.faces.begin(), obj.faces.end(), distances.begin(), [this](std::shared_ptr<Polygon> face){
-        return dist(*face);
-    });
-    return *std::min_element(distances.begin(), distances.end());
+    obj.sync();
+    float min = std::numeric_limits<float>::infinity();
+    for(std::shared_ptr<Polygon> face: obj.faces) min = std::min(min, dist(*face));
+    return min;
 }
 
-std::unique_ptr<Point> Line::intersect(const Point &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    return std::make_unique<Point>(obj.pos);
+Intersection Line::intersection(const Point &obj) const {
+    if(typeid(obj) != typeid(Point)) return obj.intersection(*this);
+    if(!within(obj, 1e-5)) return {};
+    return Intersection::point(obj.pos);
 }
 
-std::unique_ptr<Point> Line::intersect(const Line &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    if(contains(obj)) return std::make_unique<Line>(*obj.vertices[0], *obj.vertices[1]);
-    else if(contains(*obj.vertices[0])) return std::make_unique<Point>(obj.vertices[0]->pos);
-    else if(obj.contains(*v[0])) return std::make_unique<Point>(v[0]->pos);
-    glm::vec3 vec1 = glm::cross(obj.dirVec(), obj.vertices[0]->pos - v[0]->pos);
-    glm::vec3 vec2 = glm::cross(obj.dirVec(), dirVec());
-    return std::make_unique<Point>(v[0]->pos + (sign(glm::dot(vec1, vec2)))*(glm::length(vec1)/glm::length(vec2))*dirVec());
+Intersection Line::intersection(const Line &obj) const {
+    if(!within(obj, 1e-5)) return {};
+    return line_line(v[0]->pos, v[1]->pos, obj.vertices[0]->pos, obj.vertices[1]->pos);
 }
 
-std::unique_ptr<Point> Line::intersect(const LinSeg &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    return contains(obj) ? std::make_unique<LinSeg>(*obj.vertices[0], *obj.vertices[1]):intersect(static_cast<Line>(obj));
+Intersection Line::intersection(const LinSeg &obj) const {
+    if(!within(obj, 1e-5)) return {};
+    if(contains(obj)) return Intersection::segment(obj.vertices[0]->pos, obj.vertices[1]->pos);
+    if(!isSpace() && line_dist(v[0]->pos, obj.vertices[0]->pos, obj.vertices[1]->pos) < 1e-5 && line_dist(v[1]->pos, obj.vertices[0]->pos, obj.vertices[1]->pos) < 1e-5)
+        return Intersection::segment(v[0]->pos, v[1]->pos);
+    return line_line(v[0]->pos, v[1]->pos, obj.vertices[0]->pos, obj.vertices[1]->pos);
 }
 
-std::unique_ptr<Point> Line::intersect(const Plane &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    if(obj.contains(*this)) return std::make_unique<Line>(*v[0], *v[1]);
-    if(glm::length2(glm::cross(dirVec(), obj.normVec())) < 1e-5) return std::make_unique<Point>(v[0]->pos - obj.normVec()*obj.sign_dist(*v[0]));
-    return intersect(obj.project(*this));
+Intersection Line::intersection(const Plane &obj) const {
+    return line_plane(v[0]->pos, v[1]->pos, false, obj);
 }
 
-std::unique_ptr<Point> Line::intersect(const Polygon &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    else if(glm::length2(glm::cross(dirVec(), obj.normVec())) < 1e-5) return std::make_unique<Point>(v[0]->pos - obj.normVec()*obj.sign_dist(*v[0]));
+Intersection Line::intersection(const Polygon &obj) const {
+    if(!within(obj, 1e-5)) return {};
+    else if(glm::length2(glm::cross(dirVec(), obj.normVec())) < 1e-5) return Intersection::point(v[0]->pos - obj.normVec()*obj.sign_dist(*v[0]));
     if(std::abs(glm::dot(dirVec(), obj.normVec())) < 1e-5){
-        std::vector<Point> points;
-        points.reserve(obj.edges.size());
+        Intersection points;
         for(std::shared_ptr<LinSeg> edge: obj.edges){
-            if(std::unique_ptr<Point> inter = intersect(*edge); inter && typeid(*inter) == typeid(Point)) points.push_back(*inter);
+            if(Intersection inter = intersection(*edge); inter.kind() == Intersection::Kind::Point) points.add(inter[0]);
         }
-        std::vector<Point>::iterator it = std::unique(points.begin(), points.end(), [](Point p1, Point p2){
-            return p1.equals(p2);
-        });
-        return std::distance(points.begin(), it) == 1 ? std::make_unique<Point>(points[0]):std::make_unique<LinSeg>(points[0], points[1]);
+        return points.resolve(2);
     }
-    return intersect(obj.project(*this));
+    return line_plane(v[0]->pos, v[1]->pos, false, obj);
 }
 
-std::unique_ptr<Point> Line::intersect(const Polyhedron &obj) const {
-    std::vector<Point> points;
-    points.reserve(obj.faces.size());
+Intersection Line::intersection(const Polyhedron &obj) const {
+    obj.sync();
+    Intersection points;
     for(std::shared_ptr<Polygon> face: obj.faces){
-        if(std::unique_ptr<Point> inter = intersect(*face); inter && typeid(*inter) == typeid(Point)) points.push_back(*inter);
+        if(Intersection inter = intersection(*face); inter.kind() == Intersection::Kind::Point) points.add(inter[0]);
     }
-    std::vector<Point>::iterator it = std::unique(points.begin(), points.end(), [](Point p1, Point p2){
-        return p1.equals(p2);
-    });
-    points.resize(std::distance(points.begin(), it));
-    if(points.size() == 0) return nullptr;
-    return points.size() == 1 ? std::make_unique<Point>(points[0]):std::make_unique<LinSeg>(points[0], points[1]);
+    return points.resolve(2);
 }
 
 glm::vec3 Line::dirVec() const {
@@ -245,6 +419,7 @@ float Line::angle(const Line &lobj, glm::vec3* axisptr){
 }
 
 float LinSeg::dist(const Point &obj) const {
+    if(typeid(obj) != typeid(Point)) return obj.dist(*this);
     return glm::dot(obj.pos - v[0]->pos, v[1]->pos - v[0]->pos) > 0 && glm::dot(obj.pos - v[1]->pos, v[0]->pos - v[1]->pos) > 0 ? glm::length(glm::cross(v[0]->pos - obj.pos, v[0]->pos - v[1]->pos) / v[0]->dist(*v[1])):std::min(obj.dist(*v[0]), obj.dist(*v[1]));
 }
 
@@ -252,7 +427,7 @@ float LinSeg::dist(const Line &obj) const {
     glm::vec3 c = glm::cross(obj.dirVec(), dirVec());
     if(glm::length2(c) < 1e-5) return obj.dist(*v[0]);
     float t = glm::determinant(glm::mat3(v[0]->pos - obj.vertices[0]->pos, obj.dirVec(), c))/glm::length2(c);
-    return t < 0 || t > glm::distance(v[1]->pos, v[0]->pos) ? std::min(obj.dist(*v[0]), obj.dist(*v[1])):obj.dist(static_cast<Line>(*this));
+    return t < 0 || t > glm::distance(v[1]->pos, v[0]->pos) ? std::min(obj.dist(*v[0]), obj.dist(*v[1])):lines_dist(obj.vertices[0]->pos, obj.vertices[1]->pos, v[0]->pos, v[1]->pos);
 }
 
 float LinSeg::dist(const LinSeg &obj) const {
@@ -273,93 +448,73 @@ float LinSeg::dist(const Plane &obj) const {
 }
 
 float LinSeg::dist(const Polygon &obj) const {
-    std::unique_ptr<Point> p = intersect(static_cast<Plane>(obj));
-    if(p && obj.contains(*p)) return 0;
-    std::vector<float> distances(obj.edges.size());
-    std::transform(obj.edges.begin(), obj.edges.end(), distances.begin(), [this](std::shared_ptr<LinSeg> lin){
-        return dist(*lin);
-    });
-    float min = *std::min_element(distances.begin(), distances.end());
-    min = std::min(min, obj.dist(*v[0]));
-    min = std::min(min, obj.dist(*v[1]));
+    obj.sync();
+    Intersection p = line_plane(v[0]->pos, v[1]->pos, true, obj);
+    if(p.kind() == Intersection::Kind::Point && obj.contains(Point(p[0]))) return 0;
+    float min = std::min(obj.dist(*v[0]), obj.dist(*v[1]));
+    for(std::shared_ptr<LinSeg> edge: obj.edges) if(gap(*edge) < min) min = std::min(min, dist(*edge));
     return min;
 }
 
 float LinSeg::dist(const Polyhedron &obj) const {
+    obj.sync();
     for(std::shared_ptr<Point> p: v) if(obj.contains(*p)) return 0;
-    std::vector<float> distances(obj.faces.size());
-    std::transform(obj.faces.begin(), obj.faces.end(), distances.begin(), [this](std::shared_ptr<Polygon> face){
-        return dist(*face);
-    });
-    return *std::min_element(distances.begin(), distances.end());
+    float min = std::numeric_limits<float>::infinity();
+    for(std::shared_ptr<Polygon> face: obj.faces) if(gap(*face) < min) min = std::min(min, dist(*face));
+    return min;
 }
 
-std::unique_ptr<Point> LinSeg::intersect(const Point &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    return std::make_unique<Point>(obj.pos);
+Intersection LinSeg::intersection(const Point &obj) const {
+    if(typeid(obj) != typeid(Point)) return obj.intersection(*this);
+    if(!within(obj, 1e-5)) return {};
+    return Intersection::point(obj.pos);
 }
 
-std::unique_ptr<Point> LinSeg::intersect(const Line &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    return obj.contains(*this) ? std::make_unique<LinSeg>(*v[0], *v[1]):obj.intersect(static_cast<Line>(*this));
+Intersection LinSeg::intersection(const Line &obj) const {
+    if(!within(obj, 1e-5)) return {};
+    if(obj.contains(*this)) return Intersection::segment(v[0]->pos, v[1]->pos);
+    return line_line(obj.vertices[0]->pos, obj.vertices[1]->pos, v[0]->pos, v[1]->pos);
 }
 
-std::unique_ptr<Point> LinSeg::intersect(const LinSeg &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    if(contains(obj)) return std::make_unique<LinSeg>(*obj.vertices[0], *obj.vertices[1]);
-    else if(obj.contains(*this)) return std::make_unique<LinSeg>(*v[0], *v[1]);
+Intersection LinSeg::intersection(const LinSeg &obj) const {
+    if(!within(obj, 1e-5)) return {};
+    if(contains(obj)) return Intersection::segment(obj.vertices[0]->pos, obj.vertices[1]->pos);
+    else if(obj.contains(*this)) return Intersection::segment(v[0]->pos, v[1]->pos);
     if(glm::length2(glm::cross(dirVec(), obj.dirVec())) < 1e-5){
         if(obj.contains(*v[0])){
-            if(v[0]->equals(*obj.vertices[0]) || v[0]->equals(*obj.vertices[1])) return std::make_unique<Point>(v[0]->pos);
-            return contains(*obj.vertices[0]) ? std::make_unique<LinSeg>(*v[0], *obj.vertices[0]):std::make_unique<LinSeg>(*v[0], *obj.vertices[1]);
+            if(v[0]->equals(*obj.vertices[0]) || v[0]->equals(*obj.vertices[1])) return Intersection::point(v[0]->pos);
+            return Intersection::segment(v[0]->pos, contains(*obj.vertices[0]) ? obj.vertices[0]->pos:obj.vertices[1]->pos);
         }
         if(obj.contains(*v[1])){
-            if(v[1]->equals(*obj.vertices[0]) || v[1]->equals(*obj.vertices[1])) return std::make_unique<Point>(v[1]->pos);
-            return contains(*obj.vertices[0]) ? std::make_unique<LinSeg>(*v[1], *obj.vertices[0]):std::make_unique<LinSeg>(*v[1], *obj.vertices[1]);
+            if(v[1]->equals(*obj.vertices[0]) || v[1]->equals(*obj.vertices[1])) return Intersection::point(v[1]->pos);
+            return Intersection::segment(v[1]->pos, contains(*obj.vertices[0]) ? obj.vertices[0]->pos:obj.vertices[1]->pos);
         }
     }
-    return Line::intersect(obj);
+    return Line::intersection(obj);
 }
 
-std::unique_ptr<Point> LinSeg::intersect(const Plane &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    if(obj.contains(*this)) return std::make_unique<LinSeg>(*v[0], *v[1]);
-    if(glm::length2(glm::cross(dirVec(), obj.normVec())) < 1e-5) return std::make_unique<Point>(v[0]->pos - obj.normVec()*obj.sign_dist(*v[0]));
-    return intersect(obj.project(*this));
+Intersection LinSeg::intersection(const Plane &obj) const {
+    return line_plane(v[0]->pos, v[1]->pos, true, obj);
 }
 
-std::unique_ptr<Point> LinSeg::intersect(const Polygon &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    else if(glm::length2(glm::cross(dirVec(), obj.normVec())) < 1e-5) return std::make_unique<Point>(v[0]->pos - obj.normVec()*obj.sign_dist(*v[0]));
-    else if(obj.contains(*this)) return std::make_unique<LinSeg>(*v[0], *v[1]);
+Intersection LinSeg::intersection(const Polygon &obj) const {
+    if(!within(obj, 1e-5)) return {};
+    else if(glm::length2(glm::cross(dirVec(), obj.normVec())) < 1e-5) return Intersection::point(v[0]->pos - obj.normVec()*obj.sign_dist(*v[0]));
+    else if(obj.contains(*this)) return Intersection::segment(v[0]->pos, v[1]->pos);
     if(std::abs(glm::dot(dirVec(), obj.normVec())) < 1e-5){
-        std::vector<Point> points;
-        points.reserve(obj.edges.size() + 1);
-        if(obj.contains(*v[0])) points.push_back(*v[0]);
+        Intersection points;
+        if(obj.contains(*v[0])) points.add(v[0]->pos);
         for(std::shared_ptr<LinSeg> edge: obj.edges){
-            if(std::unique_ptr<Point> inter = intersect(*edge); inter && typeid(*inter) == typeid(Point)) points.push_back(*inter);
+            if(Intersection inter = intersection(*edge); inter.kind() == Intersection::Kind::Point) points.add(inter[0]);
         }
-        std::vector<Point>::iterator it = std::unique(points.begin(), points.end(), [](Point p1, Point p2){
-            return p1.equals(p2);
-        });
-        return std::distance(points.begin(), it) == 1 ? std::make_unique<Point>(points[0]):std::make_unique<LinSeg>(points[0], points[1]);
+        return points.resolve(2);
     }
-    return intersect(obj.project(*this));
+    return line_plane(v[0]->pos, v[1]->pos, true, obj);
 }
 
-std::unique_ptr<Point> LinSeg::intersect(const Polyhedron &obj) const {
-    if(obj.contains(*this)) return std::make_unique<LinSeg>(*v[0], *v[1]);
-    std::vector<Point> points;
-    if(obj.contains(*v[0])) points.push_back(*v[0]);
-    for(std::shared_ptr<Polygon> face: obj.faces){
-        if(std::unique_ptr<Point> inter = intersect(*face); inter && typeid(*inter) == typeid(Point)) points.push_back(*inter);
-    }
-    std::vector<Point>::iterator it = std::unique(points.begin(), points.end(), [](Point p1, Point p2){
-        return p1.equals(p2);
-    });
-    points.resize(std::distance(points.begin(), it));
-    if(points.size() == 0) return nullptr;
-    return points.size() == 1 ? std::make_unique<Point>(points[0]):std::make_unique<LinSeg>(points[0], points[1]);
+Intersection LinSeg::intersection(const Polyhedron &obj) const {
+    if(gap(obj) >= 1e-5) return {};
+    return Intersection::clip(v[0]->pos, v[1]->pos, obj.mesh().planes.data(), obj.mesh().face_count());
 }
 
 float LinSeg::length() const {
@@ -368,37 +523,32 @@ float LinSeg::length() const {
 
 Plane::Plane(){
     v = {std::make_shared<Point>(glm::vec3(0, 0, 0)), std::make_shared<Point>(glm::vec3(1, 0, 0)), std::make_shared<Point>(glm::vec3(0, 1, 0))};
+    Plane::refresh();
 }
 
 Plane::Plane(Point p1, Point p2, Point p3){
     if(Line(p1, p2).contains(p3)) throw std::invalid_argument("Inputs cannot be collinear");
     v = {std::make_shared<Point>(p1.pos), std::make_shared<Point>(p2.pos), std::make_shared<Point>(p3.pos)};
+    Plane::refresh();
 }
 
 Plane::Plane(std::shared_ptr<Point> p1, std::shared_ptr<Point> p2, std::shared_ptr<Point> p3){
     if(Line(*p1, *p2).contains(*p3)) throw std::invalid_argument("Inputs cannot be collinear");
     v = {p1, p2, p3};
+    Plane::refresh();
 }
 
 Plane::Plane(std::vector<Point> vert): Plane(vert[0], vert[1], vert[2]){}
 
 Plane::Plane(std::vector<std::shared_ptr<Point>> vert): Plane(vert[0], vert[1], vert[2]){}
 
-glm::vec3 Plane::normVec() const {
-    glm::vec3 vec = glm::cross(v[1]->pos - v[0]->pos, v[2]->pos - v[0]->pos);
-    return glm::normalize(vec);
-}
-
 Point Plane::project(const Point &obj) const {
     return Point(obj.pos - normVec()*sign_dist(obj));
 }
 
-float Plane::sign_dist(const Point &obj) const {
-    return glm::dot(normVec(), obj.pos - v[0]->pos);
-}
-
 float Plane::dist(const Point &obj) const {
-    return std::abs(glm::dot(normVec(), obj.pos - v[0]->pos));
+    if(typeid(obj) != typeid(Point)) return obj.dist(*this);
+    return std::abs(sign_dist(obj));
 }
 
 float Plane::dist(const Line &obj) const {
@@ -415,88 +565,56 @@ float Plane::dist(const Plane &obj) const {
 }
 
 float Plane::dist(const Polygon &obj) const {
-    std::vector<float> distances(obj.edges.size());
-    std::transform(obj.edges.begin(), obj.edges.end(), distances.begin(), [this](std::shared_ptr<LinSeg> lin){
-        return dist(*lin);
-    });
-    return *std::min_element(distances.begin(), distances.end());
+    return plane_dist(*this, obj.mesh().verts.data(), obj.mesh().verts.size());
 }
 
 float Plane::dist(const Polyhedron &obj) const {
-    std::vector<float> distances(obj.faces.size());
-    std::transform(obj.faces.begin(), obj.faces.end(), distances.begin(), [this](std::shared_ptr<Polygon> face){
-        return dist(*face);
-    });
-    return *std::min_element(distances.begin(), distances.end());
+    return plane_dist(*this, obj.mesh().verts.data(), obj.mesh().verts.size());
 };
 
-std::unique_ptr<Point> Plane::intersect(const Point &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    return std::make_unique<Point>(obj.pos);
+Intersection Plane::intersection(const Point &obj) const {
+    if(typeid(obj) != typeid(Point)) return obj.intersection(*this);
+    if(!within(obj, 1e-5)) return {};
+    return Intersection::point(obj.pos);
 }
 
-std::unique_ptr<Point> Plane::intersect(const Line &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    if(contains(obj)) return std::make_unique<Line>(*obj.vertices[0], *obj.vertices[1]);
-    if(glm::length2(glm::cross(obj.dirVec(), normVec())) < 1e-5) return std::make_unique<Point>(obj.vertices[0]->pos - normVec()*sign_dist(*obj.vertices[0]));
-    return obj.intersect(project(obj));
+Intersection Plane::intersection(const Line &obj) const {
+    return line_plane(obj.vertices[0]->pos, obj.vertices[1]->pos, false, *this);
 }
 
-std::unique_ptr<Point> Plane::intersect(const LinSeg &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    if(contains(obj)) return std::make_unique<LinSeg>(*obj.vertices[0], *obj.vertices[1]);
-    if(glm::length2(glm::cross(obj.dirVec(), normVec())) < 1e-5) return std::make_unique<Point>(obj.vertices[0]->pos - normVec()*sign_dist(*obj.vertices[0]));
-    return obj.intersect(project(obj));
+Intersection Plane::intersection(const LinSeg &obj) const {
+    return line_plane(obj.vertices[0]->pos, obj.vertices[1]->pos, true, *this);
 }
 
-std::unique_ptr<Point> Plane::intersect(const Plane &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    else if(contains(obj)) return std::make_unique<Plane>(*obj.vertices[0], *obj.vertices[1], *obj.vertices[2]);
-    std::unique_ptr<Point> x = obj.intersect(Line(v[0], v[1]));
-    if(!x) x = obj.intersect(Line(v[0], v[2]));
-    return std::make_unique<Line>(*x, Point(x->pos + glm::cross(normVec(), obj.normVec())));
+Intersection Plane::intersection(const Plane &obj) const {
+    if(!within(obj, 1e-5)) return {};
+    else if(contains(obj)) return Intersection::plane(obj.vertices[0]->pos, obj.vertices[1]->pos, obj.vertices[2]->pos);
+    Intersection x = line_plane(v[0]->pos, v[1]->pos, false, obj);
+    if(!x) x = line_plane(v[0]->pos, v[2]->pos, false, obj);
+    return Intersection::line(x[0], x[0] + glm::cross(normVec(), obj.normVec()));
 }
 
-std::unique_ptr<Point> Plane::intersect(const Polygon &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    if(contains(obj)){
-        std::vector<Point> vert;
-        vert.reserve(obj.vertices.size());
-        std::transform(obj.vertices.begin(), obj.vertices.end(), std::back_inserter(vert), [](std::shared_ptr<Point> p){
-            return Point(p->pos);
-        });
-        return std::make_unique<Polygon>(vert);
-    }
-    std::vector<Point> points;
-    points.reserve(obj.edges.size());
-    for(std::shared_ptr<LinSeg> edge: obj.edges){
-        if(std::unique_ptr<Point> inter = intersect(*edge); inter && typeid(*inter) == typeid(Point)) points.push_back(*inter);
-    }
-    std::vector<Point>::iterator it = std::unique(points.begin(), points.end(), [](Point p1, Point p2){
-        return p1.equals(p2);
-    });
-    return std::distance(points.begin(), it) == 1 ? std::make_unique<Point>(points[0]):std::make_unique<LinSeg>(points[0], points[1]);
+Intersection Plane::intersection(const Polygon &obj) const {
+    if(!within(obj, 1e-5)) return {};
+    if(contains(obj)) return Intersection::polygon(obj.mesh().face(0));
+    return plane_cut(*this, obj.mesh(), 2);
 }
 
-std::unique_ptr<Point> Plane::intersect(const Polyhedron &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    std::vector<Point> points;
-    for(std::shared_ptr<LinSeg> edge: obj.edges){
-        if(std::unique_ptr<Point> inter = intersect(*edge); inter && typeid(*inter) == typeid(Point)) points.push_back(*inter);
-    }
-    std::vector<Point> out;
-    out.reserve(points.size());
-    std::copy_if(points.begin(), points.end(), std::back_inserter(out), [&out](Point p1){
-        return std::none_of(out.begin(), out.end(), [&p1](Point p2){return p1.equals(p2);});
-    });
-    if(out.size() == 1) return std::make_unique<Point>(out[0]);
-    else if(out.size() == 2) return std::make_unique<LinSeg>(out[0], out[1]);
-    else return std::make_unique<Polygon>(out);
+Intersection Plane::intersection(const Polyhedron &obj) const {
+    if(!within(obj, 1e-5)) return {};
+    return plane_cut(*this, obj.mesh(), ~0u);
 }
 
+void Plane::refresh(){
+    n = glm::normalize(glm::cross(v[1]->pos - v[0]->pos, v[2]->pos - v[0]->pos));
+    d = glm::dot(n, v[0]->pos);
+}
+
+// Polygons built from values keep only their mesh, see Point::vertices.
 Polygon::Polygon(){
+    index();
     pos = {1.0/3.0, 1.0/3.0, 1.0/3.0};
-    e = {std::make_shared<LinSeg>(v[0], v[1]), std::make_shared<LinSeg>(v[1], v[2]), std::make_shared<LinSeg>(v[2], v[0])};
+    std::vector<std::shared_ptr<Point>>().swap(v);
 }
 
 Polygon::Polygon(std::vector<Point> vert): Plane(vert[0], vert[1], vert[2]){
@@ -523,6 +641,9 @@ Polygon::Polygon(std::vector<Point> vert): Plane(vert[0], vert[1], vert[2]){
         if(i > 0 && e[i-1]->angle(*e[i%e.size()], &vec) > glm::pi<float>() || i == v.size() - 1 && e[i]->angle(*e[0], &vec) > glm::pi<float>())
             throw std::invalid_argument("Inputs must define a convex polygon");
     }
+    index();
+    std::vector<std::shared_ptr<Point>>().swap(v);
+    std::vector<std::shared_ptr<LinSeg>>().swap(e);
 }
 
 Polygon::Polygon(std::vector<std::shared_ptr<Point>> vert){
@@ -546,451 +667,461 @@ Polygon::Polygon(std::vector<std::shared_ptr<Point>> vert){
         if(i > 0 && e[i-1]->angle(*e[i%e.size()], &vec) > glm::pi<float>() || i == v.size() - 1 && e[i]->angle(*e[0], &vec) > glm::pi<float>())
             throw std::invalid_argument("Inputs must define a convex polygon");
     }
+    index();
+}
+
+Polygon::Polygon(std::vector<std::shared_ptr<Point>> loop, Ordered){
+    v = std::move(loop);
+    e.reserve(v.size());
+    for(unsigned int i = 0; i < v.size(); i++) e.push_back(std::make_shared<LinSeg>(v[i], v[(i+1)%v.size()]));
+    index();
 }
 
 float Polygon::dist(const Point &obj) const {
-    for(std::shared_ptr<LinSeg> edge: e)
-        if(glm::dot(glm::cross(edge->vertices[1]->pos - edge->vertices[0]->pos, obj.pos - edge->vertices[0]->pos), normVec()) < 0){
-            std::vector<float> distances(e.size());
-            std::transform(e.begin(), e.end(), distances.begin(), [&obj](std::shared_ptr<LinSeg> lin){
-                return obj.dist(*lin);
-            });
-            return *std::min_element(distances.begin(), distances.end());
-        }
-    return std::abs(glm::dot(normVec(), obj.pos - v[0]->pos));
+    if(typeid(obj) != typeid(Point)) return obj.dist(*this);
+    sync();
+    return m.face(0).dist(obj.pos);
 }
 
 float Polygon::dist(const Line &obj) const {
-    Plane pl(v[0], v[1], v[2]);
-    std::unique_ptr<Point> p = pl.intersect(obj);
-    if(p && contains(*p)) return 0;
-    std::vector<float> distances(e.size());
-    std::transform(e.begin(), e.end(), distances.begin(), [&obj](std::shared_ptr<LinSeg> lin){
-        return obj.dist(*lin);
-    });
-    return *std::min_element(distances.begin(), distances.end());
+    sync();
+    Intersection p = line_plane(obj.vertices[0]->pos, obj.vertices[1]->pos, false, *this);
+    if(p.kind() == Intersection::Kind::Point && contains(Point(p[0]))) return 0;
+    float min = std::numeric_limits<float>::infinity();
+    for(std::shared_ptr<LinSeg> edge: edges) min = std::min(min, obj.dist(*edge));
+    return min;
 }
 
 float Polygon::dist(const LinSeg &obj) const {
-    std::unique_ptr<Point> p = static_cast<Plane>(*this).intersect(obj);
-    if(p && contains(*p)) return 0;
-    std::vector<float> distances(e.size());
-    std::transform(e.begin(), e.end(), distances.begin(), [&obj](std::shared_ptr<LinSeg> lin){
-        return obj.dist(*lin);
-    });
-    float min = *std::min_element(distances.begin(), distances.end());
-    min = std::min(min, dist(*obj.vertices[0]));
-    min = std::min(min, dist(*obj.vertices[1]));
+    sync();
+    Intersection p = line_plane(obj.vertices[0]->pos, obj.vertices[1]->pos, true, *this);
+    if(p.kind() == Intersection::Kind::Point && contains(Point(p[0]))) return 0;
+    float min = std::min(dist(*obj.vertices[0]), dist(*obj.vertices[1]));
+    for(std::shared_ptr<LinSeg> edge: edges) if(obj.gap(*edge) < min) min = std::min(min, obj.dist(*edge));
     return min;
 }
 
 float Polygon::dist(const Plane &obj) const {
-    std::vector<float> distances(e.size());
-    std::transform(e.begin(), e.end(), distances.begin(), [&obj](std::shared_ptr<LinSeg> lin){
-        return obj.dist(*lin);
-    });
-    return *std::min_element(distances.begin(), distances.end());
+    sync();
+    if(typeid(obj) != typeid(Plane)) return obj.dist(*this);
+    return plane_dist(obj, m.verts.data(), m.verts.size());
 }
 
 float Polygon::dist(const Polygon &obj) const {
-    std::vector<float> dist1(e.size());
-    std::vector<float> dist2(obj.e.size());
-    std::transform(e.begin(), e.end(), dist1.begin(), [&obj](std::shared_ptr<LinSeg> lin){return obj.dist(*lin);});
-    std::transform(obj.e.begin(), obj.e.end(), dist2.begin(), [this](std::shared_ptr<LinSeg> lin){return dist(*lin);});
-    return std::min(*std::min_element(dist1.begin(), dist1.end()), *std::min_element(dist2.begin(), dist2.end()));
+    sync();
+    obj.sync();
+    float min = std::numeric_limits<float>::infinity();
+    for(std::shared_ptr<LinSeg> edge: edges) if(obj.gap(*edge) < min) min = std::min(min, obj.dist(*edge));
+    for(std::shared_ptr<LinSeg> edge: obj.edges) if(gap(*edge) < min) min = std::min(min, dist(*edge));
+    return min;
 }
 
 float Polygon::dist(const Polyhedron &obj) const {
-    for(std::shared_ptr<Point> p: v) if(obj.contains(*p)) return 0;
-    std::vector<float> distances(obj.faces.size());
-    std::transform(obj.faces.begin(), obj.faces.end(), distances.begin(), [this](std::shared_ptr<Polygon> face){
-        return dist(*face);
-    });
-    return *std::min_element(distances.begin(), distances.end());
+    sync();
+    obj.sync();
+    for(const glm::vec3& p: m.verts) if(obj.contains(Point(p))) return 0;
+    float min = std::numeric_limits<float>::infinity();
+    for(std::shared_ptr<Polygon> face: obj.faces) if(gap(*face) < min) min = std::min(min, dist(*face));
+    return min;
 }
 
-std::unique_ptr<Point> Polygon::intersect(const Point &obj) const{
-    if(dist(obj) >= 1e-5) return nullptr;
-    return std::make_unique<Point>(obj.pos);
+Intersection Polygon::intersection(const Point &obj) const{
+    if(typeid(obj) != typeid(Point)) return obj.intersection(*this);
+    sync();
+    if(!within(obj, 1e-5)) return {};
+    return Intersection::point(obj.pos);
 }
 
-std::unique_ptr<Point> Polygon::intersect(const Line &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    else if(glm::length2(glm::cross(obj.dirVec(), normVec())) < 1e-5) return std::make_unique<Point>(obj.vertices[0]->pos - normVec()*sign_dist(*obj.vertices[0]));
+Intersection Polygon::intersection(const Line &obj) const {
+    sync();
+    if(!within(obj, 1e-5)) return {};
+    else if(glm::length2(glm::cross(obj.dirVec(), normVec())) < 1e-5) return Intersection::point(obj.vertices[0]->pos - normVec()*sign_dist(*obj.vertices[0]));
     if(std::abs(glm::dot(obj.dirVec(), normVec())) < 1e-5){
-        std::vector<Point> points;
-        for(std::shared_ptr<LinSeg> edge: e){
-            if(std::unique_ptr<Point> inter = obj.intersect(*edge); inter && typeid(*inter) == typeid(Point)) points.push_back(*inter);
+        Intersection points;
+        for(std::shared_ptr<LinSeg> edge: edges){
+            if(Intersection inter = obj.intersection(*edge); inter.kind() == Intersection::Kind::Point) points.add(inter[0]);
         }
-        std::vector<Point>::iterator it = std::unique(points.begin(), points.end(), [](Point p1, Point p2){
-            return p1.equals(p2);
-        });
-        return std::distance(points.begin(), it) == 1 ? std::make_unique<Point>(points[0]):std::make_unique<LinSeg>(points[0], points[1]);
+        return points.resolve(2);
     }
-    return obj.intersect(project(obj));
+    return line_plane(obj.vertices[0]->pos, obj.vertices[1]->pos, false, *this);
 }
 
-std::unique_ptr<Point> Polygon::intersect(const LinSeg &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    else if(glm::length2(glm::cross(obj.dirVec(), normVec())) < 1e-5) return std::make_unique<Point>(obj.vertices[0]->pos - normVec()*sign_dist(*obj.vertices[0]));
-    else if(contains(obj)) return std::make_unique<LinSeg>(*obj.vertices[0], *obj.vertices[1]);
+Intersection Polygon::intersection(const LinSeg &obj) const {
+    sync();
+    if(!within(obj, 1e-5)) return {};
+    else if(glm::length2(glm::cross(obj.dirVec(), normVec())) < 1e-5) return Intersection::point(obj.vertices[0]->pos - normVec()*sign_dist(*obj.vertices[0]));
+    else if(contains(obj)) return Intersection::segment(obj.vertices[0]->pos, obj.vertices[1]->pos);
     if(std::abs(glm::dot(obj.dirVec(), normVec())) < 1e-5){
-        std::vector<Point> points;
-        if(contains(*obj.vertices[0])) points.push_back(*obj.vertices[0]);
-        else if(contains(*obj.vertices[1])) points.push_back(*obj.vertices[1]);
-        for(std::shared_ptr<LinSeg> edge: e){
-            if(std::unique_ptr<Point> inter = obj.intersect(*edge); inter && typeid(*inter) == typeid(Point)) points.push_back(*inter);
+        Intersection points;
+        if(contains(*obj.vertices[0])) points.add(obj.vertices[0]->pos);
+        else if(contains(*obj.vertices[1])) points.add(obj.vertices[1]->pos);
+        for(std::shared_ptr<LinSeg> edge: edges){
+            if(Intersection inter = obj.intersection(*edge); inter.kind() == Intersection::Kind::Point) points.add(inter[0]);
         }
-        std::vector<Point>::iterator it = std::unique(points.begin(), points.end(), [](Point p1, Point p2){
-            return p1.equals(p2);
-        });
-        return std::distance(points.begin(), it) == 1 ? std::make_unique<Point>(points[0]):std::make_unique<LinSeg>(points[0], points[1]);
-    }
-    return obj.intersect(project(obj));
-}
-
-std::unique_ptr<Point> Polygon::intersect(const Plane &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    else if(obj.contains(*this)){
-        std::vector<Point> vert;
-        vert.reserve(vert.size());
-        std::transform(vertices.begin(), vertices.end(), std::back_inserter(vert), [](std::shared_ptr<Point> p){
-            return *p;
-        });
-        return std::make_unique<Polygon>(vert);
-    }
-    std::vector<Point> points;
-    for(std::shared_ptr<LinSeg> edge: e){
-        if(std::unique_ptr<Point> inter = obj.intersect(*edge); inter && typeid(*inter) == typeid(Point)) points.push_back(*inter);
-    }
-    std::vector<Point>::iterator it = std::unique(points.begin(), points.end(), [](Point p1, Point p2){
-        return p1.equals(p2);
-    });
-    return std::distance(points.begin(), it) == 1 ? std::make_unique<Point>(points[0]):std::make_unique<LinSeg>(points[0], points[1]);
+        return points.resolve(2);
+    }
+    return line_plane(obj.vertices[0]->pos, obj.vertices[1]->pos, true, *this);
 }
 
-std::unique_ptr<Point> Polygon::intersect(const Polygon &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    std::vector<Point> points;
-    for(std::shared_ptr<Point> p: v)
-        if(obj.contains(*p)) points.push_back(*p);
-    for(std::shared_ptr<Point> p: obj.vertices)
-        if(contains(*p)) points.push_back(*p);
+Intersection Polygon::intersection(const Plane &obj) const {
+    sync();
+    if(typeid(obj) != typeid(Plane)) return obj.intersection(*this);
+    if(!within(obj, 1e-5)) return {};
+    else if(obj.contains(*this)) return Intersection::polygon(m.face(0));
+    return plane_cut(obj, m, 2);
+}
+
+Intersection Polygon::intersection(const Polygon &obj) const {
+    sync();
+    obj.sync();
+    if(gap(obj) >= 1e-5) return {};
+    Mesh::Face other = obj.mesh().face(0);
     if(glm::length2(glm::cross(normVec(), obj.normVec())) < 1e-5){
-        for(std::shared_ptr<LinSeg> edge1: e){
-            for(std::shared_ptr<LinSeg> edge2: obj.e){
-                if(std::unique_ptr<Point> inter = edge1->intersect(*edge2); inter && typeid(*inter) == typeid(Point)) points.push_back(*inter);
-            }
-        }
+        if(std::abs(other.sign_dist(m.verts[0])) >= 1e-5) return {};
+        return Intersection::clip(m.face(0), obj.mesh().edge_planes.data(), other.size());
     }
-    else{
-        for(std::shared_ptr<LinSeg> edge: e){
-            if(std::unique_ptr<Point> inter = obj.intersect(*edge); inter && typeid(*inter) == typeid(Point)) points.push_back(*inter);
-        }
-        for(std::shared_ptr<LinSeg> edge: obj.e){
-            if(std::unique_ptr<Point> inter = intersect(*edge); inter && typeid(*inter) == typeid(Point)) points.push_back(*inter);
-        }
-    }
-    std::vector<Point> out;
-    std::copy_if(points.begin(), points.end(), std::back_inserter(out), [&out](Point p1){
-        return std::none_of(out.begin(), out.end(), [&p1](Point p2){return p1.equals(p2);});
-    });
-    if(out.size() > 2) return std::make_unique<Polygon>(out);
-    else if(out.size() == 2) return std::make_unique<LinSeg>(out[0], out[1]);
-    else return std::make_unique<Point>(out[0].pos);
+    Intersection cut = section(m.face(0), other);
+    if(!cut) return {};
+    return Intersection::clip(cut[0], cut[cut.size() - 1], obj.mesh().edge_planes.data(), other.size());
 }
 
-std::unique_ptr<Point> Polygon::intersect(const Polyhedron &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    std::vector<Point> points;
-    for(std::shared_ptr<Point> p: v){
-        if(obj.contains(*p)) points.push_back(*p);
-    }
-    for(std::shared_ptr<LinSeg> edge: e){
-        for(std::shared_ptr<Polygon> face: obj.faces){
-            if(std::unique_ptr<Point> inter = edge->intersect(*face); inter && typeid(*inter) == typeid(Point)) points.push_back(*inter);
-        }
-    }
-    for(std::shared_ptr<LinSeg> edge: obj.edges){
-        if(std::unique_ptr<Point> inter = intersect(*edge); inter && typeid(*inter) == typeid(Point)) points.push_back(*inter);
-    }
-    std::vector<Point> out;
-    std::copy_if(points.begin(), points.end(), std::back_inserter(out), [&out](Point p1){
-        return std::none_of(out.begin(), out.end(), [&p1](Point p2){return p1.equals(p2);});
-    });
-    if(out.size() > 2) return std::make_unique<Polygon>(out);
-    else if(out.size() == 2) return std::make_unique<LinSeg>(out[0], out[1]);
-    else return std::make_unique<Point>(out[0].pos);
+Intersection Polygon::intersection(const Polyhedron &obj) const {
+    sync();
+    obj.sync();
+    if(gap(obj) >= 1e-5) return {};
+    return Intersection::clip(m.face(0), obj.mesh().planes.data(), obj.mesh().face_count());
 }
 
 float Polygon::area() const {
+    sync();
     float area = 0;
-    for(std::shared_ptr<LinSeg> edge: e) area += glm::length(glm::cross(edge->vertices[0]->pos - pos, edge->vertices[0]->pos - edge->vertices[1]->pos))/2;
+    for(unsigned int i = 0; i < m.edge_count(); i++) area += glm::length(glm::cross(m.edge(i).a() - pos, m.edge(i).a() - m.edge(i).b()))/2;
     return area;
 }
 
+glm::vec3 Polygon::support(const glm::vec3& dir) const {
+    unsigned int start = 0;
+    return Polygon::support(dir, start);
+}
+
+glm::vec3 Polygon::support(const glm::vec3& dir, unsigned int& start) const {
+    if(!moved.stale){
+        start = m.support(dir, start);
+        return m.verts[start];
+    }
+    std::lock_guard<std::mutex> hold(moved.lock);
+    start = m.support(glm::transpose(glm::mat3(moved.mat))*dir, start);
+    return moved.mat*glm::vec4(m.verts[start], 1.0);
+}
+
+void Polygon::index(){
+    pos = {0, 0, 0};
+    for(std::shared_ptr<Point> p: v) pos += p->pos;
+    pos /= v.size();
+    m.clear();
+    m.verts.reserve(v.size());
+    m.edge_idx.reserve(v.size());
+    std::vector<unsigned int> loop(v.size());
+    for(unsigned int i = 0; i < v.size(); i++){
+        m.verts.push_back(v[i]->pos);
+        m.edge_idx.push_back({i, static_cast<unsigned int>((i + 1)%v.size())});
+        loop[i] = i;
+    }
+    m.add_face(loop);
+    m.update_planes();
+    ext = Extent::around(m.verts.data(), m.verts.size());
+    n = glm::vec3(m.planes[0]);
+    d = m.planes[0].w;
+}
+
+void Polygon::expand(){
+    v.reserve(m.verts.size());
+    for(const glm::vec3& p: m.verts) v.push_back(std::make_shared<Point>(p));
+    e.reserve(v.size());
+    for(unsigned int i = 0; i < v.size(); i++) e.push_back(std::make_shared<LinSeg>(v[i], v[(i+1)%v.size()]));
+}
+
+void Polygon::refresh(){
+    pos = {0, 0, 0};
+    for(unsigned int i = 0; i < v.size(); i++) m.verts[i] = v[i]->pos;
+    for(const glm::vec3& p: m.verts) pos += p;
+    pos /= m.verts.size();
+    if(moved.stale) pos = moved.mat*glm::vec4(pos, 1.0);
+    m.update_planes();
+    ext = Extent::around(m.verts.data(), m.verts.size());
+    n = glm::vec3(m.planes[0]);
+    d = m.planes[0].w;
+}
+
+Extent Polygon::extent() const {
+    if(!moved.stale) return ext;
+    std::lock_guard<std::mutex> hold(moved.lock);
+    return ext.transformed(moved.mat);
+}
+
+Polygon::Polygon(const Polygon& poly): Plane(poly), e(poly.e), m(poly.m), ext(poly.ext), moved(poly.moved) {}
+
 Polygon& Polygon::operator=(const Polygon& poly){
     model = poly.model;
     pos = poly.pos;
     vel = poly.vel;
     v = poly.v;
     e = poly.e;
+    m = poly.m;
+    ext = poly.ext;
+    moved = poly.moved;
+    n = poly.n;
+    d = poly.d;
     return *this;
 }
 
 Polyhedron::Polyhedron(){
-    pos = {0.25, 0.25, 0.25};
-    v = {std::make_shared<Point>(glm::vec3(0, 0, 0)), std::make_shared<Point>(glm::vec3(1, 0, 0)), std::make_shared<Point>(glm::vec3(0, 1, 0)), std::make_shared<Point>(glm::vec3(0, 0, 1))};
-    e = {std::make_shared<LinSeg>(v[0], v[1]), std::make_shared<LinSeg>(v[0], v[2]), std::make_shared<LinSeg>(v[0], v[3]), std::make_shared<LinSeg>(v[1], v[2]), std::make_shared<LinSeg>(v[1], v[3]), std::make_shared<LinSeg>(v[2], v[3])};
-    f = {std::make_shared<Polygon>(v[0], v[3], v[1]), std::make_shared<Polygon>(v[0], v[2], v[3]), std::make_shared<Polygon>(v[0], v[1], v[2]), std::make_shared<Polygon>(v[3], v[2], v[1])};
+    m.verts = {glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(0, 0, 1)};
+    m.edge_idx = {{0, 1}, {0, 2}, {0, 3}, {1, 2}, {1, 3}, {2, 3}};
+    for(const std::vector<unsigned int>& loop: {std::vector<unsigned int>{0, 3, 1}, {0, 2, 3}, {0, 1, 2}, {3, 2, 1}}) m.add_face(loop);
+    index();
 }
 
 Polyhedron::Polyhedron(std::vector<Point> vert){
-    v.reserve(vert.size());
-    std::transform(vert.begin(), vert.end(), std::back_inserter(v), [](Point p){
-        return std::make_shared<Point>(p.pos);
-    });
-    pos = {0, 0, 0};
-    for(std::shared_ptr<Point> p: v) pos += p->pos;
-    pos /= v.size();
-    Point center{pos};
-    std::vector<std::vector<std::shared_ptr<Point>>> points;
-    for(unsigned int i = 3; i <= v.size(); i++){
-        std::vector<std::vector<std::shared_ptr<Point>>> comb = combinations<std::shared_ptr<Point>>(v.begin(), v.end(), i);
-        points.insert(points.end(), comb.begin(), comb.end());
-    }
-    for(std::vector<std::vector<std::shared_ptr<Point>>>::reverse_iterator it = points.rbegin(); it != points.rend(); it++){
-        try{
-            std::shared_ptr<Polygon> face = std::make_shared<Polygon>(*it);
-            if(face->sign_dist(center) < 0){
-                std::swap((*it)[1], (*it)[2]);
-                face = std::make_shared<Polygon>(*it);
-            }
-            bool side = std::all_of(v.begin(), v.end(), [&face](std::shared_ptr<Point> p){
-                return face->sign_dist(*p) >= -1e-5;
-            });
-            bool subface = std::any_of(f.begin(), f.end(), [&face](std::shared_ptr<Polygon> face2){
-                return !face->contains(*face2) && face2->contains(*face);
-            });
-            if(side && !subface) f.push_back(face);
-        }
-        catch(std::invalid_argument){}
-    }
-    if(f.size() == 0) throw std::invalid_argument("Inputs cannot be coplanar");
-    std::vector<std::shared_ptr<LinSeg>> lines;
-    for(std::shared_ptr<Polygon> face: f) lines.insert(lines.end(), face->edges.begin(), face->edges.end());
-    std::copy_if(lines.begin(), lines.end(), std::back_inserter(e), [this](std::shared_ptr<LinSeg> l1){
-        return std::find_if(e.begin(), e.end(), [&l1](std::shared_ptr<LinSeg> l2){return l1->equals(*l2);}) == e.end();
+    std::vector<glm::vec3> points(vert.size());
+    std::transform(vert.begin(), vert.end(), points.begin(), [](const Point& p){
+        return p.pos;
     });
-    if(f.size() + v.size() - e.size() != 2)
-        throw std::invalid_argument("Inputs must define a convex polyhedron");
+    hull(points);
 }
 
 Polyhedron::Polyhedron(std::vector<std::shared_ptr<Point>> vert){
+    std::vector<glm::vec3> points(vert.size());
+    std::transform(vert.begin(), vert.end(), points.begin(), [](std::shared_ptr<Point> p){
+        return p->pos;
+    });
+    hull(points);
     v = vert;
-    pos = {0, 0, 0};
-    for(std::shared_ptr<Point> p: v) pos += p->pos;
-    pos /= v.size();
-    Point center{pos};
-    std::vector<std::vector<std::shared_ptr<Point>>> points;
-    for(unsigned int i = 3; i < v.size(); i++){
-        std::vector<std::vector<std::shared_ptr<Point>>> comb = combinations<std::shared_ptr<Point>>(v.begin(), v.end(), i);
-        points.insert(points.end(), comb.begin(), comb.end());
-    }
-    for(std::vector<std::vector<std::shared_ptr<Point>>>::reverse_iterator it = points.rbegin(); it != points.rend(); it++){
-        try{
-            std::shared_ptr<Polygon> face = std::make_shared<Polygon>(*it);
-            if(face->sign_dist(center) < 0){
-                std::swap((*it)[1], (*it)[2]);
-                face = std::make_shared<Polygon>(*it);
-            }
-            bool side = std::all_of(v.begin(), v.end(), [&face](std::shared_ptr<Point> p){
-                return face->sign_dist(*p) >= -1e-5;
-            });
-            bool subface = std::any_of(f.begin(), f.end(), [&face](std::shared_ptr<Polygon> face2){
-                return !face->contains(*face2) && face2->contains(*face);
-            });
-            if(side && !subface) f.push_back(face);
+    graph();
+}
+
+Polyhedron::Polyhedron(Mesh mesh): m(std::move(mesh)){
+    index();
+}
+
+void Polyhedron::hull(const std::vector<glm::vec3>& points){
+    Hull h;
+    switch(quickhull(points, h)){
+        case HullStatus::Ok: break;
+        case HullStatus::TooFewPoints: throw std::invalid_argument("At least four inputs are required");
+        case HullStatus::Coincident: throw std::invalid_argument("Inputs must have different positions");
+        case HullStatus::Collinear: throw std::invalid_argument("Inputs cannot be collinear");
+        case HullStatus::Coplanar: throw std::invalid_argument("Inputs cannot be coplanar");
+    }
+    if(h.vertices.size() != points.size()) throw std::invalid_argument("Inputs must define a convex polyhedron");
+    m.clear();
+    m.verts = points;
+    std::set<std::pair<unsigned int, unsigned int>> seen;
+    for(const std::vector<unsigned int>& loop: h.faces){
+        m.add_face(loop);
+        for(unsigned int k = 0; k < loop.size(); k++){
+            unsigned int a = loop[k], b = loop[(k + 1)%loop.size()];
+            if(seen.insert(std::minmax(a, b)).second) m.edge_idx.push_back({a, b});
         }
-        catch(std::invalid_argument){}
     }
-    if(f.size() == 0) throw std::invalid_argument("Inputs cannot be coplanar");
-    std::vector<std::shared_ptr<LinSeg>> lines;
-    for(std::shared_ptr<Polygon> face: f) lines.insert(lines.end(), face->edges.begin(), face->edges.end());
-    std::copy_if(lines.begin(), lines.end(), std::back_inserter(e), [this](std::shared_ptr<LinSeg> l1){
-        return std::find_if(e.begin(), e.end(), [&l1](std::shared_ptr<LinSeg> l2){return l1->equals(*l2);}) == e.end();
-    });
-    if(f.size() + v.size() - e.size() != 2) throw std::invalid_argument("Inputs must define a convex polyhedron");
+    if(m.face_count() + m.verts.size() - m.edge_count() != 2) throw std::invalid_argument("Inputs must define a convex polyhedron");
+    index();
+}
+
+void Polyhedron::index(){
+    pos = {0, 0, 0};
+    for(const glm::vec3& p: m.verts) pos += p;
+    pos /= m.verts.size();
+    m.link();
+    m.update_planes();
+    ext = Extent::around(m.verts.data(), m.verts.size());
+}
+
+// The faces and edges come in the order of the mesh, the edges being those of the faces where they run the same way.
+void Polyhedron::graph(){
+    f.reserve(m.face_count());
+    std::map<std::pair<unsigned int, unsigned int>, std::shared_ptr<LinSeg>> sides;
+    std::vector<std::shared_ptr<Point>> loop;
+    for(unsigned int i = 0; i < m.face_count(); i++){
+        Mesh::Face face = m.face(i);
+        loop.resize(face.size());
+        for(unsigned int k = 0; k < face.size(); k++) loop[k] = v[face.index(k)];
+        f.push_back(std::shared_ptr<Polygon>(new Polygon(loop, Polygon::Ordered())));
+        for(unsigned int k = 0; k < face.size(); k++)
+            sides.emplace(std::minmax(face.index(k), face.index((k + 1)%face.size())), f.back()->edges[k]);
+    }
+    e.reserve(m.edge_count());
+    for(const std::array<unsigned int, 2>& edge: m.edge_idx){
+        std::shared_ptr<LinSeg> side = sides.at(std::minmax(edge[0], edge[1]));
+        e.push_back(side->vertices[0] == v[edge[0]] ? side:std::make_shared<LinSeg>(v[edge[0]], v[edge[1]]));
+    }
+}
+
+void Polyhedron::expand(){
+    v.reserve(m.verts.size());
+    for(const glm::vec3& p: m.verts) v.push_back(std::make_shared<Point>(p));
+    graph();
 }
 
 float Polyhedron::dist(const Point &obj) const {
-    bool contained = std::all_of(f.begin(), f.end(), [&obj](std::shared_ptr<Polygon> face){
-        return face->sign_dist(obj) >= 0;
-    });
-    if(contained) return 0;
-    std::vector<float> distances(f.size());
-    std::transform(f.begin(), f.end(), distances.begin(), [&obj](std::shared_ptr<Polygon> face){
-        return face->dist(obj);
-    });
-    return *std::min_element(distances.begin(), distances.end());
+    if(typeid(obj) != typeid(Point)) return obj.dist(*this);
+    sync();
+    return solid_dist(m, obj.pos);
 }
 
 float Polyhedron::dist(const Line &obj) const {
-    std::vector<float> distances(f.size());
-    std::transform(f.begin(), f.end(), distances.begin(), [&obj](std::shared_ptr<Polygon> face){
-        return face->dist(obj);
-    });
-    return *std::min_element(distances.begin(), distances.end());
+    sync();
+    float min = std::numeric_limits<float>::infinity();
+    for(std::shared_ptr<Polygon> face: faces) min = std::min(min, face->dist(obj));
+    return min;
 }
 
 float Polyhedron::dist(const LinSeg &obj) const {
+    sync();
     for(std::shared_ptr<Point> p: obj.vertices) if(contains(*p)) return 0;
-    std::vector<float> distances(f.size());
-    std::transform(f.begin(), f.end(), distances.begin(), [&obj](std::shared_ptr<Polygon> face){
-        return face->dist(obj);
-    });
-    return *std::min_element(distances.begin(), distances.end());
+    float min = std::numeric_limits<float>::infinity();
+    for(std::shared_ptr<Polygon> face: faces) if(face->gap(obj) < min) min = std::min(min, face->dist(obj));
+    return min;
 }
 
 float Polyhedron::dist(const Plane &obj) const {
-    std::vector<float> distances(f.size());
-    std::transform(f.begin(), f.end(), distances.begin(), [&obj](std::shared_ptr<Polygon> face){
-        return face->dist(obj);
-    });
-    return *std::min_element(distances.begin(), distances.end());
+    sync();
+    if(typeid(obj) != typeid(Plane)) return obj.dist(*this);
+    return plane_dist(obj, m.verts.data(), m.verts.size());
 }
 
 
 float Polyhedron::dist(const Polygon &obj) const {
-    for(std::shared_ptr<Point> p: obj.vertices) if(contains(*p)) return 0;
-    std::vector<float> distances(f.size());
-    std::transform(f.begin(), f.end(), distances.begin(), [&obj](std::shared_ptr<Polygon> face){
-        return face->dist(obj);
-    });
-    return *std::min_element(distances.begin(), distances.end());
+    sync();
+    obj.sync();
+    for(const glm::vec3& p: obj.mesh().verts) if(contains(Point(p))) return 0;
+    float min = std::numeric_limits<float>::infinity();
+    for(std::shared_ptr<Polygon> face: faces) if(face->gap(obj) < min) min = std::min(min, face->dist(obj));
+    return min;
 }
 
 
 float Polyhedron::dist(const Polyhedron &obj) const {
-    for(std::shared_ptr<Point> p: obj.vertices) if(contains(*p)) return 0;
-    std::vector<float> distances(f.size());
-    std::transform(f.begin(), f.end(), distances.begin(), [&obj](std::shared_ptr<Polygon> face){
-        return face->dist(obj);
-    });
-    return *std::min_element(distances.begin(), distances.end());
+    sync();
+    obj.sync();
+    for(const glm::vec3& p: obj.mesh().verts) if(contains(Point(p))) return 0;
+    float min = std::numeric_limits<float>::infinity();
+    for(std::shared_ptr<Polygon> face: faces) if(face->gap(obj) < min) min = std::min(min, face->dist(obj));
+    return min;
 }
 
-std::unique_ptr<Point> Polyhedron::intersect(const Point &obj) const {
-    return dist(obj) < 1e-5 ? std::make_unique<Point>(obj.pos):nullptr;
+Intersection Polyhedron::intersection(const Point &obj) const {
+    if(typeid(obj) != typeid(Point)) return obj.intersection(*this);
+    sync();
+    return within(obj, 1e-5) ? Intersection::point(obj.pos):Intersection();
 }
 
-std::unique_ptr<Point> Polyhedron::intersect(const Line &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    std::vector<Point> points;
-    for(std::shared_ptr<Polygon> face: f){
-        if(std::unique_ptr<Point> inter = face->intersect(obj); inter && typeid(*inter) == typeid(Point)) points.push_back(*inter);
+Intersection Polyhedron::intersection(const Line &obj) const {
+    sync();
+    if(!within(obj, 1e-5)) return {};
+    Intersection points;
+    for(std::shared_ptr<Polygon> face: faces){
+        if(Intersection inter = face->intersection(obj); inter.kind() == Intersection::Kind::Point) points.add(inter[0]);
     }
-    std::vector<Point>::iterator it = std::unique(points.begin(), points.end(), [](Point p1, Point p2){
-        return p1.equals(p2);
-    });
-    return std::distance(points.begin(), it) == 1 ? std::make_unique<Point>(points[0]):std::make_unique<LinSeg>(points[0], points[1]);
+    return points.resolve(2);
 }
 
-std::unique_ptr<Point> Polyhedron::intersect(const LinSeg &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    std::vector<Point> points;
-    for(std::shared_ptr<Point> p: obj.vertices)
-        if(contains(*p)) points.push_back(*p);
-    for(std::shared_ptr<Polygon> face: f){
-        if(std::unique_ptr<Point> inter = face->intersect(obj); inter && typeid(*inter) == typeid(Point)) points.push_back(*inter);
-    }
-    std::vector<Point>::iterator it = std::unique(points.begin(), points.end(), [](Point p1, Point p2){
-        return p1.equals(p2);
-    });
-    return std::distance(points.begin(), it) == 1 ? std::make_unique<Point>(points[0]):std::make_unique<LinSeg>(points[0], points[1]);
+Intersection Polyhedron::intersection(const LinSeg &obj) const {
+    sync();
+    if(gap(obj) >= 1e-5) return {};
+    return Intersection::clip(obj.vertices[0]->pos, obj.vertices[1]->pos, m.planes.data(), m.face_count());
 }
 
-std::unique_ptr<Point> Polyhedron::intersect(const Plane &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    std::vector<Point> points;
-    points.reserve(e.size());
-    for(std::shared_ptr<LinSeg> edge: e){
-        if(std::unique_ptr<Point> inter = obj.intersect(*edge); inter && typeid(*inter) == typeid(Point)) points.push_back(*inter);
-    }
-    std::vector<Point> out;
-    out.reserve(points.size());
-    std::copy_if(points.begin(), points.end(), std::back_inserter(out), [&out](Point p1){
-        return std::none_of(out.begin(), out.end(), [&p1](Point p2){return p1.equals(p2);});
-    });
-    if(out.size() > 2) return std::make_unique<Polygon>(out);
-    else if(out.size() == 2) return std::make_unique<LinSeg>(out[0], out[1]);
-    else return std::make_unique<Point>(out[0].pos);
+Intersection Polyhedron::intersection(const Plane &obj) const {
+    sync();
+    if(typeid(obj) != typeid(Plane)) return obj.intersection(*this);
+    if(!within(obj, 1e-5)) return {};
+    return plane_cut(obj, m, ~0u);
 }
 
-std::unique_ptr<Point> Polyhedron::intersect(const Polygon &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    std::vector<Point> points;
-    for(std::shared_ptr<Point> p: obj.vertices){
-        if(contains(*p)) points.push_back(*p);
-    }
-    for(std::shared_ptr<LinSeg> edge: obj.edges){
-        for(std::shared_ptr<Polygon> face: f){
-            if(std::unique_ptr<Point> inter = edge->intersect(*face); inter && typeid(*inter) == typeid(Point)) points.push_back(*inter);
-        }
-    }
-    for(std::shared_ptr<LinSeg> edge: e){
-        if(std::unique_ptr<Point> inter = obj.intersect(*edge); inter && typeid(*inter) == typeid(Point)) points.push_back(*inter);
-    }
-    std::vector<Point> out;
-    std::copy_if(points.begin(), points.end(), std::back_inserter(out), [&out](Point p1){
-        return std::none_of(out.begin(), out.end(), [&p1](Point p2){return p1.equals(p2);});
-    });
-    if(out.size() > 2) return std::make_unique<Polygon>(out);
-    else if(out.size() == 2) return std::make_unique<LinSeg>(out[0], out[1]);
-    else return std::make_unique<Point>(out[0].pos);
+Intersection Polyhedron::intersection(const Polygon &obj) const {
+    sync();
+    obj.sync();
+    if(gap(obj) >= 1e-5) return {};
+    return Intersection::clip(obj.mesh().face(0), m.planes.data(), m.face_count());
 }
 
-std::unique_ptr<Point> Polyhedron::intersect(const Polyhedron &obj) const {
-    if(dist(obj) >= 1e-5) return nullptr;
-    std::vector<Point> points;
-    for(std::shared_ptr<LinSeg> edge: e){
-        for(std::shared_ptr<Polygon> face: obj.f){
-            if(std::unique_ptr<Point> inter = edge->intersect(*face); inter && typeid(*inter) == typeid(Point)) points.push_back(*inter);
+Intersection Polyhedron::intersection(const Polyhedron &obj) const {
+    sync();
+    obj.sync();
+    if(!within(obj, 1e-5)) return {};
+    Intersection points;
+    for(std::shared_ptr<LinSeg> edge: edges){
+        for(std::shared_ptr<Polygon> face: obj.faces){
+            if(Intersection inter = edge->intersection(*face); inter.kind() == Intersection::Kind::Point) points.add(inter[0]);
         }
     }
-    for(std::shared_ptr<LinSeg> edge: obj.e){
-        for(std::shared_ptr<Polygon> face: f){
-            if(std::unique_ptr<Point> inter = edge->intersect(*face); inter && typeid(*inter) == typeid(Point)) points.push_back(*inter);
+    for(std::shared_ptr<LinSeg> edge: obj.edges){
+        for(std::shared_ptr<Polygon> face: faces){
+            if(Intersection inter = edge->intersection(*face); inter.kind() == Intersection::Kind::Point) points.add(inter[0]);
         }
     }
-    for(std::shared_ptr<Point> p: v){
-        if(obj.contains(*p)) points.push_back(*p);
-    }
-    for(std::shared_ptr<Point> p: obj.vertices){
-        if(contains(*p)) points.push_back(*p);
+    for(const glm::vec3& p: m.verts){
+        if(obj.contains(Point(p))) points.add(p);
     }
-    std::vector<Point> out;
-    std::copy_if(points.begin(), points.end(), std::back_inserter(out), [&out](Point p1){
-        return std::none_of(out.begin(), out.end(), [&p1](Point p2){return p1.equals(p2);});
-    });
-    if(out.size() > 2){
-        try{
-            return std::make_unique<Polygon>(out);
-        }
-        catch(std::invalid_argument){
-            return std::make_unique<Polyhedron>(out);
-        }
+    for(const glm::vec3& p: obj.m.verts){
+        if(contains(Point(p))) points.add(p);
     }
-    else if(out.size() == 2) return std::make_unique<LinSeg>(out[0], out[1]);
-    else return std::make_unique<Point>(out[0].pos);
+    return points.resolve(~0u, true);
 }
 
 float Polyhedron::volume() const {
+    sync();
     float vol = 0;
-    for(std::shared_ptr<Polygon> face: f) vol += glm::dot(face->normVec(), pos - face->pos)*face->area()/3;
+    for(unsigned int i = 0; i < m.face_count(); i++){
+        Mesh::Face face = m.face(i);
+        glm::vec3 center(0);
+        for(unsigned int k = 0; k < face.size(); k++) center += face[k];
+        center /= face.size();
+        float area = 0;
+        for(unsigned int k = 0; k < face.size(); k++) area += glm::length(glm::cross(face[k] - center, face[k] - face[(k + 1)%face.size()]))/2;
+        vol += glm::dot(face.normal(), pos - center)*area/3;
+    }
     return vol;
 }
 
+glm::vec3 Polyhedron::support(const glm::vec3& dir) const {
+    unsigned int start = 0;
+    return Polyhedron::support(dir, start);
+}
+
+// The support of a transformed shape is the transformed support in the direction taken back
+// through the transpose, so a pending move costs a matrix product rather than a sync().
+// The lock keeps a sync() on another thread from moving the mesh under the read.
+glm::vec3 Polyhedron::support(const glm::vec3& dir, unsigned int& start) const {
+    if(!moved.stale){
+        start = m.support(dir, start);
+        return m.verts[start];
+    }
+    std::lock_guard<std::mutex> hold(moved.lock);
+    start = m.support(glm::transpose(glm::mat3(moved.mat))*dir, start);
+    return moved.mat*glm::vec4(m.verts[start], 1.0);
+}
+
+void Polyhedron::refresh(){
+    pos = {0, 0, 0};
+    for(unsigned int i = 0; i < v.size(); i++) m.verts[i] = v[i]->pos;
+    for(const glm::vec3& p: m.verts) pos += p;
+    pos /= m.verts.size();
+    if(moved.stale) pos = moved.mat*glm::vec4(pos, 1.0);
+    m.update_planes();
+    ext = Extent::around(m.verts.data(), m.verts.size());
+    for(std::shared_ptr<Polygon> face: f) face->refresh();
+}
+
+Extent Polyhedron::extent() const {
+    if(!moved.stale) return ext;
+    std::lock_guard<std::mutex> hold(moved.lock);
+    return ext.transformed(moved.mat);
+}
+
+Polyhedron::Polyhedron(const Polyhedron& poly): Point(poly), e(poly.e), f(poly.f), m(poly.m), ext(poly.ext), moved(poly.moved) {}
+
 Polyhedron& Polyhedron::operator=(const Polyhedron& poly){
     model = poly.model;
     pos = poly.pos;
@@ -998,5 +1129,8 @@ Polyhedron& Polyhedron::operator=(const Polyhedron& poly){
     v = poly.v;
     e = poly.e;
     f = poly.f;
+    m = poly.m;
+    ext = poly.ext;
+    moved = poly.moved;
     return *this;
 }
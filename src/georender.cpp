@@ -14,6 +14,31 @@ Visual::Visual(){
     glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, IBO);
 }
 
+Visual::Visual(const ShapeTemplate& shape): Visual(){
+    const std::vector<glm::vec3>& verts = shape.mesh().verts;
+    VBO_DATA.resize(STRIDE*verts.size());
+    for(unsigned int i = 0; i < VBO_DATA.size(); i+=STRIDE){
+        VBO_DATA[i + PosX] = verts[i/STRIDE].x;
+        VBO_DATA[i + PosY] = verts[i/STRIDE].y;
+        VBO_DATA[i + PosZ] = verts[i/STRIDE].z;
+        VBO_DATA[i + RED] = 1;
+        VBO_DATA[i + GREEN] = 1;
+        VBO_DATA[i + BLUE] = 1;
+        VBO_DATA[i + ALPHA] = 1;
+        VBO_DATA[i + TexU] = 0;
+        VBO_DATA[i + TexV] = 0;
+    }
+    IBO_DATA = shape.triangles();
+    glBufferData(GL_ARRAY_BUFFER, VBO_DATA.size()*sizeof(float), VBO_DATA.data(), GL_STATIC_DRAW);
+    glEnableVertexAttribArray(0);
+    glEnableVertexAttribArray(1);
+    glEnableVertexAttribArray(2);
+    glVertexAttribPointer(0, 3, GL_FLOAT, false, STRIDE*sizeof(float), nullptr);
+    glVertexAttribPointer(1, 4, GL_FLOAT, false, STRIDE*sizeof(float), reinterpret_cast<void*>(3*sizeof(float)));
+    glVertexAttribPointer(2, 2, GL_FLOAT, false, STRIDE*sizeof(float), reinterpret_cast<void*>(7*sizeof(float)));
+    glBufferData(GL_ELEMENT_ARRAY_BUFFER, IBO_DATA.size()*sizeof(unsigned int), IBO_DATA.data(), GL_STATIC_DRAW);
+}
+
 Visual::Visual(const Visual& obj){
     glGenVertexArrays(1, &VAO);
     glGenBuffers(1, &VBO);
@@ -117,11 +142,11 @@ Surface::Surface(){
 }
 
 Surface::Surface(std::vector<Point> vert): Polygon(vert){
-    VBO_DATA.resize(STRIDE*v.size());
+    VBO_DATA.resize(STRIDE*m.verts.size());
     for(unsigned int i = 0; i < VBO_DATA.size(); i+=STRIDE){
-        VBO_DATA[i + PosX] = v[i/STRIDE]->pos.x;
-        VBO_DATA[i + PosY] = v[i/STRIDE]->pos.y;
-        VBO_DATA[i + PosZ] = v[i/STRIDE]->pos.z;
+        VBO_DATA[i + PosX] = m.verts[i/STRIDE].x;
+        VBO_DATA[i + PosY] = m.verts[i/STRIDE].y;
+        VBO_DATA[i + PosZ] = m.verts[i/STRIDE].z;
         VBO_DATA[i + RED] = 1;
         VBO_DATA[i + GREEN] = 1;
         VBO_DATA[i + BLUE] = 1;
@@ -129,7 +154,7 @@ Surface::Surface(std::vector<Point> vert): Polygon(vert){
         VBO_DATA[i + TexU] = 0;
         VBO_DATA[i + TexV] = 0;
     }
-    IBO_DATA.resize(3*(v.size() - 2));
+    IBO_DATA.resize(3*(m.verts.size() - 2));
     for(unsigned int i = 0; i < IBO_DATA.size(); i+=3){
         IBO_DATA[i] = 0;
         IBO_DATA[i + 1] = i/3 + 1;
@@ -146,9 +171,10 @@ Surface::Surface(std::vector<Point> vert): Polygon(vert){
 }
 
 Polygon Surface::local(){
-    std::vector<Point> vert(v.size());
-    for(unsigned int i = 0; i < v.size(); i++){
-        vert[i].pos = glm::inverse(model)*glm::vec4(v[i]->pos, 1.0);
+    glm::mat4 back = glm::inverse(model)*moved.mat;
+    std::vector<Point> vert(m.verts.size());
+    for(unsigned int i = 0; i < m.verts.size(); i++){
+        vert[i].pos = back*glm::vec4(m.verts[i], 1.0);
     }
     return Polygon(vert);
 }
@@ -173,11 +199,11 @@ Solid::Solid(){
 }
 
 Solid::Solid(std::vector<Point> vert): Polyhedron(vert){
-    VBO_DATA.resize(STRIDE*v.size());
+    VBO_DATA.resize(STRIDE*m.verts.size());
     for(unsigned int i = 0; i < VBO_DATA.size(); i+=STRIDE){
-        VBO_DATA[i + PosX] = v[i/STRIDE]->pos.x;
-        VBO_DATA[i + PosY] = v[i/STRIDE]->pos.y;
-        VBO_DATA[i + PosZ] = v[i/STRIDE]->pos.z;
+        VBO_DATA[i + PosX] = m.verts[i/STRIDE].x;
+        VBO_DATA[i + PosY] = m.verts[i/STRIDE].y;
+        VBO_DATA[i + PosZ] = m.verts[i/STRIDE].z;
         VBO_DATA[i + RED] = 1;
         VBO_DATA[i + GREEN] = 1;
         VBO_DATA[i + BLUE] = 1;
@@ -186,25 +212,17 @@ Solid::Solid(std::vector<Point> vert): Polyhedron(vert){
         VBO_DATA[i + TexV] = 0;
     }
     size_t indices = 0;
-    for(std::shared_ptr<Polygon> face: f){
-        indices += 3*(face->vertices.size() - 2);
+    for(unsigned int i = 0; i < m.face_count(); i++){
+        indices += 3*(m.face(i).size() - 2);
     }
     IBO_DATA.resize(indices);
     int j = 0;
-    for(std::shared_ptr<Polygon> face: f){
-        for(unsigned int i = 0; i < (face->vertices.size() - 2); i++){
-            std::vector<std::shared_ptr<Point>>::iterator it1 = std::find_if(v.begin(), v.end(), [&face, i](std::shared_ptr<Point> p){
-                return face->vertices[0]->equals(*p);
-            });
-            std::vector<std::shared_ptr<Point>>::iterator it2 = std::find_if(v.begin(), v.end(), [&face, i](std::shared_ptr<Point> p){
-                return face->vertices[i + 1]->equals(*p);
-            });
-            std::vector<std::shared_ptr<Point>>::iterator it3 = std::find_if(v.begin(), v.end(), [&face, i](std::shared_ptr<Point> p){
-                return face->vertices[i + 2]->equals(*p);
-            });
-            IBO_DATA[j++] = static_cast<unsigned int>(std::distance(v.begin(), it1));
-            IBO_DATA[j++] = static_cast<unsigned int>(std::distance(v.begin(), it2));
-            IBO_DATA[j++] = static_cast<unsigned int>(std::distance(v.begin(), it3));
+    for(unsigned int i = 0; i < m.face_count(); i++){
+        Mesh::Face face = m.face(i);
+        for(unsigned int k = 0; k < (face.size() - 2); k++){
+            IBO_DATA[j++] = face.index(0);
+            IBO_DATA[j++] = face.index(k + 1);
+            IBO_DATA[j++] = face.index(k + 2);
         }
     }
     glBufferData(GL_ARRAY_BUFFER, VBO_DATA.size()*sizeof(float), VBO_DATA.data(), GL_STATIC_DRAW);
@@ -218,9 +236,10 @@ Solid::Solid(std::vector<Point> vert): Polyhedron(vert){
 }
 
 Polyhedron Solid::local(){
-    std::vector<Point> vert(v.size());
-    for(unsigned int i = 0; i < v.size(); i++){
-        vert[i].pos = glm::inverse(model)*glm::vec4(v[i]->pos, 1.0);
+    glm::mat4 back = glm::inverse(model)*moved.mat;
+    std::vector<Point> vert(m.verts.size());
+    for(unsigned int i = 0; i < m.verts.size(); i++){
+        vert[i].pos = back*glm::vec4(m.verts[i], 1.0);
     }
     return Polyhedron(vert);
 }
@@ -0,0 +1,282 @@
+#include "Graphics/gjk.hpp"
+#include <vector>
+#include <limits>
+#include <algorithm>
+#include <glm/geometric.hpp>
+#include <glm/gtx/norm.hpp>
+#include "Graphics/geometry.hpp"
+#include "Graphics/hull.hpp"
+
+using namespace gmh;
+
+namespace {
+    /**
+     * Vertex of the Minkowski difference obj1 - obj2, along with the
+     * support points and direction it came from.
+     */
+    struct SVert {
+        glm::vec3 w, a, b, d;
+    };
+
+    struct Sub {
+        unsigned int n;
+        std::array<unsigned int, 4> idx;
+        std::array<float, 4> l;
+        glm::vec3 v;
+    };
+
+    struct Simp {
+        std::array<SVert, 4> v;
+        std::array<float, 4> l;
+        unsigned int n = 0;
+    };
+
+    /**
+     * Support vertex of (obj1 + o1) - (obj2 + o2), for shapes translated
+     * by o1 and o2 without moving them.
+     */
+    inline SVert support(const Point& obj1, const Point& obj2, const glm::vec3& d, std::array<unsigned int, 2>& start,
+                         const glm::vec3& o1 = glm::vec3(0), const glm::vec3& o2 = glm::vec3(0)){
+        glm::vec3 a = obj1.support(d, start[0]) + o1;
+        glm::vec3 b = obj2.support(-d, start[1]) + o2;
+        return {a - b, a, b, d};
+    }
+
+    Sub segment(const Simp& s, unsigned int i, unsigned int j){
+        const glm::vec3& a = s.v[i].w;
+        glm::vec3 ab = s.v[j].w - a;
+        float len = glm::length2(ab);
+        float t = len > 0 ? glm::dot(-a, ab)/len : 0;
+        if(t <= 0) return {1, {i}, {1}, a};
+        if(t >= 1) return {1, {j}, {1}, s.v[j].w};
+        return {2, {i, j}, {1 - t, t}, a + t*ab};
+    }
+
+    Sub triangle(const Simp& s, unsigned int i, unsigned int j, unsigned int k){
+        const glm::vec3& a = s.v[i].w;
+        const glm::vec3& b = s.v[j].w;
+        const glm::vec3& c = s.v[k].w;
+        glm::vec3 ab = b - a, ac = c - a;
+        float d1 = glm::dot(ab, -a), d2 = glm::dot(ac, -a);
+        if(d1 <= 0 && d2 <= 0) return {1, {i}, {1}, a};
+        float d3 = glm::dot(ab, -b), d4 = glm::dot(ac, -b);
+        if(d3 >= 0 && d4 <= d3) return {1, {j}, {1}, b};
+        float vc = d1*d4 - d3*d2;
+        if(vc <= 0 && d1 >= 0 && d3 <= 0) return segment(s, i, j);
+        float d5 = glm::dot(ab, -c), d6 = glm::dot(ac, -c);
+        if(d6 >= 0 && d5 <= d6) return {1, {k}, {1}, c};
+        float vb = d5*d2 - d1*d6;
+        if(vb <= 0 && d2 >= 0 && d6 <= 0) return segment(s, i, k);
+        float va = d3*d6 - d5*d4;
+        if(va <= 0 && d4 - d3 >= 0 && d5 - d6 >= 0) return segment(s, j, k);
+        float sum = va + vb + vc;
+        if(sum <= std::numeric_limits<float>::min()){
+            Sub best = segment(s, i, j);
+            for(Sub other: {segment(s, i, k), segment(s, j, k)})
+                if(glm::length2(other.v) < glm::length2(best.v)) best = other;
+            return best;
+        }
+        float v = vb/sum, w = vc/sum;
+        return {3, {i, j, k}, {1 - v - w, v, w}, a + v*ab + w*ac};
+    }
+
+    Sub tetrahedron(const Simp& s){
+        static const unsigned int faces[4][4] = {{0, 1, 2, 3}, {0, 3, 1, 2}, {0, 2, 3, 1}, {1, 3, 2, 0}};
+        Sub best{0, {}, {}, glm::vec3(std::numeric_limits<float>::infinity())};
+        bool inside = true;
+        for(const unsigned int* f: faces){
+            const glm::vec3& a = s.v[f[0]].w;
+            glm::vec3 n = glm::cross(s.v[f[1]].w - a, s.v[f[2]].w - a);
+            float side = glm::dot(n, s.v[f[3]].w - a);
+            float origin = glm::dot(n, -a);
+            if(std::abs(side) > 1e-12f && origin*side >= 0) continue;
+            inside = false;
+            Sub sub = triangle(s, f[0], f[1], f[2]);
+            if(glm::length2(sub.v) < glm::length2(best.v)) best = sub;
+        }
+        if(inside) return {4, {0, 1, 2, 3}, {}, glm::vec3(0)};
+        return best;
+    }
+
+    /**
+     * Closest point of the simplex to the origin.
+     *
+     * Reduces the simplex to the smallest subset containing that point
+     * and stores its barycentric coordinates in s.l.
+     */
+    glm::vec3 closest(Simp& s){
+        Sub sub;
+        switch(s.n){
+            case 1: sub = {1, {0}, {1}, s.v[0].w}; break;
+            case 2: sub = segment(s, 0, 1); break;
+            case 3: sub = triangle(s, 0, 1, 2); break;
+            default: sub = tetrahedron(s); break;
+        }
+        if(sub.n == 4) return sub.v;
+        std::array<SVert, 4> kept;
+        for(unsigned int i = 0; i < sub.n; i++){
+            kept[i] = s.v[sub.idx[i]];
+            s.l[i] = sub.l[i];
+        }
+        s.v = kept;
+        s.n = sub.n;
+        return sub.v;
+    }
+
+    struct EPAFace {
+        std::array<unsigned int, 3> i;
+        glm::vec3 n;
+        float d;
+        bool alive;
+    };
+
+    EPAFace make_face(const std::vector<SVert>& verts, unsigned int a, unsigned int b, unsigned int c){
+        glm::vec3 n = glm::cross(verts[b].w - verts[a].w, verts[c].w - verts[a].w);
+        float len = glm::length(n);
+        if(len > 0) n /= len;
+        return {{a, b, c}, n, glm::dot(n, verts[a].w), true};
+    }
+
+    Separation distance(const Point& obj1, const glm::vec3& o1, const Point& obj2, const glm::vec3& o2, Simplex* cache){
+        Simp s;
+        std::array<unsigned int, 2> start = cache ? cache->start : std::array<unsigned int, 2>{};
+        if(cache && cache->size > 0){
+            for(unsigned int i = 0; i < cache->size; i++) s.v[s.n++] = support(obj1, obj2, cache->dir[i], start, o1, o2);
+        }
+        else{
+            glm::vec3 d = obj2.pos + o2 - obj1.pos - o1;
+            s.v[s.n++] = support(obj1, obj2, glm::length2(d) > 0 ? d : glm::vec3(1, 0, 0), start, o1, o2);
+        }
+        glm::vec3 v = closest(s);
+        for(unsigned int iter = 0; iter < 64 && s.n < 4; iter++){
+            float vv = glm::length2(v);
+            if(vv < 1e-12f) break;
+            SVert w = support(obj1, obj2, -v, start, o1, o2);
+            if(vv - glm::dot(v, w.w) <= 1e-6f*vv) break;
+            if(std::any_of(s.v.begin(), s.v.begin() + s.n, [&w](const SVert& p){return p.w == w.w;})) break;
+            s.v[s.n++] = w;
+            v = closest(s);
+        }
+        if(cache){
+            cache->start = start;
+            cache->size = s.n;
+            for(unsigned int i = 0; i < s.n; i++) cache->dir[i] = s.v[i].d;
+        }
+        Separation out{0, glm::vec3(0), glm::vec3(0)};
+        if(s.n == 4 || glm::length2(v) < 1e-12f) return out;
+        for(unsigned int i = 0; i < s.n; i++){
+            out.p1 += s.l[i]*s.v[i].a;
+            out.p2 += s.l[i]*s.v[i].b;
+        }
+        out.dist = glm::length(v);
+        return out;
+    }
+}
+
+Separation gmh::gjk(const Point& obj1, const Point& obj2, Simplex* cache){
+    return distance(obj1, glm::vec3(0), obj2, glm::vec3(0), cache);
+}
+
+bool gmh::epa(const Point& obj1, const Point& obj2, Penetration& out){
+    Simplex cache;
+    if(gjk(obj1, obj2, &cache).dist > 0) return false;
+    std::vector<SVert> verts;
+    std::vector<EPAFace> faces;
+    for(unsigned int i = 0; i < cache.size; i++) verts.push_back(support(obj1, obj2, cache.dir[i], cache.start));
+    if(verts.size() == 4){
+        faces = {make_face(verts, 0, 1, 2), make_face(verts, 0, 3, 1), make_face(verts, 0, 2, 3), make_face(verts, 1, 3, 2)};
+        if(glm::dot(faces[0].n, verts[3].w - verts[0].w) > 0)
+            for(EPAFace& face: faces) face = make_face(verts, face.i[0], face.i[2], face.i[1]);
+    }
+    else{
+        static const glm::vec3 dirs[14] = {
+            {1, 0, 0}, {-1, 0, 0}, {0, 1, 0}, {0, -1, 0}, {0, 0, 1}, {0, 0, -1},
+            {1, 1, 1}, {1, 1, -1}, {1, -1, 1}, {1, -1, -1}, {-1, 1, 1}, {-1, 1, -1}, {-1, -1, 1}, {-1, -1, -1}
+        };
+        for(const glm::vec3& d: dirs) verts.push_back(support(obj1, obj2, d, cache.start));
+        std::vector<glm::vec3> points(verts.size());
+        std::transform(verts.begin(), verts.end(), points.begin(), [](const SVert& p){return p.w;});
+        Hull h;
+        if(quickhull(points, h, 1e-7f) != HullStatus::Ok) return false;
+        for(const std::vector<unsigned int>& loop: h.faces)
+            for(unsigned int k = 1; k + 1 < loop.size(); k++)
+                faces.push_back(make_face(verts, loop[0], loop[k + 1], loop[k]));
+    }
+    auto nearest = [&faces](){
+        unsigned int best = 0;
+        float min = std::numeric_limits<float>::infinity();
+        for(unsigned int f = 0; f < faces.size(); f++){
+            if(faces[f].alive && faces[f].d < min){
+                min = faces[f].d;
+                best = f;
+            }
+        }
+        return best;
+    };
+    std::vector<std::pair<unsigned int, unsigned int>> horizon;
+    for(unsigned int iter = 0; iter < 64; iter++){
+        unsigned int best = nearest();
+        SVert w = support(obj1, obj2, faces[best].n, cache.start);
+        if(glm::dot(w.w, faces[best].n) - faces[best].d < 1e-5f) break;
+        verts.push_back(w);
+        unsigned int apex = static_cast<unsigned int>(verts.size() - 1);
+        horizon.clear();
+        for(EPAFace& face: faces){
+            if(!face.alive || glm::dot(face.n, w.w - verts[face.i[0]].w) <= 0) continue;
+            face.alive = false;
+            for(unsigned int j = 0; j < 3; j++){
+                std::pair<unsigned int, unsigned int> edge(face.i[j], face.i[(j + 1)%3]);
+                auto twin = std::find(horizon.begin(), horizon.end(), std::make_pair(edge.second, edge.first));
+                if(twin != horizon.end()) horizon.erase(twin);
+                else horizon.push_back(edge);
+            }
+        }
+        for(const std::pair<unsigned int, unsigned int>& edge: horizon)
+            faces.push_back(make_face(verts, edge.first, edge.second, apex));
+    }
+    // Picked again, since if the loop ran out its last expansion removed the face it started from.
+    const EPAFace& face = faces[nearest()];
+    const SVert& a = verts[face.i[0]];
+    const SVert& b = verts[face.i[1]];
+    const SVert& c = verts[face.i[2]];
+    glm::vec3 p = face.n*face.d;
+    glm::vec3 ab = b.w - a.w, ac = c.w - a.w, ap = p - a.w;
+    float d00 = glm::dot(ab, ab), d01 = glm::dot(ab, ac), d11 = glm::dot(ac, ac);
+    float d20 = glm::dot(ap, ab), d21 = glm::dot(ap, ac);
+    float denom = d00*d11 - d01*d01;
+    float lb = denom != 0 ? (d11*d20 - d01*d21)/denom : 0;
+    float lc = denom != 0 ? (d00*d21 - d01*d20)/denom : 0;
+    float la = 1 - lb - lc;
+    out.depth = face.d;
+    out.normal = face.n;
+    out.p1 = la*a.a + lb*b.a + lc*c.a;
+    out.p2 = la*a.b + lb*b.b + lc*c.b;
+    return true;
+}
+
+bool gmh::toi(const Point& obj1, const glm::vec3& d1, const Point& obj2, const glm::vec3& d2, Impact& out, float tolerance){
+    return toi(obj1, glm::vec3(0), d1, obj2, glm::vec3(0), d2, out, tolerance);
+}
+
+bool gmh::toi(const Point& obj1, const glm::vec3& s1, const glm::vec3& d1, const Point& obj2, const glm::vec3& s2, const glm::vec3& d2, Impact& out, float tolerance){
+    glm::vec3 r = d2 - d1;
+    glm::vec3 n = obj2.pos + s2 - obj1.pos - s1;
+    if(glm::length2(n) > 0) n = glm::normalize(n);
+    Simplex cache;
+    float t = 0;
+    for(unsigned int iter = 0; iter < 32; iter++){
+        Separation sep = distance(obj1, s1 + t*d1, obj2, s2 + t*d2, &cache);
+        if(sep.dist > 0) n = (sep.p2 - sep.p1)/sep.dist;
+        if(sep.dist <= tolerance){
+            out = {t, n, sep.p1, sep.p2};
+            return true;
+        }
+        // The shapes are at least sep.dist apart along n and close that
+        // gap at no more than the relative speed along n.
+        float closing = -glm::dot(r, n);
+        if(closing <= 0) return false;
+        t += (sep.dist - 0.5f*tolerance)/closing;
+        if(t > 1) return false;
+    }
+    return false;
+}
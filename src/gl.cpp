@@ -16,6 +16,8 @@
 #include "Graphics/texture.hpp"
 #include "Graphics/camera.hpp"
 #include "Graphics/collision.hpp"
+#include "Graphics/world.hpp"
+#include "Graphics/query.hpp"
 #include "Graphics/text.hpp"
 #include "Graphics/window.hpp"
 #include "Graphics/model.hpp"
@@ -30,17 +32,24 @@ int main(void){
     });
     float dt{};
     gmh::Camera cam{glm::vec3(0.0f, 2.0f, 5.0f), glm::vec3(0.0f, 1.0f, 0.0f), glm::radians(-90.f), glm::radians(-15.f)};
-    gmh::CHandler chandle(1);
+    gmh::PhysicsWorld world(1/60.f, 1);
     gmh::TextInput& textInp = gmh::TextInput::get();
     gmh::Window win(480, 480, "Gael's App");
     win.bind();
     win.setIcon(PROJECT_DIR "/res/textures/emoji.png");
     enableDebug();
     gmh::InputHandler inpHandle;
-    inpHandle.set_cursor_pos([&win, &cam](double x, double y){
+    gmh::SceneQuery scene;
+    const gmh::Point* picked = nullptr;
+    inpHandle.set_cursor_pos([&win, &cam, &world, &scene, &picked](double x, double y){
         if(glfwGetMouseButton(win.handle(), GLFW_MOUSE_BUTTON_LEFT) == GLFW_PRESS){
             cam.rotate((float)(xpos - x), (float)(y - ypos));
         }
+        else{
+            world.materialize();
+            scene.refit();
+            picked = scene.raycast(cam.pos, cam.through(x, y, win.width, win.height)).shape;
+        }
         xpos = x;
         ypos = y;
     });
@@ -100,22 +109,22 @@ int main(void){
     sol.tex_coord(3, 0, 1);
     sol.tex_coord(4, 0.5, 0.5);
     sol.reload();
-    inpHandle.bind_key(GLFW_KEY_UP, [&sol](int mods){sol.vel += glm::vec3(0, 3, 0);}, [&sol](int mods){sol.vel = glm::vec3(0, 0, 0);});
-    inpHandle.bind_key(GLFW_KEY_DOWN, [&sol](int mods){sol.vel += glm::vec3(0, -3, 0);}, [&sol](int mods){sol.vel = glm::vec3(0, 0, 0);});
-    inpHandle.bind_key(GLFW_KEY_LEFT, [&sol](int mods){sol.vel += glm::vec3(-3, 0, 0);}, [&sol](int mods){sol.vel = glm::vec3(0, 0, 0);});
-    inpHandle.bind_key(GLFW_KEY_RIGHT, [&sol](int mods){sol.vel += glm::vec3(3, 0, 0);}, [&sol](int mods){sol.vel = glm::vec3(0, 0, 0);});
-    inpHandle.bind_key(GLFW_KEY_Z, [&sol](int mods){sol.vel += glm::vec3(0, 0, 3);}, [&sol](int mods){sol.vel = glm::vec3(0, 0, 0);});
-    inpHandle.bind_key(GLFW_KEY_X, [&sol](int mods){sol.vel += glm::vec3(0, 0, -3);}, [&sol](int mods){sol.vel = glm::vec3(0, 0, 0);});
-    inpHandle.bind_key(GLFW_KEY_SPACE, [&sol](int mods){sol.vel += glm::vec3(0, 0, 0);}, [&sol](int mods){sol.vel = glm::vec3(0, 0, 0);});
+    inpHandle.bind_key(GLFW_KEY_UP, [&sol, &world](int mods){world.velocity(world.id(&sol), sol.vel + glm::vec3(0, 3, 0));}, [&sol, &world](int mods){world.velocity(world.id(&sol), glm::vec3(0, 0, 0));});
+    inpHandle.bind_key(GLFW_KEY_DOWN, [&sol, &world](int mods){world.velocity(world.id(&sol), sol.vel + glm::vec3(0, -3, 0));}, [&sol, &world](int mods){world.velocity(world.id(&sol), glm::vec3(0, 0, 0));});
+    inpHandle.bind_key(GLFW_KEY_LEFT, [&sol, &world](int mods){world.velocity(world.id(&sol), sol.vel + glm::vec3(-3, 0, 0));}, [&sol, &world](int mods){world.velocity(world.id(&sol), glm::vec3(0, 0, 0));});
+    inpHandle.bind_key(GLFW_KEY_RIGHT, [&sol, &world](int mods){world.velocity(world.id(&sol), sol.vel + glm::vec3(3, 0, 0));}, [&sol, &world](int mods){world.velocity(world.id(&sol), glm::vec3(0, 0, 0));});
+    inpHandle.bind_key(GLFW_KEY_Z, [&sol, &world](int mods){world.velocity(world.id(&sol), sol.vel + glm::vec3(0, 0, 3));}, [&sol, &world](int mods){world.velocity(world.id(&sol), glm::vec3(0, 0, 0));});
+    inpHandle.bind_key(GLFW_KEY_X, [&sol, &world](int mods){world.velocity(world.id(&sol), sol.vel + glm::vec3(0, 0, -3));}, [&sol, &world](int mods){world.velocity(world.id(&sol), glm::vec3(0, 0, 0));});
+    inpHandle.bind_key(GLFW_KEY_SPACE, [&sol, &world](int mods){world.velocity(world.id(&sol), sol.vel + glm::vec3(0, 0, 0));}, [&sol, &world](int mods){world.velocity(world.id(&sol), glm::vec3(0, 0, 0));});
     // inpHandle.bind_key(GLFW_KEY_C, [&s1](int mods){s1.transform(glm::translate(glm::mat4(1), glm::vec3(0, 0.01, 0)));}, [](int mods){});
 
-    gmh::Physical p1{&s1, 1, true};
-    chandle.add(p1);
-    chandle.add(&sol, 1);
-    chandle.add(&slope, 5);
+    world.add(&s1, 1, true);
+    world.add(&sol, 1);
+    world.add(&slope, 5);
+    scene.build({&s1, &sol, &slope});
 
 
-    // chandle.remove(&s1);
+    // world.remove(world.id(&s1));
     // std::cout << sol.volume() << std::endl;
     std::string str = "This is text";
     glClearColor(1, 1, 1, 1);
@@ -138,7 +147,7 @@ int main(void){
     textInp.bind(win);
     while (win.isOpen()){
         win.clear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-        chandle();
+        world.update(dt);
 
         ImGui_ImplOpenGL3_NewFrame();
         ImGui_ImplGlfw_NewFrame();
@@ -148,6 +157,7 @@ int main(void){
         ImGui::ColorPicker3("Text Color", glm::value_ptr(tcolor));
         if(ImGui::Button("Bind text")) textInp.bind(win);
         if(ImGui::Button("Bind motion")) inpHandle.bind(win);
+        ImGui::Text("Under cursor: %s", picked == &sol ? "solid" : picked == &slope ? "slope" : picked == &s1 ? "floor" : "nothing");
         ImGui::End();
 
 
@@ -158,16 +168,16 @@ int main(void){
         program.bind();
         program.SetUniformMatrixf<4, 4>("view", glm::value_ptr(cam.view()));
         program.SetUniformMatrixf<4, 4>("projection", glm::value_ptr(project));
-        program.SetUniformMatrixf<4, 4>("model", sol.model_ptr());
+        program.SetUniformMatrixf<4, 4>("model", glm::value_ptr(world.model(world.id(&sol))));
 
         sol.bind();
         sol.render();
 
-        program.SetUniformMatrixf<4, 4>("model", slope.model_ptr());
+        program.SetUniformMatrixf<4, 4>("model", glm::value_ptr(world.model(world.id(&slope))));
         slope.bind();
         slope.render();
 
-        program.SetUniformMatrixf<4, 4>("model", s1.model_ptr());
+        program.SetUniformMatrixf<4, 4>("model", glm::value_ptr(world.model(world.id(&s1))));
         s1.bind();
         s1.render();
 
@@ -183,7 +193,6 @@ int main(void){
         // font.render("Extra text", 190, 300, 1, tcolor);
         gmh::Font::unbind();
         cam.update(dt);
-        sol.update(dt);
         // s1.update(dt);
         // slope.update(dt);
 
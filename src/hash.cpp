@@ -1,21 +1,25 @@
 #include "Graphics/hash.hpp"
 #include "Graphics/geometry.hpp"
-#include "Graphics/collision.hpp"
 
 using namespace gmh;
 
+// Polygons and Polyhedra are hashed from their mesh, which holds the vertices in the same order,
+// so hashing one does not build its shared_ptr vertices.
 size_t std::hash<Point>::operator()(const Point& p) const {
+    const Mesh* mesh = nullptr;
+    if(const Polygon* poly = dynamic_cast<const Polygon*>(&p)) mesh = &poly->mesh();
+    else if(const Polyhedron* poly = dynamic_cast<const Polyhedron*>(&p)) mesh = &poly->mesh();
     size_t seed = std::hash<glm::vec3>()(p.pos) ^ std::hash<const char*>()(typeid(p).name());
+    if(mesh){
+        for(const glm::vec3& vert: mesh->verts) seed ^= std::hash<glm::vec3>()(vert);
+        return seed;
+    }
     for(std::shared_ptr<Point> ptr: p.vertices){
         seed ^= std::hash<glm::vec3>()(ptr->pos);
     }
     return seed;
 }
 
-size_t std::hash<Physical>::operator()(const Physical& p) const {
-    return std::hash<Point>()(*p.obj);
-}
-
 namespace gmh {
     bool operator==(const Point& p1, const Point& p2){
         std::hash<Point> h;
@@ -26,9 +30,4 @@ namespace gmh {
         std::hash<Point> h;
         return h(p1) != h(p2);
     }
-
-    bool operator==(const Physical& p1, const Physical& p2){
-        std::hash<Physical> h;
-        return h(p1) == h(p2);
-    }
 }
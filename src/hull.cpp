@@ -0,0 +1,257 @@
+#include "Graphics/hull.hpp"
+#include <array>
+#include <tuple>
+#include <numeric>
+#include <algorithm>
+#include <glm/geometric.hpp>
+#include <glm/gtx/norm.hpp>
+
+using namespace gmh;
+
+namespace {
+    /**
+     * Triangle of the hull under construction.
+     *
+     * adj[j] is the face across the edge v[j] -> v[(j+1)%3].
+     * Vertices are wound counterclockwise seen from outside.
+     */
+    struct HullFace {
+        std::array<unsigned int, 3> v;
+        std::array<unsigned int, 3> adj;
+        glm::vec3 n;
+        float d;
+        std::vector<unsigned int> outside;
+        unsigned int mark;
+        bool alive;
+    };
+
+    class QuickHull {
+        const std::vector<glm::vec3>& p;
+        const float eps;
+        std::vector<HullFace> faces;
+        unsigned int pass = 0;
+
+        unsigned int add_face(unsigned int a, unsigned int b, unsigned int c){
+            glm::vec3 n = glm::cross(p[b] - p[a], p[c] - p[a]);
+            float len = glm::length(n);
+            if(len > 0) n /= len;
+            faces.push_back({{a, b, c}, {0, 0, 0}, n, glm::dot(n, p[a]), {}, 0, true});
+            return static_cast<unsigned int>(faces.size() - 1);
+        }
+
+        void link(unsigned int f, unsigned int a, unsigned int b, unsigned int other){
+            for(unsigned int j = 0; j < 3; j++){
+                if(faces[f].v[j] == a && faces[f].v[(j + 1)%3] == b){
+                    faces[f].adj[j] = other;
+                    return;
+                }
+            }
+        }
+
+        inline float height(const HullFace& face, unsigned int i) const {
+            return glm::dot(face.n, p[i]) - face.d;
+        }
+
+        void assign(const std::vector<unsigned int>& pts, const std::vector<unsigned int>& targets){
+            for(unsigned int i: pts){
+                for(unsigned int t: targets){
+                    if(height(faces[t], i) > eps){
+                        faces[t].outside.push_back(i);
+                        break;
+                    }
+                }
+            }
+        }
+
+        void add_point(unsigned int seed){
+            const HullFace& s = faces[seed];
+            unsigned int apex = *std::max_element(s.outside.begin(), s.outside.end(), [this, &s](unsigned int a, unsigned int b){
+                return height(s, a) < height(s, b);
+            });
+            std::vector<unsigned int> visible{seed};
+            faces[seed].mark = ++pass;
+            for(unsigned int i = 0; i < visible.size(); i++){
+                for(unsigned int adj: faces[visible[i]].adj){
+                    if(faces[adj].mark == pass || height(faces[adj], apex) <= eps) continue;
+                    faces[adj].mark = pass;
+                    visible.push_back(adj);
+                }
+            }
+            std::vector<std::tuple<unsigned int, unsigned int, unsigned int>> horizon;
+            std::vector<unsigned int> orphans;
+            for(unsigned int f: visible){
+                HullFace& face = faces[f];
+                for(unsigned int j = 0; j < 3; j++)
+                    if(faces[face.adj[j]].mark != pass) horizon.emplace_back(face.v[j], face.v[(j + 1)%3], face.adj[j]);
+                for(unsigned int i: face.outside) if(i != apex) orphans.push_back(i);
+                face.alive = false;
+                face.outside.clear();
+                face.outside.shrink_to_fit();
+            }
+            std::vector<unsigned int> created;
+            created.reserve(horizon.size());
+            for(const std::tuple<unsigned int, unsigned int, unsigned int>& edge: horizon){
+                unsigned int a = std::get<0>(edge), b = std::get<1>(edge), other = std::get<2>(edge);
+                unsigned int f = add_face(a, b, apex);
+                faces[f].adj[0] = other;
+                link(other, b, a, f);
+                created.push_back(f);
+            }
+            for(unsigned int f: created){
+                for(unsigned int g: created){
+                    if(faces[g].v[0] != faces[f].v[1]) continue;
+                    faces[f].adj[1] = g;
+                    faces[g].adj[2] = f;
+                    break;
+                }
+            }
+            assign(orphans, created);
+        }
+
+        void merge(Hull& out){
+            std::vector<unsigned int> group(faces.size());
+            std::iota(group.begin(), group.end(), 0);
+            auto find = [&group](unsigned int i){
+                while(group[i] != i) i = group[i] = group[group[i]];
+                return i;
+            };
+            for(unsigned int f = 0; f < faces.size(); f++){
+                if(!faces[f].alive) continue;
+                for(unsigned int j = 0; j < 3; j++){
+                    unsigned int adj = faces[f].adj[j];
+                    if(adj < f) continue;
+                    unsigned int far_f = faces[f].v[(j + 2)%3];
+                    unsigned int far_adj = faces[adj].v[0] + faces[adj].v[1] + faces[adj].v[2] - faces[f].v[j] - faces[f].v[(j + 1)%3];
+                    if(std::abs(height(faces[f], far_adj)) <= eps && std::abs(height(faces[adj], far_f)) <= eps)
+                        group[find(adj)] = find(f);
+                }
+            }
+            std::vector<bool> used(p.size(), false);
+            std::vector<std::tuple<unsigned int, unsigned int, unsigned int>> boundary;
+            std::vector<std::pair<unsigned int, unsigned int>> members;
+            for(unsigned int f = 0; f < faces.size(); f++){
+                if(!faces[f].alive) continue;
+                const HullFace& face = faces[f];
+                for(unsigned int i: face.v) used[i] = true;
+                unsigned int root = find(f);
+                if(root == f && std::all_of(face.adj.begin(), face.adj.end(), [&find, f](unsigned int adj){return find(adj) != f;})){
+                    out.faces.push_back({face.v[0], face.v[2], face.v[1]});
+                    continue;
+                }
+                members.emplace_back(root, f);
+                for(unsigned int j = 0; j < 3; j++)
+                    if(find(face.adj[j]) != root) boundary.emplace_back(root, face.v[(j + 1)%3], face.v[j]);
+            }
+            std::sort(boundary.begin(), boundary.end());
+            std::sort(members.begin(), members.end());
+            for(auto first = boundary.begin(); first != boundary.end();){
+                auto last = std::find_if(first, boundary.end(), [first](const std::tuple<unsigned int, unsigned int, unsigned int>& edge){
+                    return std::get<0>(edge) != std::get<0>(*first);
+                });
+                unsigned int root = std::get<0>(*first);
+                size_t count = std::distance(first, last);
+                std::vector<unsigned int> loop;
+                loop.reserve(count);
+                unsigned int cur = std::get<1>(*first);
+                bool closed = false;
+                do {
+                    loop.push_back(cur);
+                    auto next = std::lower_bound(first, last, std::make_tuple(root, cur, 0u));
+                    if(next == last || std::get<1>(*next) != cur) break;
+                    cur = std::get<2>(*next);
+                    closed = cur == std::get<1>(*first);
+                } while(!closed && loop.size() < count);
+                // A boundary that does not form one simple loop (pinched by
+                // near coplanar merging) keeps its triangles unmerged.
+                if(closed && loop.size() == count)
+                    out.faces.push_back(std::move(loop));
+                else{
+                    auto member = std::lower_bound(members.begin(), members.end(), std::make_pair(root, 0u));
+                    for(; member != members.end() && member->first == root; ++member){
+                        const HullFace& face = faces[member->second];
+                        out.faces.push_back({face.v[0], face.v[2], face.v[1]});
+                    }
+                }
+                first = last;
+            }
+            for(unsigned int i = 0; i < p.size(); i++) if(used[i]) out.vertices.push_back(i);
+        }
+
+        public:
+            QuickHull(const std::vector<glm::vec3>& points, float eps): p(points), eps(eps) {}
+
+            HullStatus build(Hull& out){
+                out.vertices.clear();
+                out.faces.clear();
+                if(p.size() < 4) return HullStatus::TooFewPoints;
+                std::array<unsigned int, 6> extremes{};
+                for(unsigned int i = 1; i < p.size(); i++){
+                    for(int axis = 0; axis < 3; axis++){
+                        if(p[i][axis] < p[extremes[2*axis]][axis]) extremes[2*axis] = i;
+                        if(p[i][axis] > p[extremes[2*axis + 1]][axis]) extremes[2*axis + 1] = i;
+                    }
+                }
+                unsigned int i0 = extremes[0], i1 = extremes[1];
+                float best = 0;
+                for(unsigned int a: extremes) for(unsigned int b: extremes){
+                    float d = glm::distance2(p[a], p[b]);
+                    if(d > best){
+                        best = d;
+                        i0 = a;
+                        i1 = b;
+                    }
+                }
+                if(best < eps*eps) return HullStatus::Coincident;
+                glm::vec3 dir = glm::normalize(p[i1] - p[i0]);
+                unsigned int i2 = i0;
+                best = 0;
+                for(unsigned int i = 0; i < p.size(); i++){
+                    float d = glm::length2(glm::cross(p[i] - p[i0], dir));
+                    if(d > best){
+                        best = d;
+                        i2 = i;
+                    }
+                }
+                if(best < eps*eps) return HullStatus::Collinear;
+                glm::vec3 n = glm::normalize(glm::cross(p[i1] - p[i0], p[i2] - p[i0]));
+                unsigned int i3 = i0;
+                best = 0;
+                for(unsigned int i = 0; i < p.size(); i++){
+                    float d = std::abs(glm::dot(n, p[i] - p[i0]));
+                    if(d > best){
+                        best = d;
+                        i3 = i;
+                    }
+                }
+                if(best < eps) return HullStatus::Coplanar;
+                if(glm::dot(n, p[i3] - p[i0]) > 0) std::swap(i1, i2);
+                faces.reserve(4*p.size());
+                std::vector<unsigned int> initial{add_face(i0, i1, i2), add_face(i0, i3, i1), add_face(i1, i3, i2), add_face(i2, i3, i0)};
+                faces[0].adj = {1, 2, 3};
+                faces[1].adj = {3, 2, 0};
+                faces[2].adj = {1, 3, 0};
+                faces[3].adj = {2, 1, 0};
+                std::vector<unsigned int> rest;
+                rest.reserve(p.size());
+                for(unsigned int i = 0; i < p.size(); i++)
+                    if(i != i0 && i != i1 && i != i2 && i != i3) rest.push_back(i);
+                assign(rest, initial);
+                std::vector<unsigned int> pending(initial);
+                while(!pending.empty()){
+                    unsigned int f = pending.back();
+                    pending.pop_back();
+                    if(!faces[f].alive || faces[f].outside.empty()) continue;
+                    size_t before = faces.size();
+                    add_point(f);
+                    for(size_t i = before; i < faces.size(); i++)
+                        if(!faces[i].outside.empty()) pending.push_back(static_cast<unsigned int>(i));
+                }
+                merge(out);
+                return HullStatus::Ok;
+            }
+    };
+}
+
+HullStatus gmh::quickhull(const std::vector<glm::vec3>& points, Hull& out, float eps){
+    return QuickHull(points, eps).build(out);
+}
@@ -0,0 +1,271 @@
+#include "Graphics/instance.hpp"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <typeinfo>
+#include <glm/geometric.hpp>
+#include <glm/matrix.hpp>
+#include "Graphics/gjk.hpp"
+
+using namespace gmh;
+
+ShapeTemplate::ShapeTemplate(const Polyhedron& hull): m(hull.mesh()){
+    ext = Extent::around(m.verts.data(), m.verts.size());
+    for(unsigned int i = 0; i < m.face_count(); i++){
+        Mesh::Face face = m.face(i);
+        for(unsigned int k = 1; k + 1 < face.size(); k++){
+            tris.push_back(face.index(0));
+            tris.push_back(face.index(k));
+            tris.push_back(face.index(k + 1));
+        }
+    }
+    // Sum over the tetrahedra joining each triangle to a point inside. Measured from that point,
+    // a tetrahedron of edges a, b, c has volume det/6 and second moment det/120*(aa' + bb' + cc' + ss'), s = a + b + c.
+    glm::vec3 o(0);
+    for(const glm::vec3& p: m.verts) o += p;
+    o /= static_cast<float>(m.verts.size());
+    float six = 0;
+    glm::vec3 first(0);
+    glm::mat3 second(0);
+    for(unsigned int i = 0; i < tris.size(); i += 3){
+        glm::vec3 a = m.verts[tris[i]] - o, b = m.verts[tris[i + 1]] - o, c = m.verts[tris[i + 2]] - o;
+        float det = glm::dot(a, glm::cross(b, c));
+        glm::vec3 s = a + b + c;
+        six += det;
+        first += det*s;
+        second += (det/120)*(glm::outerProduct(a, a) + glm::outerProduct(b, b) + glm::outerProduct(c, c) + glm::outerProduct(s, s));
+    }
+    // The winding of the faces decides the sign of every determinant alike.
+    if(six < 0){
+        six = -six;
+        first = -first;
+        second = -1.0f*second;
+    }
+    vol = six/6;
+    glm::vec3 shift = first/(4*six);
+    center = o + shift;
+    covariance = second - vol*glm::outerProduct(shift, shift);
+}
+
+std::shared_ptr<const ShapeTemplate> ShapeTemplate::make(const std::vector<glm::vec3>& points){
+    return std::shared_ptr<const ShapeTemplate>(new ShapeTemplate(Polyhedron(std::vector<Point>(points.begin(), points.end()))));
+}
+
+glm::mat3 ShapeTemplate::inertia(float density) const {
+    float trace = covariance[0][0] + covariance[1][1] + covariance[2][2];
+    return density*(trace*glm::mat3(1) - covariance);
+}
+
+Instance::Instance(std::shared_ptr<const ShapeTemplate> shape, const glm::mat4& model): geom(std::move(shape)){
+    if(!geom) throw std::invalid_argument("Instance needs a template");
+    this->model = model;
+    pos = model*glm::vec4(geom->centroid(), 1.0);
+}
+
+// Other shapes hand an Instance back to the overload for their own type, so the type of obj is
+// resolved here rather than by asking obj, which for a Point subclass of no known kind would not end.
+float Instance::dist(const Point &obj) const {
+    if(typeid(obj) == typeid(Point)) return gjk(*this, obj).dist;
+    else if(const Instance* inst = dynamic_cast<const Instance*>(&obj)) return dist(*inst);
+    else if(const Polyhedron* solid = dynamic_cast<const Polyhedron*>(&obj)) return dist(*solid);
+    else if(const Polygon* poly = dynamic_cast<const Polygon*>(&obj)) return dist(*poly);
+    else if(const Plane* plane = dynamic_cast<const Plane*>(&obj)) return dist(*plane);
+    else if(const LinSeg* seg = dynamic_cast<const LinSeg*>(&obj)) return dist(*seg);
+    else if(const Line* line = dynamic_cast<const Line*>(&obj)) return dist(*line);
+    return gjk(*this, obj).dist;
+}
+
+// Apart from the line, the hull is nearest it along one of its edges, as seen down the line,
+// so the distance is the least over the edges with their components along the line taken out.
+float Instance::dist(const Line &obj) const {
+    const Mesh& local = geom->mesh();
+    glm::vec3 a = obj.vertices[0]->pos, b = obj.vertices[1]->pos;
+    glm::mat4 back = glm::inverse(model);
+    if(Intersection::clip_line(back*glm::vec4(a, 1.0), back*glm::vec4(b, 1.0), local.planes.data(), local.face_count())) return 0;
+    glm::vec3 dir = glm::normalize(b - a);
+    float min = std::numeric_limits<float>::infinity();
+    for(unsigned int i = 0; i < local.edge_count(); i++){
+        glm::vec3 p = glm::vec3(model*glm::vec4(local.edge(i).a(), 1.0)) - a;
+        glm::vec3 q = glm::vec3(model*glm::vec4(local.edge(i).b(), 1.0)) - a;
+        p -= glm::dot(p, dir)*dir;
+        q -= glm::dot(q, dir)*dir;
+        glm::vec3 e = q - p;
+        float t = glm::dot(e, e) > 0 ? std::clamp(-glm::dot(p, e)/glm::dot(e, e), 0.0f, 1.0f):0.0f;
+        min = std::min(min, glm::length(p + t*e));
+    }
+    return min;
+}
+
+float Instance::dist(const LinSeg &obj) const {
+    return gjk(*this, obj).dist;
+}
+
+float Instance::dist(const Plane &obj) const {
+    if(const Polygon* poly = dynamic_cast<const Polygon*>(&obj)) return dist(*poly);
+    glm::vec3 n = obj.normVec();
+    float above = obj.sign_dist(Point(support(n))), below = obj.sign_dist(Point(support(-n)));
+    if(below <= 0 && above >= 0) return 0;
+    return std::min(std::abs(above), std::abs(below));
+}
+
+float Instance::dist(const Polygon &obj) const {
+    return gjk(*this, obj).dist;
+}
+
+float Instance::dist(const Polyhedron &obj) const {
+    return gjk(*this, obj).dist;
+}
+
+float Instance::dist(const Instance &obj) const {
+    return gjk(*this, obj).dist;
+}
+
+// Add to points the ends of the edges of from, taken to the model space of to by mat, that lie in
+// the hull of to, brought to the world by place. Every corner of the overlap of two convex hulls
+// is a vertex of one inside the other or where an edge of one crosses a face of the other, so
+// clipping the edges of each to the other finds them all.
+static void clip_edges(const Mesh& from, const glm::mat4& mat, const Mesh& to, const glm::mat4& place, Intersection& points){
+    for(unsigned int i = 0; i < from.edge_count(); i++){
+        Intersection inter = Intersection::clip(mat*glm::vec4(from.edge(i).a(), 1.0), mat*glm::vec4(from.edge(i).b(), 1.0), to.planes.data(), to.face_count());
+        for(const glm::vec3& p: inter.transform(place)) points.add(p);
+    }
+}
+
+// The template keeps its planes in model space, so the other shape is taken there by the inverse
+// model matrix and the result brought back, without building the hull in the world. Tolerances
+// are those of model space, the same as in the world for a placement without scaling.
+Intersection Instance::intersection(const Point &obj) const {
+    if(typeid(obj) == typeid(Point)) return within(obj, 1e-5) ? Intersection::point(obj.pos):Intersection();
+    else if(const Instance* inst = dynamic_cast<const Instance*>(&obj)) return intersection(*inst);
+    else if(const Polyhedron* solid = dynamic_cast<const Polyhedron*>(&obj)) return intersection(*solid);
+    else if(const Polygon* poly = dynamic_cast<const Polygon*>(&obj)) return intersection(*poly);
+    else if(const Plane* plane = dynamic_cast<const Plane*>(&obj)) return intersection(*plane);
+    else if(const LinSeg* seg = dynamic_cast<const LinSeg*>(&obj)) return intersection(*seg);
+    else if(const Line* line = dynamic_cast<const Line*>(&obj)) return intersection(*line);
+    return within(obj, 1e-5) ? Intersection::point(obj.pos):Intersection();
+}
+
+Intersection Instance::intersection(const Line &obj) const {
+    const Mesh& local = geom->mesh();
+    glm::mat4 back = glm::inverse(model);
+    return Intersection::clip_line(back*glm::vec4(obj.vertices[0]->pos, 1.0), back*glm::vec4(obj.vertices[1]->pos, 1.0), local.planes.data(), local.face_count()).transform(model);
+}
+
+Intersection Instance::intersection(const LinSeg &obj) const {
+    if(gap(obj) >= 1e-5) return {};
+    const Mesh& local = geom->mesh();
+    glm::mat4 back = glm::inverse(model);
+    return Intersection::clip(back*glm::vec4(obj.vertices[0]->pos, 1.0), back*glm::vec4(obj.vertices[1]->pos, 1.0), local.planes.data(), local.face_count()).transform(model);
+}
+
+// Where the edges of the hull cross the plane, as Plane::intersection(const Polyhedron&) finds them on a mesh.
+Intersection Instance::intersection(const Plane &obj) const {
+    if(const Polygon* poly = dynamic_cast<const Polygon*>(&obj)) return intersection(*poly);
+    if(!within(obj, 1e-5)) return {};
+    const Mesh& local = geom->mesh();
+    Intersection points;
+    for(unsigned int i = 0; i < local.edge_count(); i++){
+        glm::vec3 a = model*glm::vec4(local.edge(i).a(), 1.0), b = model*glm::vec4(local.edge(i).b(), 1.0);
+        float sa = obj.sign_dist(Point(a)), sb = obj.sign_dist(Point(b));
+        if(std::abs(sa) < 1e-5 && std::abs(sb) < 1e-5) continue;
+        if(std::min(std::abs(sa), std::abs(sb)) >= 1e-5 && (sa > 0) == (sb > 0)) continue;
+        points.add(a + (b - a)*std::clamp(sa/(sa - sb), 0.0f, 1.0f));
+    }
+    return points.resolve();
+}
+
+Intersection Instance::intersection(const Polygon &obj) const {
+    if(gap(obj) >= 1e-5) return {};
+    const Mesh& local = geom->mesh();
+    return Intersection::clip(obj.mesh().face(0), glm::inverse(model), local.planes.data(), local.face_count()).transform(model);
+}
+
+Intersection Instance::intersection(const Polyhedron &obj) const {
+    if(gap(obj) >= 1e-5) return {};
+    const Mesh& local = geom->mesh();
+    const Mesh& other = obj.mesh();
+    Intersection points;
+    clip_edges(local, model, other, glm::mat4(1), points);
+    clip_edges(other, glm::inverse(model), local, model, points);
+    return points.resolve(~0u, true);
+}
+
+Intersection Instance::intersection(const Instance &obj) const {
+    if(gap(obj) >= 1e-5) return {};
+    Intersection points;
+    clip_edges(geom->mesh(), glm::inverse(obj.model)*model, obj.geom->mesh(), obj.model, points);
+    clip_edges(obj.geom->mesh(), glm::inverse(model)*obj.model, geom->mesh(), model, points);
+    return points.resolve(~0u, true);
+}
+
+glm::vec3 Instance::support(const glm::vec3& dir) const {
+    unsigned int start = 0;
+    return support(dir, start);
+}
+
+glm::vec3 Instance::support(const glm::vec3& dir, unsigned int& start) const {
+    const Mesh& local = geom->mesh();
+    start = local.support(glm::transpose(glm::mat3(model))*dir, start);
+    return model*glm::vec4(local.verts[start], 1.0);
+}
+
+void Instance::world(Mesh& out) const {
+    out = geom->mesh();
+    for(glm::vec3& p: out.verts) p = model*glm::vec4(p, 1.0);
+    out.update_planes();
+}
+
+Polyhedron Instance::polyhedron() const {
+    Mesh out;
+    world(out);
+    return Polyhedron(std::move(out));
+}
+
+bool Instance::inside(const Point &obj) const {
+    for(const glm::vec3& p: geom->mesh().verts) if(obj.dist(Point(model*glm::vec4(p, 1.0))) >= 1e-5) return false;
+    return true;
+}
+
+InstanceArray::InstanceArray(std::shared_ptr<const ShapeTemplate> shape): geom(std::move(shape)){
+    if(!geom) throw std::invalid_argument("InstanceArray needs a template");
+}
+
+size_t InstanceArray::add(const glm::mat4& model, const glm::vec3& vel){
+    basis.emplace_back(model);
+    origin.emplace_back(model[3]);
+    speed.push_back(vel);
+    return origin.size() - 1;
+}
+
+void InstanceArray::reserve(size_t count){
+    basis.reserve(count);
+    origin.reserve(count);
+    speed.reserve(count);
+}
+
+glm::mat4 InstanceArray::placement(size_t i) const {
+    glm::mat4 model(basis[i]);
+    model[3] = glm::vec4(origin[i], 1.0);
+    return model;
+}
+
+void InstanceArray::update(float dt){
+    for(size_t i = 0; i < origin.size(); i++) origin[i] += dt*speed[i];
+}
+
+Instance InstanceArray::instance(size_t i) const {
+    Instance obj(geom, placement(i));
+    obj.vel = speed[i];
+    return obj;
+}
+
+void InstanceArray::store(size_t i, const Instance& obj){
+    basis[i] = glm::mat3(obj.placement());
+    origin[i] = obj.placement()[3];
+    speed[i] = obj.vel;
+}
+
+size_t InstanceArray::footprint() const {
+    return sizeof(InstanceArray) + basis.capacity()*sizeof(glm::mat3) + origin.capacity()*sizeof(glm::vec3) + speed.capacity()*sizeof(glm::vec3);
+}
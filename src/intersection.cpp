@@ -0,0 +1,216 @@
+#include "Graphics/intersection.hpp"
+#include <cmath>
+#include <algorithm>
+#include <limits>
+#include <glm/geometric.hpp>
+#include <glm/gtx/norm.hpp>
+#include <glm/gtc/constants.hpp>
+#include "Graphics/geometry.hpp"
+
+using namespace gmh;
+
+Intersection Intersection::point(const glm::vec3& p){
+    Intersection out;
+    out.push(p);
+    out.k = Kind::Point;
+    return out;
+}
+
+Intersection Intersection::segment(const glm::vec3& a, const glm::vec3& b){
+    Intersection out;
+    out.push(a);
+    out.push(b);
+    out.k = Kind::Segment;
+    return out;
+}
+
+Intersection Intersection::line(const glm::vec3& a, const glm::vec3& b){
+    Intersection out = segment(a, b);
+    out.k = Kind::Line;
+    return out;
+}
+
+Intersection Intersection::plane(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c){
+    Intersection out;
+    out.push(a);
+    out.push(b);
+    out.push(c);
+    out.k = Kind::Plane;
+    return out;
+}
+
+Intersection Intersection::polygon(const Mesh::Face& face){
+    Intersection out;
+    for(unsigned int k = 0; k < face.size(); k++) out.push(face[k]);
+    out.k = Kind::Polygon;
+    return out;
+}
+
+void Intersection::push(const glm::vec3& p){
+    if(spill.empty() && n < capacity){
+        local[n++] = p;
+        return;
+    }
+    if(spill.empty()) spill.assign(local.begin(), local.begin() + n);
+    spill.resize(n);
+    spill.push_back(p);
+    n++;
+}
+
+void Intersection::add(const glm::vec3& p){
+    if(std::none_of(begin(), end(), [&p](const glm::vec3& q){return glm::distance(p, q) < 1e-5;})) push(p);
+}
+
+Intersection Intersection::clip(const Mesh::Face& face, const glm::vec4* planes, unsigned int count){
+    Intersection in;
+    for(unsigned int k = 0; k < face.size(); k++) in.push(face[k]);
+    return cut(std::move(in), planes, count);
+}
+
+Intersection Intersection::clip(const Mesh::Face& face, const glm::mat4& mat, const glm::vec4* planes, unsigned int count){
+    Intersection in;
+    for(unsigned int k = 0; k < face.size(); k++) in.push(mat*glm::vec4(face[k], 1.0));
+    return cut(std::move(in), planes, count);
+}
+
+Intersection Intersection::cut(Intersection in, const glm::vec4* planes, unsigned int count){
+    Intersection out;
+    for(unsigned int j = 0; j < count && in.n > 0; j++){
+        glm::vec3 normal(planes[j]);
+        out.n = 0;
+        out.spill.clear();
+        for(unsigned int i = 0; i < in.n; i++){
+            const glm::vec3& p = in[i];
+            const glm::vec3& q = in[(i + 1)%in.n];
+            float sp = glm::dot(normal, p) - planes[j].w;
+            float sq = glm::dot(normal, q) - planes[j].w;
+            if(sp >= -1e-5) out.push(p);
+            // Points within 1e-5 of the plane are kept as they are, so only strict crossings add a point.
+            if((sp > 1e-5 && sq < -1e-5 || sp < -1e-5 && sq > 1e-5) && !(in.n == 2 && i == 1)) out.push(p + (q - p)*(sp/(sp - sq)));
+        }
+        std::swap(in, out);
+    }
+    if(!in.collapse()) in.k = in.n == 0 ? Kind::Empty : in.n == 1 ? Kind::Point : in.n == 2 ? Kind::Segment : Kind::Polygon;
+    return in;
+}
+
+Intersection Intersection::clip(const glm::vec3& a, const glm::vec3& b, const glm::vec4* planes, unsigned int count){
+    float t0 = 0, t1 = 1;
+    for(unsigned int j = 0; j < count; j++){
+        float sa = glm::dot(glm::vec3(planes[j]), a) - planes[j].w;
+        float sb = glm::dot(glm::vec3(planes[j]), b) - planes[j].w;
+        if(sa < -1e-5 && sb < -1e-5) return {};
+        else if(sa < -1e-5) t0 = std::max(t0, sb > 1e-5 ? sa/(sa - sb):1.0f);
+        else if(sb < -1e-5) t1 = std::min(t1, sa > 1e-5 ? sa/(sa - sb):0.0f);
+        if(t0 > t1) return {};
+    }
+    glm::vec3 p0 = a + (b - a)*t0, p1 = a + (b - a)*t1;
+    return glm::distance(p0, p1) < 1e-5 ? point(p0):segment(p0, p1);
+}
+
+// Parameters are in units of length along the line, so the 1e-5 tolerances are distances as elsewhere.
+Intersection Intersection::clip_line(const glm::vec3& a, const glm::vec3& b, const glm::vec4* planes, unsigned int count){
+    glm::vec3 dir = glm::normalize(b - a);
+    float t0 = -std::numeric_limits<float>::infinity(), t1 = std::numeric_limits<float>::infinity();
+    for(unsigned int j = 0; j < count; j++){
+        float s = glm::dot(glm::vec3(planes[j]), a) - planes[j].w;
+        float rate = glm::dot(glm::vec3(planes[j]), dir);
+        // A line parallel to the plane is on one side of it all along.
+        if(std::abs(rate) < 1e-6){
+            if(s < -1e-5) return {};
+            continue;
+        }
+        if(rate > 0) t0 = std::max(t0, -s/rate);
+        else t1 = std::min(t1, -s/rate);
+        if(t0 > t1 + 1e-5) return {};
+    }
+    if(!std::isfinite(t0) || !std::isfinite(t1)) return line(a, b);
+    if(t0 > t1) return point(a + dir*(0.5f*(t0 + t1)));
+    glm::vec3 p0 = a + dir*t0, p1 = a + dir*t1;
+    return glm::distance(p0, p1) < 1e-5 ? point(p0):segment(p0, p1);
+}
+
+Intersection& Intersection::transform(const glm::mat4& mat){
+    glm::vec3* p = spill.empty() ? local.data() : spill.data();
+    for(unsigned int i = 0; i < n; i++) p[i] = mat*glm::vec4(p[i], 1.0);
+    return *this;
+}
+
+bool Intersection::collapse(){
+    if(n < 2) return false;
+    glm::vec3* p = spill.empty() ? local.data() : spill.data();
+    float far = 0;
+    unsigned int far_i = 0;
+    for(unsigned int i = 1; i < n; i++){
+        float d = glm::distance(p[0], p[i]);
+        if(d > far){
+            far = d;
+            far_i = i;
+        }
+    }
+    if(far < 1e-5){
+        n = 1;
+        k = Kind::Point;
+        return true;
+    }
+    glm::vec3 dir = (p[far_i] - p[0])/far;
+    for(unsigned int i = 1; i < n; i++)
+        if(glm::length(glm::cross(dir, p[i] - p[0])) >= 1e-5) return false;
+    auto [lo, hi] = std::minmax_element(p, p + n, [&p, &dir](const glm::vec3& a, const glm::vec3& b){
+        return glm::dot(a - p[0], dir) < glm::dot(b - p[0], dir);
+    });
+    glm::vec3 a = *lo, b = *hi;
+    p[0] = a;
+    p[1] = b;
+    n = 2;
+    k = Kind::Segment;
+    return true;
+}
+
+Intersection& Intersection::resolve(unsigned int max, bool solid){
+    n = std::min(n, max);
+    if(n < 3){
+        k = n == 0 ? Kind::Empty : n == 1 ? Kind::Point : Kind::Segment;
+        return *this;
+    }
+    if(collapse()) return *this;
+    glm::vec3* p = spill.empty() ? local.data() : spill.data();
+    const glm::vec3* far = std::max_element(p, p + n, [&p](const glm::vec3& a, const glm::vec3& b){
+        return glm::distance2(a, p[0]) < glm::distance2(b, p[0]);
+    });
+    glm::vec3 normal(0);
+    for(unsigned int i = 1; i < n; i++){
+        glm::vec3 c = glm::cross(*far - p[0], p[i] - p[0]);
+        if(glm::length2(c) > glm::length2(normal)) normal = c;
+    }
+    normal = glm::normalize(normal);
+    bool planar = std::all_of(p, p + n, [&p, &normal](const glm::vec3& q){return std::abs(glm::dot(normal, q - p[0])) < 1e-5;});
+    if(solid && !planar){
+        k = Kind::Polyhedron;
+        return *this;
+    }
+    glm::vec3 center(0);
+    for(unsigned int i = 0; i < n; i++) center += p[i];
+    center /= static_cast<float>(n);
+    glm::vec3 u = glm::normalize(p[0] - center);
+    glm::vec3 w = glm::cross(normal, u);
+    std::sort(p, p + n, [&center, &u, &w](const glm::vec3& a, const glm::vec3& b){
+        float ta = std::atan2(glm::dot(a - center, w), glm::dot(a - center, u));
+        float tb = std::atan2(glm::dot(b - center, w), glm::dot(b - center, u));
+        return (ta < 0 ? ta + 2*glm::pi<float>() : ta) < (tb < 0 ? tb + 2*glm::pi<float>() : tb);
+    });
+    k = Kind::Polygon;
+    return *this;
+}
+
+std::unique_ptr<Point> Intersection::object() const {
+    switch(k){
+        case Kind::Point: return std::make_unique<Point>((*this)[0]);
+        case Kind::Segment: return std::make_unique<LinSeg>(Point((*this)[0]), Point((*this)[1]));
+        case Kind::Line: return std::make_unique<Line>(Point((*this)[0]), Point((*this)[1]));
+        case Kind::Plane: return std::make_unique<Plane>(Point((*this)[0]), Point((*this)[1]), Point((*this)[2]));
+        case Kind::Polygon: return std::make_unique<Polygon>(std::vector<Point>(begin(), end()));
+        case Kind::Polyhedron: return std::make_unique<Polyhedron>(std::vector<Point>(begin(), end()));
+        default: return nullptr;
+    }
+}
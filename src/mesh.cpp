@@ -0,0 +1,137 @@
+#include "Graphics/mesh.hpp"
+#include <limits>
+#include <algorithm>
+#include <unordered_map>
+#include <glm/geometric.hpp>
+#include <glm/gtx/norm.hpp>
+
+using namespace gmh;
+
+static inline float seg_dist(const glm::vec3& p, const glm::vec3& a, const glm::vec3& b){
+    glm::vec3 ab = b - a;
+    float t = glm::clamp(glm::dot(p - a, ab)/glm::length2(ab), 0.0f, 1.0f);
+    return glm::distance(p, a + t*ab);
+}
+
+float Mesh::Edge::dist(const glm::vec3& p) const {
+    return seg_dist(p, a(), b());
+}
+
+float Mesh::Face::dist(const glm::vec3& p) const {
+    if(inside(p)) return std::abs(sign_dist(p));
+    unsigned int count = size();
+    float min = std::numeric_limits<float>::infinity();
+    for(unsigned int j = 0; j < count; j++)
+        min = std::min(min, seg_dist(p, (*this)[j], (*this)[(j + 1)%count]));
+    return min;
+}
+
+void Mesh::clear(){
+    verts.clear();
+    edge_idx.clear();
+    face_idx.clear();
+    face_start.assign(1, 0);
+    planes.clear();
+    edge_planes.clear();
+    half.clear();
+    vert_half.clear();
+    edge_half.clear();
+}
+
+void Mesh::add_face(const std::vector<unsigned int>& loop){
+    face_idx.insert(face_idx.end(), loop.begin(), loop.end());
+    face_start.push_back(static_cast<unsigned int>(face_idx.size()));
+}
+
+void Mesh::update_planes(){
+    planes.resize(face_count());
+    edge_planes.resize(face_idx.size());
+    for(unsigned int i = 0; i < face_count(); i++){
+        Face face(this, i);
+        glm::vec3 n = glm::normalize(glm::cross(face[1] - face[0], face[2] - face[0]));
+        planes[i] = glm::vec4(n, glm::dot(n, face[0]));
+        unsigned int count = face.size();
+        for(unsigned int k = 0; k < count; k++){
+            const glm::vec3& a = face[k];
+            glm::vec3 inward = glm::normalize(glm::cross(n, face[(k + 1)%count] - a));
+            edge_planes[face_start[i] + k] = glm::vec4(inward, glm::dot(inward, a));
+        }
+    }
+}
+
+static inline unsigned long long pair_key(unsigned int a, unsigned int b){
+    return static_cast<unsigned long long>(a) << 32 | b;
+}
+
+bool Mesh::link(){
+    half.resize(face_idx.size());
+    vert_half.assign(verts.size(), none);
+    edge_half.assign(edge_idx.size(), none);
+    std::unordered_map<unsigned long long, unsigned int> edges;
+    edges.reserve(edge_idx.size());
+    for(unsigned int i = 0; i < edge_count(); i++)
+        edges[pair_key(std::min(edge_idx[i][0], edge_idx[i][1]), std::max(edge_idx[i][0], edge_idx[i][1]))] = i;
+    std::unordered_map<unsigned long long, unsigned int> open;
+    open.reserve(face_idx.size());
+    unsigned int unmatched = 0;
+    for(unsigned int i = 0; i < face_count(); i++){
+        unsigned int start = face_start[i], count = face_start[i + 1] - start;
+        for(unsigned int k = 0; k < count; k++){
+            unsigned int h = start + k, next = start + (k + 1)%count;
+            unsigned int a = face_idx[h], b = face_idx[next];
+            auto edge = edges.find(pair_key(std::min(a, b), std::max(a, b)));
+            half[h] = {a, none, next, i, edge == edges.end() ? none:edge->second};
+            if(vert_half[a] == none) vert_half[a] = h;
+            if(half[h].edge != none && edge_half[half[h].edge] == none) edge_half[half[h].edge] = h;
+            if(auto twin = open.find(pair_key(b, a)); twin != open.end()){
+                half[h].twin = twin->second;
+                half[twin->second].twin = h;
+                open.erase(twin);
+                unmatched--;
+            }
+            else{
+                open[pair_key(a, b)] = h;
+                unmatched++;
+            }
+        }
+    }
+    return unmatched == 0;
+}
+
+std::array<unsigned int, 2> Mesh::edge_faces(unsigned int i) const {
+    unsigned int h = edge_half[i];
+    return {half[h].face, half[h].twin == none ? none:half[half[h].twin].face};
+}
+
+unsigned int Mesh::support(const glm::vec3& dir, unsigned int start) const {
+    unsigned int best = start < verts.size() ? start:0;
+    float max = glm::dot(verts[best], dir);
+    if(!linked()){
+        for(unsigned int i = 0; i < verts.size(); i++){
+            float d = glm::dot(verts[i], dir);
+            if(d > max){
+                max = d;
+                best = i;
+            }
+        }
+        return best;
+    }
+    for(unsigned int current = none; current != best;){
+        current = best;
+        vertex_ring(current, [this, &dir, &max, &best](unsigned int v){
+            float d = glm::dot(verts[v], dir);
+            if(d > max){
+                max = d;
+                best = v;
+            }
+        });
+    }
+    return best;
+}
+
+size_t Mesh::footprint() const {
+    return sizeof(Mesh) + verts.capacity()*sizeof(glm::vec3) + edge_idx.capacity()*sizeof(edge_idx[0]) +
+        face_idx.capacity()*sizeof(unsigned int) + face_start.capacity()*sizeof(unsigned int) +
+        (planes.capacity() + edge_planes.capacity())*sizeof(glm::vec4) + half.capacity()*sizeof(HalfEdge) +
+        (vert_half.capacity() + edge_half.capacity())*sizeof(unsigned int);
+}
@@ -0,0 +1,375 @@
+#include "Graphics/query.hpp"
+#include <cmath>
+#include <array>
+#include <numeric>
+#include <algorithm>
+#include <glm/geometric.hpp>
+#include <glm/matrix.hpp>
+
+using namespace gmh;
+
+static constexpr float inf = std::numeric_limits<float>::infinity();
+/** Bins along each axis when looking for a split. */
+static constexpr unsigned int bin_count = 12;
+/** Leaves are made at this depth whatever they hold, so traversal stacks have a fixed size. */
+static constexpr unsigned int max_depth = 48;
+/** Largest leaf made when splitting would not pay off by the surface area heuristic. */
+static constexpr unsigned int max_leaf = 8;
+
+static inline const Point* object(const Shape& obj){
+    return std::visit([](auto* x) -> const Point* {return x;}, obj);
+}
+
+static inline float area(const AABB& box){
+    glm::vec3 size = box.max - box.min;
+    return size.x*size.y + size.y*size.z + size.z*size.x;
+}
+
+// Distance along the ray to where it enters box, or inf if it misses within max.
+static inline float enter(const AABB& box, const glm::vec3& origin, const glm::vec3& inv, float max){
+    glm::vec3 t0 = (box.min - origin)*inv, t1 = (box.max - origin)*inv;
+    glm::vec3 lo = glm::min(t0, t1), hi = glm::max(t0, t1);
+    float near = std::max({lo.x, lo.y, lo.z, 0.0f}), far = std::min({hi.x, hi.y, hi.z, max});
+    return near <= far ? near:inf;
+}
+
+static inline float dist2(const AABB& box, const glm::vec3& p){
+    glm::vec3 d = glm::max(glm::max(box.min - p, p - box.max), glm::vec3(0));
+    return glm::dot(d, d);
+}
+
+// The ray enters a convex solid through the last of its planes it crosses going in and leaves
+// through the first it crosses going out. face is left at -1 if the origin is inside.
+static bool solid(const glm::vec4* planes, unsigned int count, const glm::vec3& origin, const glm::vec3& dir, float max, float& t, int& face){
+    float in = 0, out = max;
+    face = -1;
+    for(unsigned int j = 0; j < count; j++){
+        glm::vec3 n(planes[j]);
+        float s = glm::dot(n, origin) - planes[j].w, speed = glm::dot(n, dir);
+        if(speed == 0){
+            if(s < 0) return false;
+            continue;
+        }
+        float cross = -s/speed;
+        if(speed > 0 && cross > in){
+            in = cross;
+            face = j;
+        }
+        else if(speed < 0 && cross < out) out = cross;
+        if(in > out) return false;
+    }
+    t = in;
+    return true;
+}
+
+static RayHit hit(const Point&, const glm::vec3&, const glm::vec3&, float){
+    return {};
+}
+
+static RayHit hit(const Plane& obj, const glm::vec3& origin, const glm::vec3& dir, float max){
+    glm::vec3 n = obj.normVec();
+    float speed = glm::dot(n, dir);
+    if(speed == 0) return {};
+    float t = -obj.sign_dist(Point(origin))/speed;
+    if(t < 0 || t > max) return {};
+    return {&obj, t, origin + t*dir, speed < 0 ? n:-n};
+}
+
+static RayHit hit(const Polygon& obj, const glm::vec3& origin, const glm::vec3& dir, float max){
+    Mesh::Face face = obj.mesh().face(0);
+    float speed = glm::dot(face.normal(), dir);
+    if(speed == 0) return {};
+    float t = -face.sign_dist(origin)/speed;
+    glm::vec3 p = origin + t*dir;
+    if(t < 0 || t > max || !face.inside(p)) return {};
+    return {&obj, t, p, speed < 0 ? face.normal():-face.normal()};
+}
+
+static RayHit hit(const Polyhedron& obj, const glm::vec3& origin, const glm::vec3& dir, float max){
+    const Mesh& m = obj.mesh();
+    float t;
+    int face;
+    if(!solid(m.planes.data(), m.face_count(), origin, dir, max, t, face)) return {};
+    return {&obj, t, origin + t*dir, face < 0 ? -dir:-glm::vec3(m.planes[face])};
+}
+
+// Cast in model space, where the template's planes are. The parameter along the ray is the same
+// in both spaces as long as the direction is carried over unnormalized.
+static RayHit hit(const Instance& obj, const glm::vec3& origin, const glm::vec3& dir, float max){
+    const Mesh& m = obj.geometry().mesh();
+    const glm::mat4& model = obj.placement();
+    glm::mat3 back = glm::inverse(glm::mat3(model));
+    float t;
+    int face;
+    if(!solid(m.planes.data(), m.face_count(), back*(origin - glm::vec3(model[3])), back*dir, max, t, face)) return {};
+    return {&obj, t, origin + t*dir, face < 0 ? -dir:-glm::normalize(glm::transpose(back)*glm::vec3(m.planes[face]))};
+}
+
+RayHit gmh::raycast(const Shape& obj, const glm::vec3& origin, const glm::vec3& dir, float max){
+    return std::visit([&](auto* x){return hit(*x, origin, dir, max);}, obj);
+}
+
+// Whether a line or plane, the only shapes without bounds, meets a box.
+static bool crosses(const Shape& obj, const AABB& box){
+    glm::vec3 center = 0.5f*(box.min + box.max), half = 0.5f*(box.max - box.min);
+    if(const Plane* plane = shape_cast<Plane>(obj)){
+        glm::vec3 n = plane->normVec();
+        return std::abs(plane->sign_dist(Point(center))) <= glm::dot(glm::abs(n), half);
+    }
+    const Line* line = shape_cast<Line>(obj);
+    if(!line) return box.overlaps(object(obj)->extent().box);
+    glm::vec3 a = line->vertices[0]->pos, dir = line->dirVec();
+    float lo = -inf, hi = inf;
+    for(unsigned int i = 0; i < 3; i++){
+        if(dir[i] == 0){
+            if(a[i] < box.min[i] || a[i] > box.max[i]) return false;
+            continue;
+        }
+        float t0 = (box.min[i] - a[i])/dir[i], t1 = (box.max[i] - a[i])/dir[i];
+        lo = std::max(lo, std::min(t0, t1));
+        hi = std::min(hi, std::max(t0, t1));
+    }
+    return lo <= hi;
+}
+
+SceneQuery::SceneQuery(const std::vector<const Point*>& shapes){
+    build(shapes);
+}
+
+void SceneQuery::build(const std::vector<const Point*>& shapes){
+    items.clear();
+    boxes.clear();
+    nodes.clear();
+    unbounded.clear();
+    for(const Point* obj: shapes){
+        Extent ext = obj->extent();
+        if(std::isinf(ext.sphere.radius)) unbounded.push_back(shape(*obj));
+        else{
+            items.push_back(shape(*obj));
+            boxes.push_back(ext.box);
+        }
+    }
+    if(items.empty()) return;
+    std::vector<glm::vec3> centers(items.size());
+    for(unsigned int i = 0; i < items.size(); i++) centers[i] = 0.5f*(boxes[i].min + boxes[i].max);
+    std::vector<unsigned int> order(items.size());
+    std::iota(order.begin(), order.end(), 0);
+    nodes.reserve(2*items.size());
+    split(order, centers, 0, items.size(), 0);
+    std::vector<Shape> sorted(items.size());
+    std::vector<AABB> sorted_boxes(items.size());
+    for(unsigned int i = 0; i < order.size(); i++){
+        sorted[i] = items[order[i]];
+        sorted_boxes[i] = boxes[order[i]];
+    }
+    items = std::move(sorted);
+    boxes = std::move(sorted_boxes);
+}
+
+void SceneQuery::split(std::vector<unsigned int>& order, const std::vector<glm::vec3>& centers, unsigned int start, unsigned int count, unsigned int depth){
+    unsigned int index = nodes.size();
+    nodes.push_back({boxes[order[start]], start, count});
+    AABB middle{centers[order[start]], centers[order[start]]};
+    for(unsigned int i = start; i < start + count; i++){
+        nodes[index].box.add(boxes[order[i]]);
+        middle.add(centers[order[i]]);
+    }
+    if(count <= 2 || depth >= max_depth) return;
+
+    // Cost of a split relative to testing every item of a leaf, counting a traversal step as one test.
+    float best = count, whole = area(nodes[index].box);
+    unsigned int axis = 3, cut = 0;
+    for(unsigned int a = 0; a < 3; a++){
+        float extent = middle.max[a] - middle.min[a];
+        if(extent <= 0) continue;
+        std::array<AABB, bin_count> bins;
+        std::array<unsigned int, bin_count> counts{};
+        for(unsigned int i = start; i < start + count; i++){
+            unsigned int b = std::min(bin_count - 1, static_cast<unsigned int>((centers[order[i]][a] - middle.min[a])/extent*bin_count));
+            if(counts[b]++ == 0) bins[b] = boxes[order[i]];
+            else bins[b].add(boxes[order[i]]);
+        }
+        // Areas of the boxes right of each cut, swept from the right.
+        std::array<float, bin_count> right{};
+        AABB sweep;
+        unsigned int seen = 0;
+        for(unsigned int b = bin_count - 1; b > 0; b--){
+            if(counts[b] > 0){
+                if(seen == 0) sweep = bins[b];
+                else sweep.add(bins[b]);
+            }
+            seen += counts[b];
+            right[b] = seen > 0 ? area(sweep)*seen:0;
+        }
+        seen = 0;
+        for(unsigned int b = 0; b + 1 < bin_count; b++){
+            if(counts[b] > 0){
+                if(seen == 0) sweep = bins[b];
+                else sweep.add(bins[b]);
+            }
+            seen += counts[b];
+            if(seen == 0 || seen == count) continue;
+            float cost = 1 + (area(sweep)*seen + right[b + 1])/whole;
+            if(cost < best){
+                best = cost;
+                axis = a;
+                cut = b + 1;
+            }
+        }
+    }
+
+    unsigned int half;
+    if(axis < 3){
+        float extent = middle.max[axis] - middle.min[axis];
+        half = std::partition(order.begin() + start, order.begin() + start + count, [&](unsigned int i){
+            return std::min(bin_count - 1, static_cast<unsigned int>((centers[i][axis] - middle.min[axis])/extent*bin_count)) < cut;
+        }) - order.begin() - start;
+    }
+    else if(count > max_leaf){
+        // Centers too close to bin apart: halve along the longest axis of the node instead.
+        glm::vec3 size = nodes[index].box.max - nodes[index].box.min;
+        unsigned int longest = size.x > size.y ? (size.x > size.z ? 0:2):(size.y > size.z ? 1:2);
+        half = count/2;
+        std::nth_element(order.begin() + start, order.begin() + start + half, order.begin() + start + count, [&](unsigned int i, unsigned int j){
+            return centers[i][longest] < centers[j][longest];
+        });
+    }
+    else return;
+
+    nodes[index].count = 0;
+    split(order, centers, start, half, depth + 1);
+    nodes[index].start = nodes.size();
+    split(order, centers, start + half, count - half, depth + 1);
+}
+
+void SceneQuery::refit(){
+    for(unsigned int i = 0; i < items.size(); i++) boxes[i] = object(items[i])->extent().box;
+    for(unsigned int i = nodes.size(); i-- > 0;){
+        Node& node = nodes[i];
+        if(node.count == 0){
+            node.box = nodes[i + 1].box;
+            node.box.add(nodes[node.start].box);
+            continue;
+        }
+        node.box = boxes[node.start];
+        for(unsigned int k = node.start + 1; k < node.start + node.count; k++) node.box.add(boxes[k]);
+    }
+}
+
+RayHit SceneQuery::raycast(const glm::vec3& origin, const glm::vec3& dir, float max) const {
+    glm::vec3 d = glm::normalize(dir), inv = 1.0f/d;
+    RayHit best;
+    for(const Shape& obj: unbounded)
+        if(RayHit h = gmh::raycast(obj, origin, d, max)){
+            best = h;
+            max = h.dist;
+        }
+    if(nodes.empty()) return best;
+    struct Entry {
+        unsigned int node;
+        float t;
+    };
+    std::array<Entry, max_depth + 2> stack;
+    unsigned int top = 0;
+    if(float t = enter(nodes[0].box, origin, inv, max); t < inf) stack[top++] = {0, t};
+    while(top > 0){
+        Entry e = stack[--top];
+        if(e.t > max) continue;
+        const Node& node = nodes[e.node];
+        if(node.count > 0){
+            for(unsigned int k = node.start; k < node.start + node.count; k++){
+                if(enter(boxes[k], origin, inv, max) == inf) continue;
+                if(RayHit h = gmh::raycast(items[k], origin, d, max)){
+                    best = h;
+                    max = h.dist;
+                }
+            }
+            continue;
+        }
+        // Visit the nearer child first, so that its hits cut the farther one short.
+        Entry a{e.node + 1, enter(nodes[e.node + 1].box, origin, inv, max)}, b{node.start, enter(nodes[node.start].box, origin, inv, max)};
+        if(a.t > b.t) std::swap(a, b);
+        if(b.t < inf) stack[top++] = b;
+        if(a.t < inf) stack[top++] = a;
+    }
+    return best;
+}
+
+void SceneQuery::overlap(const AABB& box, std::vector<const Point*>& out) const {
+    for(const Shape& obj: unbounded) if(crosses(obj, box)) out.push_back(object(obj));
+    if(nodes.empty()) return;
+    std::array<unsigned int, max_depth + 2> stack;
+    unsigned int top = 0;
+    stack[top++] = 0;
+    while(top > 0){
+        const Node& node = nodes[stack[--top]];
+        if(!node.box.overlaps(box)) continue;
+        if(node.count > 0){
+            for(unsigned int k = node.start; k < node.start + node.count; k++)
+                if(boxes[k].overlaps(box)) out.push_back(object(items[k]));
+            continue;
+        }
+        stack[top++] = node.start;
+        stack[top++] = &node - nodes.data() + 1;
+    }
+}
+
+void SceneQuery::overlap(const Sphere& sphere, std::vector<const Point*>& out) const {
+    Point probe(sphere.center);
+    Shape at = &probe;
+    float r2 = sphere.radius*sphere.radius;
+    for(const Shape& obj: unbounded) if(dist(obj, at) <= sphere.radius) out.push_back(object(obj));
+    if(nodes.empty()) return;
+    std::array<unsigned int, max_depth + 2> stack;
+    unsigned int top = 0;
+    stack[top++] = 0;
+    while(top > 0){
+        const Node& node = nodes[stack[--top]];
+        if(dist2(node.box, sphere.center) > r2) continue;
+        if(node.count > 0){
+            for(unsigned int k = node.start; k < node.start + node.count; k++)
+                if(dist2(boxes[k], sphere.center) <= r2 && dist(items[k], at) <= sphere.radius) out.push_back(object(items[k]));
+            continue;
+        }
+        stack[top++] = node.start;
+        stack[top++] = &node - nodes.data() + 1;
+    }
+}
+
+const Point* SceneQuery::nearest(const glm::vec3& p, float max, float* dist) const {
+    Point probe(p);
+    Shape at = &probe;
+    const Point* found = nullptr;
+    auto test = [&](const Shape& obj){
+        if(float d = gmh::dist(obj, at); d < max){
+            max = d;
+            found = object(obj);
+        }
+    };
+    for(const Shape& obj: unbounded) test(obj);
+    if(!nodes.empty()){
+        struct Entry {
+            unsigned int node;
+            float d2;
+        };
+        std::array<Entry, max_depth + 2> stack;
+        unsigned int top = 0;
+        stack[top++] = {0, dist2(nodes[0].box, p)};
+        while(top > 0){
+            Entry e = stack[--top];
+            if(e.d2 >= max*max) continue;
+            const Node& node = nodes[e.node];
+            if(node.count > 0){
+                for(unsigned int k = node.start; k < node.start + node.count; k++)
+                    if(dist2(boxes[k], p) < max*max) test(items[k]);
+                continue;
+            }
+            Entry a{e.node + 1, dist2(nodes[e.node + 1].box, p)}, b{node.start, dist2(nodes[node.start].box, p)};
+            if(a.d2 > b.d2) std::swap(a, b);
+            stack[top++] = b;
+            stack[top++] = a;
+        }
+    }
+    if(dist && found) *dist = max;
+    return found;
+}
@@ -0,0 +1,212 @@
+#include "Graphics/sat.hpp"
+#include <cmath>
+#include <limits>
+#include <algorithm>
+#include <glm/geometric.hpp>
+#include "Graphics/mesh.hpp"
+#include "Graphics/intersection.hpp"
+
+using namespace gmh;
+
+namespace {
+    constexpr float lowest = -std::numeric_limits<float>::infinity();
+
+    /**
+     * Outward normal of a face. Mesh planes of a Polyhedron point inwards.
+     */
+    inline glm::vec3 outward(const Mesh& m, unsigned int f){
+        return -glm::vec3(m.planes[f]);
+    }
+
+    /**
+     * Separation of other from face f of m along its outward normal.
+     */
+    inline float face_separation(const Mesh& m, unsigned int f, const Mesh& other, unsigned int& start){
+        glm::vec3 n(m.planes[f]);
+        start = other.support(n, start);
+        return m.planes[f].w - glm::dot(n, other.verts[start]);
+    }
+
+    /**
+     * Whether the arcs a-b and c-d cross on the Gauss map, ie the edges
+     * with these adjacent face normals build a face of the Minkowski
+     * difference. c and d are the normals of the second shape, negated.
+     */
+    inline bool minkowski_face(const glm::vec3& a, const glm::vec3& b, const glm::vec3& c, const glm::vec3& d){
+        glm::vec3 bxa = glm::cross(b, a), dxc = glm::cross(d, c);
+        float cba = glm::dot(c, bxa), dba = glm::dot(d, bxa), adc = glm::dot(a, dxc), bdc = glm::dot(b, dxc);
+        return cba*dba < 0 && adc*bdc < 0 && cba*bdc > 0;
+    }
+
+    /**
+     * Separation along the cross product of edge i of m1 and edge j of m2,
+     * or lowest if the edges do not build a Minkowski face or are parallel.
+     */
+    float edge_separation(const Mesh& m1, unsigned int i, const Mesh& m2, unsigned int j, glm::vec3& normal){
+        std::array<unsigned int, 2> f1 = m1.edge_faces(i), f2 = m2.edge_faces(j);
+        glm::vec3 a = outward(m1, f1[0]), b = outward(m1, f1[1]);
+        if(!minkowski_face(a, b, -outward(m2, f2[0]), -outward(m2, f2[1]))) return lowest;
+        glm::vec3 p1 = m1.edge(i).a(), e1 = m1.edge(i).b() - p1;
+        glm::vec3 p2 = m2.edge(j).a(), e2 = m2.edge(j).b() - p2;
+        glm::vec3 n = glm::cross(e1, e2);
+        float len = glm::length(n);
+        if(len < 0.005f*std::sqrt(glm::dot(e1, e1)*glm::dot(e2, e2))) return lowest;
+        n /= len;
+        // The edge lies between its two faces on the Gauss map, so the outward axis does too.
+        if(glm::dot(n, a + b) < 0) n = -n;
+        normal = n;
+        return glm::dot(n, p2 - p1);
+    }
+
+    /**
+     * Midpoint of the closest points of segments p1 + s*e1 and p2 + t*e2.
+     */
+    glm::vec3 closest_midpoint(const glm::vec3& p1, const glm::vec3& e1, const glm::vec3& p2, const glm::vec3& e2){
+        glm::vec3 r = p1 - p2;
+        float a = glm::dot(e1, e1), e = glm::dot(e2, e2), b = glm::dot(e1, e2), c = glm::dot(e1, r), f = glm::dot(e2, r);
+        float denom = a*e - b*b;
+        float s = denom > 0 ? std::clamp((b*f - c*e)/denom, 0.0f, 1.0f):0;
+        float t = std::clamp((b*s + f)/e, 0.0f, 1.0f);
+        s = std::clamp((b*t - c)/a, 0.0f, 1.0f);
+        return 0.5f*(p1 + s*e1 + p2 + t*e2);
+    }
+
+    /**
+     * Separation and normal, from the first mesh towards the second, along an axis.
+     */
+    float separation(const Mesh& m1, const Mesh& m2, SatAxis& axis, glm::vec3& normal){
+        switch(axis.kind){
+            case SatAxis::Kind::Face1:
+                if(axis.i >= m1.face_count()) return lowest;
+                if(axis.start >= m2.verts.size()) axis.start = 0;
+                normal = outward(m1, axis.i);
+                return face_separation(m1, axis.i, m2, axis.start);
+            case SatAxis::Kind::Face2:
+                if(axis.i >= m2.face_count()) return lowest;
+                if(axis.start >= m1.verts.size()) axis.start = 0;
+                normal = -outward(m2, axis.i);
+                return face_separation(m2, axis.i, m1, axis.start);
+            case SatAxis::Kind::Edges:
+                if(axis.i >= m1.edge_count() || axis.j >= m2.edge_count()) return lowest;
+                return edge_separation(m1, axis.i, m2, axis.j, normal);
+            default:
+                return lowest;
+        }
+    }
+
+    /**
+     * Fill in the contact points of meshes touching along axis.
+     */
+    SatContact& contacts(const Mesh& m1, const Mesh& m2, const SatAxis& axis, SatContact& out){
+        switch(axis.kind){
+            case SatAxis::Kind::Face1: out.count = clip_contacts(m1, axis.i, m2, out.points); break;
+            case SatAxis::Kind::Face2: out.count = clip_contacts(m2, axis.i, m1, out.points); break;
+            default:
+                out.points[0] = closest_midpoint(m1.edge(axis.i).a(), m1.edge(axis.i).b() - m1.edge(axis.i).a(),
+                                                 m2.edge(axis.j).a(), m2.edge(axis.j).b() - m2.edge(axis.j).a());
+                out.count = 1;
+                break;
+        }
+        return out;
+    }
+}
+
+unsigned int gmh::clip_contacts(const Mesh& ref, unsigned int ref_face, const Mesh& other, std::array<glm::vec3, 8>& out){
+    glm::vec3 n(ref.planes[ref_face]);
+    unsigned int incident = 0;
+    for(unsigned int i = 1; i < other.face_count(); i++)
+        if(glm::dot(glm::vec3(other.planes[i]), n) < glm::dot(glm::vec3(other.planes[incident]), n)) incident = i;
+    Mesh::Face face = ref.face(ref_face);
+    Intersection clipped = Intersection::clip(other.face(incident), ref.edge_planes.data() + ref.face_start[ref_face], face.size());
+    unsigned int count = 0;
+    for(const glm::vec3& p: clipped)
+        if(face.sign_dist(p) >= -1e-5 && count < out.size()) out[count++] = p;
+    return count;
+}
+
+SatContact gmh::sat(const Mesh& m1, const Mesh& m2, SatAxis& axis, float tolerance){
+    SatContact out;
+    out.separation = separation(m1, m2, axis, out.normal);
+    if(out.separation > tolerance) return out;
+
+    // Overlap along the cached axis says nothing about the others, so they are all searched,
+    // starting from the cached axis as the best so far.
+    const SatAxis cached = axis;
+    const float cached_separation = out.separation;
+    const glm::vec3 cached_normal = out.normal;
+    SatAxis face1{SatAxis::Kind::Face1}, face2{SatAxis::Kind::Face2}, edges{SatAxis::Kind::Edges};
+    float s1 = lowest, s2 = lowest, se = lowest;
+    switch(cached.kind){
+        case SatAxis::Kind::Face1: face1 = cached; s1 = cached_separation; break;
+        case SatAxis::Kind::Face2: face2 = cached; s2 = cached_separation; break;
+        case SatAxis::Kind::Edges: edges = cached; se = cached_separation; break;
+        default: break;
+    }
+    unsigned int start = 0;
+    for(unsigned int f = 0; f < m1.face_count(); f++){
+        float s = face_separation(m1, f, m2, start);
+        if(s > s1){
+            s1 = s;
+            face1.i = f;
+            face1.start = start;
+        }
+        if(s > tolerance) break;
+    }
+    if(s1 <= tolerance){
+        start = 0;
+        for(unsigned int f = 0; f < m2.face_count(); f++){
+            float s = face_separation(m2, f, m1, start);
+            if(s > s2){
+                s2 = s;
+                face2.i = f;
+                face2.start = start;
+            }
+            if(s > tolerance) break;
+        }
+    }
+    glm::vec3 edge_normal = cached.kind == SatAxis::Kind::Edges ? cached_normal:glm::vec3(0);
+    if(s1 <= tolerance && s2 <= tolerance){
+        glm::vec3 n;
+        for(unsigned int i = 0; i < m1.edge_count() && se <= tolerance; i++){
+            for(unsigned int j = 0; j < m2.edge_count(); j++){
+                float s = edge_separation(m1, i, m2, j, n);
+                if(s > se){
+                    se = s;
+                    edges.i = i;
+                    edges.j = j;
+                    edge_normal = n;
+                    if(s > tolerance) break;
+                }
+            }
+        }
+    }
+
+    // Faces give stabler contacts than edges, so they win unless clearly worse. An axis that
+    // separates always wins, and the loops above stop at the first one.
+    const float bias = 1e-4f;
+    if(se > tolerance || se > std::max(s1, s2) + bias){
+        axis = edges;
+        out.separation = se;
+        out.normal = edge_normal;
+    }
+    else if(s2 > tolerance || (s1 <= tolerance && s2 > s1 + bias)){
+        axis = face2;
+        out.separation = s2;
+        out.normal = -outward(m2, face2.i);
+    }
+    else{
+        axis = face1;
+        out.separation = s1;
+        out.normal = outward(m1, face1.i);
+    }
+    if(out.separation > tolerance) return out;
+    // Shapes resting on each other stay on the axis they touched along, rather than switching
+    // to one that is shallower by less than slop.
+    const float slop = 1e-3f;
+    if(cached_separation >= out.separation - slop){
+        axis = cached;
+        out.separation = cached_separation;
+        out.normal = cached_normal;
+    }
+    return contacts(m1, m2, axis, out);
+}
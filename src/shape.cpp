@@ -0,0 +1,17 @@
+#include <stdexcept>
+#include <typeinfo>
+#include "Graphics/shape.hpp"
+
+using namespace gmh;
+
+Shape gmh::shape(const Point& obj){
+    // Most derived first, since a Polygon is also a Plane and a LinSeg also a Line.
+    if(const Instance* inst = dynamic_cast<const Instance*>(&obj)) return inst;
+    if(const Polyhedron* polyhed = dynamic_cast<const Polyhedron*>(&obj)) return polyhed;
+    if(const Polygon* poly = dynamic_cast<const Polygon*>(&obj)) return poly;
+    if(const Plane* plane = dynamic_cast<const Plane*>(&obj)) return plane;
+    if(const LinSeg* seg = dynamic_cast<const LinSeg*>(&obj)) return seg;
+    if(const Line* line = dynamic_cast<const Line*>(&obj)) return line;
+    if(typeid(obj) == typeid(Point)) return &obj;
+    throw std::invalid_argument("Object is not of a geometry type");
+}
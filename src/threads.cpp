@@ -0,0 +1,57 @@
+#include "Graphics/threads.hpp"
+#include <algorithm>
+
+using namespace gmh;
+
+ThreadPool::ThreadPool(unsigned int threads){
+    for(unsigned int i = 1; i < std::max(threads, 1u); i++) workers.emplace_back(&ThreadPool::work, this, i);
+}
+
+ThreadPool::~ThreadPool(){
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        stop = true;
+    }
+    wake.notify_all();
+    for(std::thread& t: workers) t.join();
+}
+
+void ThreadPool::run(size_t count, size_t grain, const Job& f){
+    grain = std::max<size_t>(grain, 1);
+    if(workers.empty() || count <= grain){
+        if(count > 0) f(0, count, 0);
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> guard(lock);
+        job = &f;
+        this->count = count;
+        this->grain = grain;
+        next = 0;
+        busy = workers.size();
+        epoch++;
+    }
+    wake.notify_all();
+    drain(0);
+    std::unique_lock<std::mutex> guard(lock);
+    done.wait(guard, [this](){return busy == 0;});
+    job = nullptr;
+}
+
+void ThreadPool::work(unsigned int worker){
+    unsigned int seen = 0;
+    std::unique_lock<std::mutex> guard(lock);
+    while(true){
+        wake.wait(guard, [this, &seen](){return stop || epoch != seen;});
+        if(stop) return;
+        seen = epoch;
+        guard.unlock();
+        drain(worker);
+        guard.lock();
+        if(--busy == 0) done.notify_one();
+    }
+}
+
+void ThreadPool::drain(unsigned int worker){
+    for(size_t begin; (begin = next.fetch_add(grain)) < count;) (*job)(begin, std::min(begin + grain, count), worker);
+}
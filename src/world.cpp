@@ -0,0 +1,102 @@
+#include "Graphics/world.hpp"
+#include <cmath>
+#include <stdexcept>
+#include <algorithm>
+#include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_ptr.hpp>
+#include "Graphics/batch.hpp"
+#include "Graphics/geometry.hpp"
+
+using namespace gmh;
+
+PhysicsWorld::PhysicsWorld(float dt, float elasticity, unsigned int threads, unsigned int max_steps):
+    handler(elasticity, threads), dt(dt), max_steps(std::max(max_steps, 1u)) {
+    if(dt <= 0) throw std::domain_error("Step size must be positive");
+}
+
+unsigned int PhysicsWorld::update(float frame){
+    accumulator += frame;
+    unsigned int steps = 0;
+    for(; accumulator >= dt && steps < max_steps; steps++){
+        step();
+        accumulator -= dt;
+    }
+    if(accumulator >= dt) accumulator = std::fmod(accumulator, dt);
+    return steps;
+}
+
+void PhysicsWorld::step(){
+    size_t n = ids.size();
+    px = x;
+    py = y;
+    pz = z;
+    for(size_t i = 0; i < n; i++){
+        const Physical& body = *handler.get(ids[i]);
+        glm::vec3 v = body.fixed || body.asleep ? glm::vec3(0):body->vel;
+        if(body.fast && v != glm::vec3(0)) v *= handler.impact(body, dt);
+        vx[i] = v.x;
+        vy[i] = v.y;
+        vz[i] = v.z;
+    }
+    integrate_many(x.data(), vx.data(), n, dt);
+    integrate_many(y.data(), vy.data(), n, dt);
+    integrate_many(z.data(), vz.data(), n, dt);
+    for(size_t i = 0; i < n; i++){
+        glm::vec3 d(x[i] - px[i], y[i] - py[i], z[i] - pz[i]);
+        if(d != glm::vec3(0)) handler.translate(ids[i], d);
+    }
+    handler();
+}
+
+BodyId PhysicsWorld::add(Point* v, float mass, bool fixed, bool fast){
+    size_t n = handler.size();
+    BodyId id = handler.add(v, mass, fixed, fast);
+    if(handler.size() == n) return id;
+    ids.push_back(id);
+    for(std::vector<float>* a: {&x, &px}) a->push_back(v->pos.x);
+    for(std::vector<float>* a: {&y, &py}) a->push_back(v->pos.y);
+    for(std::vector<float>* a: {&z, &pz}) a->push_back(v->pos.z);
+    for(std::vector<float>* a: {&vx, &vy, &vz}) a->push_back(0);
+    return id;
+}
+
+void PhysicsWorld::remove(BodyId id){
+    if(!handler.get(id)) return;
+    // The handler moves its last body into the hole, and so do the arrays.
+    size_t i = handler.position(id);
+    handler.remove(id);
+    for(std::vector<float>* a: {&x, &y, &z, &px, &py, &pz, &vx, &vy, &vz}){
+        (*a)[i] = a->back();
+        a->pop_back();
+    }
+    ids[i] = ids.back();
+    ids.pop_back();
+}
+
+glm::vec3 PhysicsWorld::position(BodyId id) const {
+    size_t i = handler.position(id);
+    float a = alpha();
+    return glm::vec3(px[i] + a*(x[i] - px[i]), py[i] + a*(y[i] - py[i]), pz[i] + a*(z[i] - pz[i]));
+}
+
+glm::mat4 PhysicsWorld::model(BodyId id) const {
+    const Point& obj = *handler.get(id)->obj;
+    return glm::translate(glm::mat4(1), position(id) - obj.pos)*glm::make_mat4(obj.model_ptr());
+}
+
+void PhysicsWorld::snapshot(Snapshot& out) const {
+    out.clear();
+    // The handler goes first so that restoring into a different world throws before anything changes.
+    handler.snapshot(out);
+    out.write(accumulator);
+    out.write(ids);
+    for(const std::vector<float>* a: {&x, &y, &z, &px, &py, &pz}) out.write(*a);
+}
+
+void PhysicsWorld::restore(const Snapshot& from){
+    SnapshotReader in(from);
+    handler.restore(in);
+    in.read(accumulator);
+    in.read(ids);
+    for(std::vector<float>* a: {&x, &y, &z, &px, &py, &pz}) in.read(*a);
+}
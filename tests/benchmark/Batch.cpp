@@ -0,0 +1,47 @@
+#include <random>
+#include "bench.hpp"
+#include "Graphics/geometry.hpp"
+#include "Graphics/batch.hpp"
+
+static const char* name(gmh::SimdLevel level){
+    switch(level){
+        case gmh::SimdLevel::AVX2: return "dist_many, AVX2";
+        case gmh::SimdLevel::SSE: return "dist_many, SSE";
+        default: return "dist_many, scalar";
+    }
+}
+
+// Points per second classified against one shape, per point virtual dist() against dist_many at each level.
+template<typename T>
+static void run(const char* label, const T& obj, unsigned int n, const std::vector<glm::vec3>& points){
+    std::vector<gmh::Point> queries(points.begin(), points.end());
+    std::vector<float> out(points.size());
+    volatile float sink = 0;
+    std::cout << label << std::endl;
+    double base = bench::time_ns([&](){for(const gmh::Point& q: queries) sink = sink + q.dist(obj);});
+    bench::row("Point::dist", n, base);
+    for(gmh::SimdLevel level: {gmh::SimdLevel::Scalar, gmh::SimdLevel::SSE, gmh::SimdLevel::AVX2}){
+        if(level > gmh::simd_supported()) continue;
+        gmh::simd_level(level);
+        double ns = bench::time_ns([&](){gmh::dist_many(obj, points.data(), points.size(), out.data()); sink = sink + out[0];}, 5);
+        bench::row(name(level), n, ns);
+        std::cout << std::setw(52) << std::setprecision(1) << base/ns << "x" << std::endl;
+    }
+    gmh::simd_level(gmh::simd_supported());
+}
+
+int main(){
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<float> dist(-2, 2);
+    std::vector<glm::vec3> points(100000);
+    for(glm::vec3& p: points) p = glm::vec3(dist(gen), dist(gen), dist(gen));
+
+    gmh::Polygon poly(glm::vec3(1, 1, 0), glm::vec3(-1, 1, 0), glm::vec3(1, -1, 0), glm::vec3(-1, -1, 0));
+    run("Polygon, 100000 points", poly, 4, points);
+    for(unsigned int n: {8u, 32u, 128u}){
+        std::vector<glm::vec3> vert = bench::sphere_points(n);
+        gmh::Polyhedron sphere(std::vector<gmh::Point>(vert.begin(), vert.end()));
+        run("Polyhedron, 100000 points", sphere, n, points);
+    }
+    return 0;
+}
@@ -0,0 +1,40 @@
+#include <random>
+#include <memory>
+#include "bench.hpp"
+#include "Graphics/geometry.hpp"
+
+// One shape queried against a scene of sphere hulls spread far apart, the case where every
+// pair is separated. dist() runs the exact code on each, and intersection() used to run dist()
+// first, while within(), intersection() and gap() now turn the pairs away on their extents.
+int main(){
+    const unsigned int count = 200, reps = 20;
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<float> spread(-100, 100);
+    volatile float sink = 0;
+    for(unsigned int n: {12u, 50u, 200u}){
+        std::vector<glm::vec3> points = bench::sphere_points(n);
+        std::vector<std::unique_ptr<gmh::Polyhedron>> scene;
+        for(unsigned int i = 0; i < count; i++){
+            scene.push_back(std::make_unique<gmh::Polyhedron>(std::vector<gmh::Point>(points.begin(), points.end())));
+            scene.back()->translate(glm::vec3(spread(gen), spread(gen), spread(gen)));
+            scene.back()->sync();
+        }
+        gmh::Polyhedron probe(std::vector<gmh::Point>(points.begin(), points.end()));
+        probe.translate(glm::vec3(0, 0, 200));
+        probe.sync();
+        std::cout << "Sphere hull against " << count << " separated hulls" << std::endl;
+        bench::row("dist", n, bench::time_ns([&](){
+            for(const std::unique_ptr<gmh::Polyhedron>& obj: scene) sink = sink + probe.dist(*obj);
+        }));
+        bench::row("within", n, bench::time_ns([&](){
+            for(const std::unique_ptr<gmh::Polyhedron>& obj: scene) sink = sink + probe.within(*obj, 1);
+        }, reps));
+        bench::row("intersection", n, bench::time_ns([&](){
+            for(const std::unique_ptr<gmh::Polyhedron>& obj: scene) sink = sink + probe.intersection(*obj).size();
+        }, reps));
+        bench::row("gap", n, bench::time_ns([&](){
+            for(const std::unique_ptr<gmh::Polyhedron>& obj: scene) sink = sink + probe.gap(*obj);
+        }, reps));
+    }
+    return 0;
+}
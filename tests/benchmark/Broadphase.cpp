@@ -0,0 +1,37 @@
+#include <random>
+#include "bench.hpp"
+#include "Graphics/collision.hpp"
+#include "Graphics/gmath.hpp"
+#include "scene.hpp"
+
+// Mostly resting unit cubes on a grid, one in twenty drifting, stepped through CHandler with
+// sweep and prune against a GJK query on every pair as CHandler did before.
+int main(){
+    const unsigned int frames = 10;
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<float> drift(-0.5, 0.5);
+    for(unsigned int n: {10u, 100u, 1000u, 5000u, 10000u}){
+        unsigned int side = std::ceil(std::cbrt(static_cast<float>(n)));
+        std::vector<std::unique_ptr<gmh::Polyhedron>> cubes;
+        for(unsigned int i = 0; i < n; i++){
+            glm::vec3 c = 1.2f*glm::vec3(i%side, i/side%side, i/side/side);
+            cubes.push_back(scene::crate(c));
+            if(i%20 == 0) cubes.back()->vel = glm::vec3(drift(gen), drift(gen), drift(gen));
+        }
+        gmh::CHandler handler(0.5);
+        for(std::unique_ptr<gmh::Polyhedron>& cube: cubes) handler.add(cube.get());
+        handler();
+        std::cout << "Cube grid, per frame" << std::endl;
+        if(n <= 1000){
+            volatile float sink = 0;
+            bench::row("all pairs GJK", n, bench::time_ns([&](){
+                for(auto [a, b]: gmh::combinations<2>(cubes.cbegin(), cubes.cend())) sink = sink + gmh::gjk(**a, **b).dist;
+            }));
+        }
+        bench::row("sweep and prune", n, bench::time_ns([&](){
+            for(unsigned int i = 0; i < n; i += 20) cubes[i]->update(1/60.f);
+            handler();
+        }, frames));
+    }
+    return 0;
+}
@@ -0,0 +1,32 @@
+#include "bench.hpp"
+#include "Graphics/collision.hpp"
+#include "scene.hpp"
+
+// Bullets moving 200 units/s at a thin wall, at 60 frames/s: discrete steps, discrete substeps
+// small enough not to skip over the wall, and one swept step per frame.
+int main(){
+    const unsigned int side = 10, frames = 6;
+    const float speed = 200, half = 0.1, frame = 1/60.f;
+    const unsigned int substeps = std::ceil(speed*frame/half);
+    struct Run {const char* name; unsigned int steps; bool fast;};
+    std::cout << "Bullets at a wall, per frame" << std::endl;
+    for(Run run: {Run{"discrete", 1, false}, Run{"discrete, substepped", substeps, false}, Run{"swept", 1, true}}){
+        float extent = 0.5f*side;
+        gmh::Polygon wall(glm::vec3(0, -extent, -extent), glm::vec3(0, extent, -extent), glm::vec3(0, -extent, extent), glm::vec3(0, extent, extent));
+        gmh::CHandler handler(1, 1);
+        handler.add(&wall, 1, true);
+        std::vector<std::unique_ptr<gmh::Polyhedron>> bullets;
+        for(unsigned int i = 0; i < side*side; i++){
+            bullets.push_back(scene::crate(glm::vec3(-2 - half, 0.5f*(i%side) - extent + 0.25f - half, 0.5f*(i/side) - extent + 0.25f - half), glm::vec3(2*half)));
+            bullets.back()->vel = glm::vec3(speed, 0, 0);
+            handler.add(bullets.back().get(), 1, false, run.fast);
+        }
+        bench::row(run.name, bullets.size(), bench::time_ns([&](){
+            for(unsigned int i = 0; i < run.steps; i++) handler(frame/run.steps);
+        }, frames));
+        unsigned int through = 0;
+        for(const std::unique_ptr<gmh::Polyhedron>& b: bullets) through += b->pos.x > 0;
+        std::cout << "  passed through the wall: " << through << std::endl;
+    }
+    return 0;
+}
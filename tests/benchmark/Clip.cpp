@@ -0,0 +1,32 @@
+#include "bench.hpp"
+#include "Graphics/geometry.hpp"
+
+// Candidate collection over every vertex, edge and face pair followed by an angular sort, as done before clipping.
+static gmh::Intersection collect(const gmh::Polygon& poly, const gmh::Polyhedron& obj){
+    if(poly.dist(obj) >= 1e-5) return {};
+    gmh::Intersection points;
+    for(std::shared_ptr<gmh::Point> p: poly.vertices) if(obj.contains(*p)) points.add(p->pos);
+    for(std::shared_ptr<gmh::LinSeg> edge: poly.edges){
+        for(std::shared_ptr<gmh::Polygon> face: obj.faces){
+            if(gmh::Intersection inter = edge->intersection(*face); inter.kind() == gmh::Intersection::Kind::Point) points.add(inter[0]);
+        }
+    }
+    for(std::shared_ptr<gmh::LinSeg> edge: obj.edges){
+        if(gmh::Intersection inter = poly.intersection(*edge); inter.kind() == gmh::Intersection::Kind::Point) points.add(inter[0]);
+    }
+    return points.resolve();
+}
+
+// A square cutting through sphere hulls of growing size, by candidate collection against Sutherland-Hodgman clipping.
+int main(){
+    gmh::Polygon square(glm::vec3(2, 2, 0.1), glm::vec3(-2, 2, 0.1), glm::vec3(2, -2, 0.1), glm::vec3(-2, -2, 0.1));
+    volatile unsigned int sink = 0;
+    for(unsigned int n: {20u, 100u, 400u}){
+        std::vector<glm::vec3> points = bench::sphere_points(n);
+        gmh::Polyhedron sphere(std::vector<gmh::Point>(points.begin(), points.end()));
+        std::cout << "Square through sphere hull, " << sphere.mesh().face_count() << " faces" << std::endl;
+        bench::row("collect + sort", n, bench::time_ns([&](){sink = sink + collect(square, sphere).size();}, 10));
+        bench::row("clip", n, bench::time_ns([&](){sink = sink + square.intersection(sphere).size();}, 10));
+    }
+    return 0;
+}
@@ -0,0 +1,50 @@
+#include "bench.hpp"
+#include "Graphics/gmath.hpp"
+#include "Graphics/log.hpp"
+
+// Recursive form that materialized every combination, as CHandler used before the lazy range.
+template <typename T, class iter>
+static std::vector<std::vector<T>> materialize(iter first, iter last, int k){
+    std::vector<std::vector<T>> out;
+    if(k == 1){
+        for(iter i = first; i != last; i++) out.emplace_back(std::vector<T>{*i});
+        return out;
+    }
+    for(iter i = first; i != last; i++){
+        std::vector<T> next;
+        for(std::vector<T> end: materialize<T>(std::next(i, 1), last, k-1)){
+            next = {*i};
+            next.insert(next.end(), end.begin(), end.end());
+            out.push_back(next);
+        }
+    }
+    return out;
+}
+
+// Stand in for Physical, of the same size.
+struct Body {
+    void* obj;
+    float mass;
+    bool fixed;
+    void* shape[2];
+};
+
+// Visiting every pair of a set of bodies, materialized against lazily generated.
+int main(){
+    volatile float sink = 0;
+    for(unsigned int n: {10u, 100u, 1000u}){
+        std::vector<Body> bodies(n, Body{nullptr, 1, false, {nullptr, nullptr}});
+        std::cout << "All pairs" << std::endl;
+        size_t before = allocations;
+        bench::row("materialized", n, bench::time_ns([&](){
+            for(const std::vector<Body>& v: materialize<Body>(bodies.begin(), bodies.end(), 2)) sink = sink + v[0].mass*v[1].mass;
+        }));
+        std::cout << std::setw(52) << allocations - before << " allocations" << std::endl;
+        before = allocations;
+        bench::row("lazy", n, bench::time_ns([&](){
+            for(auto [a, b]: gmh::combinations<2>(bodies.begin(), bodies.end())) sink = sink + a->mass*b->mass;
+        }));
+        std::cout << std::setw(52) << allocations - before << " allocations" << std::endl;
+    }
+    return 0;
+}
@@ -0,0 +1,63 @@
+#include <random>
+#include "bench.hpp"
+#include "Graphics/geometry.hpp"
+
+// Point to face distance recomputing the face normal and edge normals on every call, as done before cached plane equations.
+static float face_dist(const gmh::Mesh::Face& face, const glm::vec3& p){
+    glm::vec3 n = glm::normalize(glm::cross(face[1] - face[0], face[2] - face[0]));
+    unsigned int count = face.size();
+    for(unsigned int k = 0; k < count; k++){
+        const glm::vec3& a = face[k];
+        const glm::vec3& b = face[(k + 1)%count];
+        if(glm::dot(glm::cross(b - a, p - a), n) < 0){
+            float min = std::numeric_limits<float>::infinity();
+            for(unsigned int j = 0; j < count; j++){
+                glm::vec3 s = face[j], e = face[(j + 1)%count];
+                float t = glm::clamp(glm::dot(p - s, e - s)/glm::dot(e - s, e - s), 0.0f, 1.0f);
+                min = std::min(min, glm::distance(p, s + t*(e - s)));
+            }
+            return min;
+        }
+    }
+    return std::abs(glm::dot(n, p - face[0]));
+}
+
+static float solid_dist(const gmh::Mesh& m, const glm::vec3& p){
+    bool contained = true;
+    for(unsigned int i = 0; i < m.face_count() && contained; i++){
+        gmh::Mesh::Face face = m.face(i);
+        contained = glm::dot(glm::normalize(glm::cross(face[1] - face[0], face[2] - face[0])), p - face[0]) >= 0;
+    }
+    if(contained) return 0;
+    float min = std::numeric_limits<float>::infinity();
+    for(unsigned int i = 0; i < m.face_count(); i++) min = std::min(min, face_dist(m.face(i), p));
+    return min;
+}
+
+// Scenarios of the Polygon_Dist and Polyhedron_Dist tests, repeated over random query points.
+int main(){
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<float> dist(-3, 3);
+    std::vector<gmh::Point> queries(10000);
+    for(gmh::Point& q: queries) q.pos = glm::vec3(dist(gen), dist(gen), dist(gen));
+    volatile float sink = 0;
+
+    gmh::Polygon poly(glm::vec3(2, 2, 0), glm::vec3(-2, 2, 0), glm::vec3(2, -2, 0), glm::vec3(-2, -2, 0));
+    bench::row("Polygon, recomputed", 4, bench::time_ns([&](){for(const gmh::Point& q: queries) sink = sink + face_dist(poly.mesh().face(0), q.pos);}, 10));
+    bench::row("Polygon, cached", 4, bench::time_ns([&](){for(const gmh::Point& q: queries) sink = sink + q.dist(poly);}, 10));
+    bench::row("Polygon sign_dist", 4, bench::time_ns([&](){for(const gmh::Point& q: queries) sink = sink + poly.sign_dist(q);}, 10));
+
+    gmh::Polyhedron pyramid(glm::vec3(0, 0, 1), glm::vec3(-1, 1, 0), glm::vec3(1, -1, 0), glm::vec3(-1, -1, 0), glm::vec3(1, 1, 0));
+    bench::row("Polyhedron, recomputed", 5, bench::time_ns([&](){for(const gmh::Point& q: queries) sink = sink + solid_dist(pyramid.mesh(), q.pos);}, 10));
+    bench::row("Polyhedron, cached", 5, bench::time_ns([&](){for(const gmh::Point& q: queries) sink = sink + q.dist(pyramid);}, 10));
+
+    std::vector<glm::vec3> points = bench::sphere_points(200);
+    gmh::Polyhedron sphere(std::vector<gmh::Point>(points.begin(), points.end()));
+    bench::row("Polyhedron, recomputed", 200, bench::time_ns([&](){for(const gmh::Point& q: queries) sink = sink + solid_dist(sphere.mesh(), q.pos);}));
+    bench::row("Polyhedron, cached", 200, bench::time_ns([&](){for(const gmh::Point& q: queries) sink = sink + q.dist(sphere);}));
+
+    gmh::Polyhedron other(glm::vec3(2, 0, 2), glm::vec3(1, 1, 1), glm::vec3(3, -1, 1), glm::vec3(1, -1, 1), glm::vec3(3, 1, 1));
+    bench::row("Polyhedron to Polyhedron", 5, bench::time_ns([&](){sink = sink + pyramid.dist(other);}, 1000));
+    bench::row("Polygon to Polyhedron", 5, bench::time_ns([&](){sink = sink + poly.dist(other);}, 1000));
+    return 0;
+}
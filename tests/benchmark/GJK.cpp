@@ -0,0 +1,46 @@
+#include <glm/gtc/matrix_transform.hpp>
+#include "bench.hpp"
+#include "Graphics/geometry.hpp"
+#include "Graphics/gjk.hpp"
+
+// Distance between two hulls of n vertices sliding past each other, per frame.
+int main(){
+    const unsigned int frames = 100;
+    const glm::mat4 step = glm::translate(glm::mat4(1), glm::vec3(-0.04, 0, 0));
+    for(unsigned int n: {20u, 50u, 100u, 200u}){
+        std::vector<glm::vec3> points = bench::sphere_points(n);
+        std::vector<gmh::Point> vert(points.begin(), points.end());
+        gmh::Polyhedron a(vert);
+        std::vector<gmh::Point> vert2;
+        for(glm::vec3 p: bench::sphere_points(n, 1, glm::vec3(3, 0.5, 0.2))) vert2.emplace_back(p);
+        gmh::Polyhedron b(vert2);
+
+        volatile float sink = 0;
+        double legacy = bench::time_ns([&](){
+            for(unsigned int i = 0; i < frames; i++){
+                sink = sink + a.dist(b);
+                b.transform(step);
+            }
+            b.transform(glm::translate(glm::mat4(1), glm::vec3(0.04*frames, 0, 0)));
+        });
+        bench::row("Polyhedron::dist", n, legacy/frames);
+        double cold = bench::time_ns([&](){
+            for(unsigned int i = 0; i < frames; i++){
+                sink = sink + gmh::gjk(a, b).dist;
+                b.transform(step);
+            }
+            b.transform(glm::translate(glm::mat4(1), glm::vec3(0.04*frames, 0, 0)));
+        }, 10);
+        bench::row("gjk", n, cold/frames);
+        double warm = bench::time_ns([&](){
+            gmh::Simplex cache;
+            for(unsigned int i = 0; i < frames; i++){
+                sink = sink + gmh::gjk(a, b, &cache).dist;
+                b.transform(step);
+            }
+            b.transform(glm::translate(glm::mat4(1), glm::vec3(0.04*frames, 0, 0)));
+        }, 10);
+        bench::row("gjk, warm start", n, warm/frames);
+    }
+    return 0;
+}
@@ -0,0 +1,21 @@
+#include <random>
+#include "bench.hpp"
+#include "Graphics/geometry.hpp"
+#include "Graphics/hull.hpp"
+
+int main(){
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<float> dist(-1, 1);
+    for(unsigned int n: {8u, 16u, 64u, 256u, 1024u, 4096u, 10000u}){
+        std::vector<glm::vec3> sphere = bench::sphere_points(n);
+        std::vector<glm::vec3> cloud(n);
+        for(glm::vec3& p: cloud) p = glm::vec3(dist(gen), dist(gen), dist(gen));
+        std::vector<gmh::Point> vert(sphere.begin(), sphere.end());
+        unsigned int reps = std::max(1u, 20000u/n);
+        gmh::Hull h;
+        bench::row("quickhull (sphere)", n, bench::time_ns([&](){gmh::quickhull(sphere, h);}, reps));
+        bench::row("quickhull (cube cloud)", n, bench::time_ns([&](){gmh::quickhull(cloud, h);}, reps));
+        bench::row("Polyhedron(vector<Point>)", n, bench::time_ns([&](){gmh::Polyhedron p(vert);}, reps));
+    }
+    return 0;
+}
@@ -0,0 +1,70 @@
+#include <memory>
+#include <glm/gtc/matrix_transform.hpp>
+#include "bench.hpp"
+#include "Graphics/instance.hpp"
+#include "Graphics/log.hpp"
+
+// Memory allocated for many copies of one crate, as Polyhedra of their own, as Instances of a template and in an InstanceArray,
+// and the time of the queries a narrowphase asks of each.
+int main(){
+    const unsigned int count = 10000, reps = 10000;
+    std::vector<glm::vec3> corners{glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(1, 1, 0),
+        glm::vec3(0, 0, 1), glm::vec3(1, 0, 1), glm::vec3(0, 1, 1), glm::vec3(1, 1, 1)};
+    volatile float sink = 0;
+
+    size_t before = bytes_allocated;
+    std::vector<std::unique_ptr<gmh::Polyhedron>> built;
+    for(unsigned int i = 0; i < count; i++){
+        std::vector<gmh::Point> moved;
+        for(const glm::vec3& p: corners) moved.emplace_back(p + glm::vec3(2*i, 0, 0));
+        built.push_back(std::make_unique<gmh::Polyhedron>(moved));
+    }
+    size_t polyhedra = bytes_allocated - before;
+
+    before = bytes_allocated;
+    std::shared_ptr<const gmh::ShapeTemplate> crate = gmh::ShapeTemplate::make(corners);
+    std::vector<gmh::Instance> placed;
+    placed.reserve(count);
+    for(unsigned int i = 0; i < count; i++) placed.emplace_back(crate, glm::translate(glm::mat4(1), glm::vec3(2*i, 0, 0)));
+    size_t instances = bytes_allocated - before;
+
+    before = bytes_allocated;
+    gmh::InstanceArray scenery(crate);
+    scenery.reserve(count);
+    for(unsigned int i = 0; i < count; i++) scenery.add(glm::translate(glm::mat4(1), glm::vec3(2*i, 0, 0)));
+    size_t arrays = bytes_allocated - before;
+
+    std::cout << count << " crates" << std::endl;
+    std::cout << std::setw(52) << polyhedra/1024 << " KiB allocated building Polyhedra, " << sizeof(gmh::Polyhedron) << " B each before its vectors" << std::endl;
+    std::cout << std::setw(52) << instances/1024 << " KiB allocated placing Instances, " << sizeof(gmh::Instance) << " B each" << std::endl;
+    std::cout << std::setw(52) << arrays/1024 << " KiB allocated placing them in an InstanceArray, " << scenery.footprint()/1024 << " KiB held" << std::endl;
+
+    gmh::Point probe(glm::vec3(0.5, 0.5, 3));
+    glm::mat4 spin = glm::rotate(glm::mat4(1), 0.01f, glm::vec3(0, 0, 1));
+    std::cout << "Per query" << std::endl;
+    bench::row("Polyhedron support", 8, bench::time_ns([&](){sink = sink + built[0]->support(glm::vec3(1, 2, 3)).x;}, reps));
+    bench::row("Instance support", 8, bench::time_ns([&](){sink = sink + placed[0].support(glm::vec3(1, 2, 3)).x;}, reps));
+    bench::row("Polyhedron dist", 8, bench::time_ns([&](){sink = sink + built[0]->dist(probe);}, reps));
+    bench::row("Instance dist", 8, bench::time_ns([&](){sink = sink + placed[0].dist(probe);}, reps));
+    bench::row("Polyhedron rotate, dist", 8, bench::time_ns([&](){
+        built[1]->transform(spin);
+        sink = sink + built[1]->dist(probe);
+    }, reps));
+    bench::row("Instance rotate, dist", 8, bench::time_ns([&](){
+        placed[1].transform(spin);
+        sink = sink + placed[1].dist(probe);
+    }, reps));
+
+    gmh::LinSeg seg(gmh::Point(glm::vec3(0.5, 0.5, -1)), gmh::Point(glm::vec3(0.7, 0.4, 2)));
+    gmh::Polyhedron near = *built[0];
+    near.translate(glm::vec3(0.5, 0.3, 0.2));
+    near.sync();
+    bench::row("Polyhedron intersect segment", 8, bench::time_ns([&](){sink = sink + built[0]->intersection(seg).size();}, reps));
+    bench::row("Instance intersect segment", 8, bench::time_ns([&](){sink = sink + placed[0].intersection(seg).size();}, reps));
+    bench::row("Polyhedron intersect solid", 8, bench::time_ns([&](){sink = sink + built[0]->intersection(near).size();}, reps));
+    bench::row("Instance intersect solid", 8, bench::time_ns([&](){sink = sink + placed[0].intersection(near).size();}, reps));
+    before = allocations;
+    for(unsigned int i = 0; i < reps; i++) sink = sink + placed[0].intersection(seg).size() + placed[0].intersection(near).size();
+    std::cout << std::setw(52) << allocations - before << " allocations in " << 2*reps << " Instance intersections" << std::endl;
+    return 0;
+}
@@ -0,0 +1,40 @@
+#include "bench.hpp"
+#include "Graphics/geometry.hpp"
+#include "Graphics/log.hpp"
+
+// Heap allocations and time per call of the value returning intersection() against the unique_ptr returning intersect().
+template<typename T1, typename T2>
+static void run(const char* label, const T1& obj1, const T2& obj2){
+    const unsigned int reps = 10000;
+    volatile unsigned int sink = 0;
+    size_t before = allocations;
+    double ns = bench::time_ns([&](){sink = sink + obj1.intersection(obj2).size();}, reps);
+    double value = static_cast<double>(allocations - before)/reps;
+    before = allocations;
+    double ns_ptr = bench::time_ns([&](){sink = sink + static_cast<bool>(obj1.intersect(obj2));}, reps);
+    double ptr = static_cast<double>(allocations - before)/reps;
+    std::cout << label << std::endl;
+    unsigned int n = obj1.intersection(obj2).size();
+    bench::row("intersection()", n, ns);
+    std::cout << std::setw(52) << std::setprecision(2) << value << " allocations" << std::endl;
+    bench::row("intersect()", n, ns_ptr);
+    std::cout << std::setw(52) << std::setprecision(2) << ptr << " allocations" << std::endl;
+}
+
+int main(){
+    gmh::Polyhedron cube(glm::vec3(1, 1, 1), glm::vec3(1, 1, -1), glm::vec3(1, -1, 1), glm::vec3(1, -1, -1),
+        glm::vec3(-1, 1, 1), glm::vec3(-1, 1, -1), glm::vec3(-1, -1, 1), glm::vec3(-1, -1, -1));
+    gmh::Polygon poly(glm::vec3(2, 2, 0), glm::vec3(-2, 2, 0), glm::vec3(2, -2, 0), glm::vec3(-2, -2, 0));
+    gmh::Plane plane(glm::vec3(0, 0, 0.5), glm::vec3(1, 0, 0.5), glm::vec3(0, 1, 0.5));
+    gmh::Line line(glm::vec3(0, 0, -1), glm::vec3(0.5, 0.5, 1));
+    gmh::LinSeg seg1(glm::vec3(-2, 0, 0), glm::vec3(2, 0, 0));
+    gmh::LinSeg seg2(glm::vec3(0, -2, 0), glm::vec3(0, 2, 0));
+
+    run("LinSeg, LinSeg (point)", seg1, seg2);
+    run("Line, Plane (point)", line, plane);
+    run("Line, Polygon (point)", line, poly);
+    run("LinSeg, Polygon (segment)", seg1, poly);
+    run("Polyhedron, LinSeg (segment)", cube, seg1);
+    run("Plane, Polyhedron (polygon)", plane, cube);
+    return 0;
+}
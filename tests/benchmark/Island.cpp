@@ -0,0 +1,34 @@
+#include <cmath>
+#include "bench.hpp"
+#include "Graphics/collision.hpp"
+#include "scene.hpp"
+
+// Stacks of resting crates on a floor plus 100 drifting ones, stepped with and without sleeping.
+int main(){
+    const unsigned int awake = 100, frames = 10;
+    for(unsigned int n: {1000u, 4000u, 10000u}){
+        unsigned int side = std::ceil(std::sqrt(n/4.0f));
+        float extent = 1.2f*side + 20;
+        gmh::Polyhedron floor(glm::vec3(-extent, -extent, -1), glm::vec3(extent, -extent, -1), glm::vec3(-extent, extent, -1), glm::vec3(extent, extent, -1),
+            glm::vec3(-extent, -extent, 0), glm::vec3(extent, -extent, 0), glm::vec3(-extent, extent, 0), glm::vec3(extent, extent, 0));
+        std::vector<std::unique_ptr<gmh::Polyhedron>> crates;
+        for(unsigned int i = 0; i < n; i++) crates.push_back(scene::crate(glm::vec3(1.2f*(i/4%side), 1.2f*(i/4/side), i%4)));
+        for(unsigned int i = 0; i < awake; i++){
+            crates.push_back(scene::crate(glm::vec3(-3.0f*(i%10) - 5, -3.0f*(i/10) - 5, 5)));
+            crates.back()->vel = glm::vec3(0.3, 0.2, 0.1);
+        }
+        std::cout << "Crate stacks, " << awake << " awake, per frame" << std::endl;
+        for(bool sleep: {false, true}){
+            gmh::CHandler handler(0.5, 1);
+            handler.sleeping(0.05, sleep ? 2:0);
+            handler.add(&floor, 1, true);
+            for(std::unique_ptr<gmh::Polyhedron>& c: crates) handler.add(c.get());
+            for(unsigned int i = 0; i < 3; i++) handler();
+            bench::row(sleep ? "sleeping" : "all awake", n + awake, bench::time_ns([&](){
+                for(unsigned int i = n; i < crates.size(); i++) crates[i]->update(1/60.f);
+                handler();
+            }, frames));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,42 @@
+#include <cmath>
+#include "bench.hpp"
+#include "Graphics/collision.hpp"
+
+// Resting towers of 32 sided prisms, resolving every touching pair from scratch as CHandler did
+// before the manifold cache, against reusing each pair's cached manifold.
+int main(){
+    const unsigned int towers = 16, height = 8, sides = 32;
+    std::vector<std::unique_ptr<gmh::Polyhedron>> prisms;
+    gmh::CHandler handler(0.5, 1);
+    std::vector<gmh::BodyId> ids;
+    for(unsigned int t = 0; t < towers; t++){
+        for(unsigned int h = 0; h < height; h++){
+            std::vector<gmh::Point> vert;
+            for(unsigned int k = 0; k < sides; k++){
+                float a = k*2*glm::pi<float>()/sides;
+                glm::vec3 p(3.0f*t + std::cos(a), std::sin(a), h);
+                vert.emplace_back(p);
+                vert.emplace_back(p + glm::vec3(0, 0, 1));
+            }
+            prisms.push_back(std::make_unique<gmh::Polyhedron>(vert));
+            ids.push_back(handler.add(prisms.back().get(), 1, h == 0));
+        }
+    }
+    handler();
+    std::vector<std::pair<gmh::Physical*, gmh::Physical*>> pairs;
+    std::vector<gmh::Manifold> cached;
+    for(unsigned int i = 0; i + 1 < ids.size(); i++){
+        if((i + 1)%height == 0) continue;
+        pairs.emplace_back(handler.get(ids[i]), handler.get(ids[i + 1]));
+        cached.push_back(*handler.manifold(ids[i], ids[i + 1]));
+    }
+    std::cout << "Prism towers, " << pairs.size() << " resting pairs" << std::endl;
+    bench::row("full derivation", pairs.size(), bench::time_ns([&](){
+        for(auto& [a, b]: pairs) handler.collision(*a, *b);
+    }, 10));
+    bench::row("cached manifold", pairs.size(), bench::time_ns([&](){
+        for(unsigned int i = 0; i < pairs.size(); i++) handler.collision(*pairs[i].first, *pairs[i].second, cached[i]);
+    }, 10));
+    bench::row("CHandler step", ids.size(), bench::time_ns([&](){handler();}, 10));
+    return 0;
+}
@@ -0,0 +1,76 @@
+#include <random>
+#include "bench.hpp"
+#include "Graphics/geometry.hpp"
+#include "Graphics/log.hpp"
+#include "Graphics/hash.hpp"
+
+// Point to Polyhedron distance walking the shared_ptr face and edge graph, as done before Mesh.
+static float graph_dist(const gmh::Point& p, const gmh::Polyhedron& obj){
+    bool contained = std::all_of(obj.faces.begin(), obj.faces.end(), [&p](std::shared_ptr<gmh::Polygon> face){
+        return face->sign_dist(p) >= 0;
+    });
+    if(contained) return 0;
+    std::vector<float> distances(obj.faces.size());
+    std::transform(obj.faces.begin(), obj.faces.end(), distances.begin(), [&p](std::shared_ptr<gmh::Polygon> face){
+        for(std::shared_ptr<gmh::LinSeg> edge: face->edges)
+            if(glm::dot(glm::cross(edge->vertices[1]->pos - edge->vertices[0]->pos, p.pos - edge->vertices[0]->pos), face->normVec()) < 0){
+                std::vector<float> d(face->edges.size());
+                std::transform(face->edges.begin(), face->edges.end(), d.begin(), [&p](std::shared_ptr<gmh::LinSeg> lin){
+                    return p.dist(*lin);
+                });
+                return *std::min_element(d.begin(), d.end());
+            }
+        return std::abs(glm::dot(face->normVec(), p.pos - face->vertices[0]->pos));
+    });
+    return *std::min_element(distances.begin(), distances.end());
+}
+
+// Resident size of the shared_ptr representation, counting make_shared control blocks,
+// with the faces as they were before Mesh. Builds the graph if it was not yet.
+static size_t graph_footprint(const gmh::Polyhedron& poly){
+    const size_t block = 2*sizeof(long);
+    size_t total = sizeof(gmh::Polyhedron) + poly.vertices.capacity()*sizeof(std::shared_ptr<gmh::Point>);
+    total += poly.vertices.size()*(sizeof(gmh::Point) + block);
+    total += poly.edges.capacity()*sizeof(std::shared_ptr<gmh::LinSeg>) + poly.faces.capacity()*sizeof(std::shared_ptr<gmh::Polygon>);
+    for(std::shared_ptr<gmh::Polygon> face: poly.faces){
+        total += sizeof(gmh::Polygon) + block - sizeof(gmh::Mesh);
+        total += face->vertices.capacity()*sizeof(std::shared_ptr<gmh::Point>) + face->edges.capacity()*sizeof(std::shared_ptr<gmh::LinSeg>);
+        total += face->edges.size()*(sizeof(gmh::LinSeg) + block + 2*sizeof(std::shared_ptr<gmh::Point>));
+    }
+    return total;
+}
+
+int main(){
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<float> dist(-2, 2);
+    std::vector<gmh::Point> queries(1000);
+    for(gmh::Point& q: queries) q.pos = glm::vec3(dist(gen), dist(gen), dist(gen));
+    // A Polyhedron built from values holds only its Mesh until vertices, edges or faces
+    // is first called, which then adds the shared_ptr graph and a Mesh for every face.
+    std::cout << "Footprint (bytes)" << std::endl;
+    for(unsigned int n: {8u, 64u, 512u}){
+        std::vector<glm::vec3> points = n == 8 ? std::vector<glm::vec3>{} : bench::sphere_points(n);
+        if(n == 8) for(int i = 0; i < 8; i++) points.emplace_back(i&1, (i>>1)&1, (i>>2)&1);
+        std::vector<gmh::Point> vert(points.begin(), points.end());
+        size_t before = allocations;
+        gmh::Polyhedron poly(vert);
+        size_t built = allocations - before;
+        before = allocations;
+        volatile size_t hashed = std::hash<gmh::Point>()(poly);
+        size_t hashing = allocations - before;
+        size_t mesh = sizeof(gmh::Polyhedron) - sizeof(gmh::Mesh) + poly.mesh().footprint();
+        before = allocations;
+        size_t graph = graph_footprint(poly);
+        size_t expanded = allocations - before;
+        size_t faces = 0;
+        for(std::shared_ptr<gmh::Polygon> face: poly.faces) faces += face->mesh().footprint();
+        std::cout << std::setw(8) << n << " vertices:  shared_ptr graph " << std::setw(10) << graph << "   Mesh " << std::setw(8) << mesh;
+        std::cout << "   both " << std::setw(10) << graph + mesh - sizeof(gmh::Polyhedron) + faces;
+        std::cout << "   (" << built << " allocations to construct, " << hashing << " to hash, " << expanded << " more for the graph)" << std::endl;
+
+        volatile float sink = 0;
+        bench::row("dist, shared_ptr graph", n, bench::time_ns([&](){for(const gmh::Point& q: queries) sink = sink + graph_dist(q, poly);}));
+        bench::row("dist, Mesh", n, bench::time_ns([&](){for(const gmh::Point& q: queries) sink = sink + q.dist(poly);}));
+    }
+    return 0;
+}
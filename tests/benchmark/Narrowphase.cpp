@@ -0,0 +1,25 @@
+#include "bench.hpp"
+#include "Graphics/collision.hpp"
+
+// Sphere hulls on alternate cells of a grid, so each has twelve neighbours with overlapping boxes
+// for GJK to separate, stepped through CHandler on a growing number of threads.
+int main(){
+    const unsigned int side = 16, frames = 10;
+    std::vector<glm::vec3> points = bench::sphere_points(64, 0.6);
+    std::vector<std::unique_ptr<gmh::Polyhedron>> bodies;
+    for(unsigned int i = 0; i < side*side*side; i++){
+        if((i%side + i/side%side + i/side/side)%2) continue;
+        glm::vec3 c(i%side, i/side%side, i/side/side);
+        std::vector<gmh::Point> vert;
+        for(const glm::vec3& p: points) vert.emplace_back(c + p);
+        bodies.push_back(std::make_unique<gmh::Polyhedron>(vert));
+    }
+    std::cout << "Sphere hull grid, " << bodies.size() << " bodies, per frame" << std::endl;
+    for(unsigned int threads: {1u, 2u, 4u, 8u, 16u, 32u}){
+        gmh::CHandler handler(0.5, threads);
+        for(std::unique_ptr<gmh::Polyhedron>& body: bodies) handler.add(body.get());
+        handler();
+        bench::row("threads", threads, bench::time_ns([&](){handler();}, frames));
+    }
+    return 0;
+}
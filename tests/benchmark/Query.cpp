@@ -0,0 +1,65 @@
+#include <random>
+#include <glm/gtc/matrix_transform.hpp>
+#include "bench.hpp"
+#include "Graphics/query.hpp"
+#include "Graphics/instance.hpp"
+
+// A field of crates queried through SceneQuery. Rays, nearest shapes and overlaps each visit a
+// handful of leaves, where testing every crate costs a pass over the whole scene.
+int main(){
+    const unsigned int rays = 100000, probes = 10000;
+    std::shared_ptr<const gmh::ShapeTemplate> crate = gmh::ShapeTemplate::make({glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(1, 1, 0),
+        glm::vec3(0, 0, 1), glm::vec3(1, 0, 1), glm::vec3(0, 1, 1), glm::vec3(1, 1, 1)});
+    volatile float sink = 0;
+    std::cout << "Scene queries over crate instances" << std::endl;
+    for(unsigned int count: {1000u, 10000u, 100000u}){
+        std::mt19937 gen(1);
+        float side = 4*std::cbrt(static_cast<float>(count));
+        std::uniform_real_distribution<float> spread(-side/2, side/2), angle(0, 6.3f);
+        std::vector<gmh::Instance> crates;
+        crates.reserve(count);
+        for(unsigned int i = 0; i < count; i++)
+            crates.emplace_back(crate, glm::rotate(glm::translate(glm::mat4(1), glm::vec3(spread(gen), spread(gen), spread(gen))), angle(gen), glm::vec3(1, 2, 3)));
+        std::vector<const gmh::Point*> shapes;
+        for(const gmh::Instance& obj: crates) shapes.push_back(&obj);
+
+        gmh::SceneQuery scene;
+        bench::row("build", count, bench::time_ns([&](){scene.build(shapes);}));
+        std::vector<glm::vec3> origins(rays), dirs(rays);
+        for(unsigned int i = 0; i < rays; i++){
+            origins[i] = glm::vec3(spread(gen), spread(gen), spread(gen));
+            dirs[i] = glm::normalize(glm::vec3(spread(gen), spread(gen), spread(gen)));
+        }
+        bench::row("raycast", count, bench::time_ns([&](){
+            for(unsigned int i = 0; i < rays; i++) sink = sink + scene.raycast(origins[i], dirs[i]).dist;
+        })/rays);
+        bench::row("raycast every crate", count, bench::time_ns([&](){
+            for(unsigned int i = 0; i < 10; i++){
+                float best = std::numeric_limits<float>::infinity();
+                for(const gmh::Point* obj: shapes) best = std::min(best, gmh::raycast(gmh::shape(*obj), origins[i], dirs[i]).dist);
+                sink = sink + best;
+            }
+        })/10);
+        bench::row("nearest", count, bench::time_ns([&](){
+            for(unsigned int i = 0; i < probes; i++) sink = sink + (scene.nearest(origins[i]) != nullptr);
+        })/probes);
+        std::vector<const gmh::Point*> found;
+        bench::row("overlap box", count, bench::time_ns([&](){
+            for(unsigned int i = 0; i < probes; i++){
+                found.clear();
+                scene.overlap(gmh::AABB{origins[i] - 2.0f, origins[i] + 2.0f}, found);
+                sink = sink + found.size();
+            }
+        })/probes);
+        bench::row("overlap sphere", count, bench::time_ns([&](){
+            for(unsigned int i = 0; i < probes; i++){
+                found.clear();
+                scene.overlap(gmh::Sphere{origins[i], 2}, found);
+                sink = sink + found.size();
+            }
+        })/probes);
+        for(gmh::Instance& obj: crates) obj.translate(glm::vec3(0.1, 0, 0));
+        bench::row("refit", count, bench::time_ns([&](){scene.refit();}));
+    }
+    return 0;
+}
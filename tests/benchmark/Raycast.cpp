@@ -0,0 +1,73 @@
+#include <random>
+#include "bench.hpp"
+#include "Graphics/geometry.hpp"
+#include "Graphics/batch.hpp"
+#include "Graphics/query.hpp"
+
+static const char* name(gmh::SimdLevel level){
+    switch(level){
+        case gmh::SimdLevel::AVX2: return "raycast_many, AVX2";
+        case gmh::SimdLevel::SSE: return "raycast_many, SSE";
+        default: return "raycast_many, scalar";
+    }
+}
+
+static void rate(const char* label, unsigned int n, double ns, unsigned int rays){
+    bench::row(label, n, ns);
+    std::cout << std::setw(52) << std::setprecision(2) << rays/ns*1e3 << " Mrays/s" << std::endl;
+}
+
+// Rays per second cast at one shape: Line::intersect, which allocates the points it finds, the
+// allocation free per ray raycast(), and raycast_many at each level.
+template<typename T>
+static void run(const char* label, const T& obj, unsigned int n, const std::vector<float> (&ray)[7]){
+    const unsigned int count = ray[0].size(), slow = 2000;
+    std::vector<float> hit[4];
+    for(std::vector<float>& h: hit) h.resize(count);
+    gmh::RaySpan rays{ray[0].data(), ray[1].data(), ray[2].data(), ray[3].data(), ray[4].data(), ray[5].data(), ray[6].data(), count};
+    gmh::HitSpan hits{hit[0].data(), hit[1].data(), hit[2].data(), hit[3].data()};
+    volatile float sink = 0;
+    std::cout << label << std::endl;
+    rate("Line::intersect", n, bench::time_ns([&](){
+        for(unsigned int i = 0; i < slow; i++){
+            glm::vec3 o(ray[0][i], ray[1][i], ray[2][i]), d(ray[3][i], ray[4][i], ray[5][i]);
+            sink = sink + (gmh::Line(gmh::Point(o), gmh::Point(o + d)).intersect(obj) != nullptr);
+        }
+    }), slow);
+    rate("raycast", n, bench::time_ns([&](){
+        for(unsigned int i = 0; i < count; i++){
+            glm::vec3 o(ray[0][i], ray[1][i], ray[2][i]), d(ray[3][i], ray[4][i], ray[5][i]);
+            sink = sink + gmh::raycast(gmh::shape(obj), o, d, ray[6][i]).dist;
+        }
+    }), count);
+    for(gmh::SimdLevel level: {gmh::SimdLevel::Scalar, gmh::SimdLevel::SSE, gmh::SimdLevel::AVX2}){
+        if(level > gmh::simd_supported()) continue;
+        gmh::simd_level(level);
+        rate(name(level), n, bench::time_ns([&](){gmh::raycast_many(obj, rays, hits); sink = sink + hit[0][0];}, 5), count);
+    }
+    gmh::simd_level(gmh::simd_supported());
+}
+
+int main(){
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<float> dist(-1, 1);
+    std::vector<float> ray[7];
+    for(unsigned int i = 0; i < 100000; i++){
+        glm::vec3 o = 3.0f*glm::normalize(glm::vec3(dist(gen), dist(gen), dist(gen)));
+        glm::vec3 d = glm::normalize(glm::vec3(dist(gen), dist(gen), dist(gen)) - o);
+        for(unsigned int k = 0; k < 3; k++){
+            ray[k].push_back(o[k]);
+            ray[k + 3].push_back(d[k]);
+        }
+        ray[6].push_back(std::numeric_limits<float>::infinity());
+    }
+
+    gmh::Polygon poly(glm::vec3(1, 1, 0), glm::vec3(-1, 1, 0), glm::vec3(1, -1, 0), glm::vec3(-1, -1, 0));
+    run("Polygon, 100000 rays", poly, 4, ray);
+    for(unsigned int n: {8u, 32u, 128u}){
+        std::vector<glm::vec3> vert = bench::sphere_points(n);
+        gmh::Polyhedron sphere(std::vector<gmh::Point>(vert.begin(), vert.end()));
+        run("Polyhedron, 100000 rays", sphere, n, ray);
+    }
+    return 0;
+}
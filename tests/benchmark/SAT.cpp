@@ -0,0 +1,34 @@
+#include <cmath>
+#include "bench.hpp"
+#include "Graphics/collision.hpp"
+
+// Towers of 32 sided prisms, either resting on each other or stacked with gaps small enough for
+// their bounds to overlap, stepped with each contact method.
+int main(){
+    const unsigned int towers = 16, height = 8, sides = 32;
+    struct Run {const char* name; gmh::ContactMethod method;};
+    for(float gap: {0.0f, 1.5e-5f}){
+        std::cout << "Prism towers, " << (gap > 0 ? "apart" : "resting") << ", per step" << std::endl;
+        for(Run run: {Run{"clip", gmh::ContactMethod::Clip}, Run{"sat", gmh::ContactMethod::SAT}}){
+            std::vector<std::unique_ptr<gmh::Polyhedron>> prisms;
+            gmh::CHandler handler(0.5, 1);
+            handler.contact_method(run.method);
+            for(unsigned int t = 0; t < towers; t++){
+                for(unsigned int h = 0; h < height; h++){
+                    std::vector<gmh::Point> vert;
+                    for(unsigned int k = 0; k < sides; k++){
+                        float a = k*2*glm::pi<float>()/sides;
+                        glm::vec3 p(3.0f*t + std::cos(a), std::sin(a), h*(1 + gap));
+                        vert.emplace_back(p);
+                        vert.emplace_back(p + glm::vec3(0, 0, 1));
+                    }
+                    prisms.push_back(std::make_unique<gmh::Polyhedron>(vert));
+                    handler.add(prisms.back().get(), 1, h == 0);
+                }
+            }
+            handler();
+            bench::row(run.name, prisms.size(), bench::time_ns([&](){handler();}, 10));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,61 @@
+#include <random>
+#include "bench.hpp"
+#include "Graphics/shape.hpp"
+
+// Virtual dist() on a base pointer only sees the static type of its argument, so generic code resolved it by dynamic_cast first.
+static float cast_dist(const gmh::Point* a, const gmh::Point* b){
+    if(const gmh::Polyhedron* p = dynamic_cast<const gmh::Polyhedron*>(b)) return a->dist(*p);
+    if(const gmh::Polygon* p = dynamic_cast<const gmh::Polygon*>(b)) return a->dist(*p);
+    if(const gmh::Plane* p = dynamic_cast<const gmh::Plane*>(b)) return a->dist(*p);
+    if(const gmh::LinSeg* p = dynamic_cast<const gmh::LinSeg*>(b)) return a->dist(*p);
+    if(const gmh::Line* p = dynamic_cast<const gmh::Line*>(b)) return a->dist(*p);
+    return a->dist(*b);
+}
+
+// Distance between every pair of a mixed scene of shapes, by dynamic_cast and vtable against Shape handles.
+int main(){
+    std::mt19937 gen(1);
+    std::uniform_real_distribution<float> dist(-10, 10);
+    std::vector<gmh::Point> points;
+    std::vector<gmh::LinSeg> segs;
+    std::vector<gmh::Polygon> polys;
+    std::vector<std::unique_ptr<gmh::Polyhedron>> solids;
+    const unsigned int n = 16;
+    points.reserve(n);
+    segs.reserve(n);
+    polys.reserve(n);
+    for(unsigned int i = 0; i < n; i++){
+        glm::vec3 c(dist(gen), dist(gen), dist(gen));
+        points.emplace_back(c);
+        segs.emplace_back(c, c + glm::vec3(1, 0.5, 0));
+        polys.emplace_back(c, c + glm::vec3(1, 0, 0), c + glm::vec3(0, 1, 0));
+        std::vector<glm::vec3> vert = bench::sphere_points(12, 1, c);
+        solids.push_back(std::make_unique<gmh::Polyhedron>(std::vector<gmh::Point>(vert.begin(), vert.end())));
+    }
+    std::vector<const gmh::Point*> objects;
+    for(unsigned int i = 0; i < n; i++){
+        objects.push_back(&points[i]);
+        objects.push_back(&segs[i]);
+        objects.push_back(&polys[i]);
+        objects.push_back(solids[i].get());
+    }
+    std::vector<gmh::Shape> shapes;
+    for(const gmh::Point* obj: objects) shapes.push_back(gmh::shape(*obj));
+    std::vector<float> out(shapes.size());
+    volatile float sink = 0;
+    unsigned int pairs = objects.size()*objects.size();
+
+    bench::row("dynamic_cast + virtual", pairs, bench::time_ns([&](){
+        for(const gmh::Point* a: objects) for(const gmh::Point* b: objects) sink = sink + cast_dist(a, b);
+    }, 5));
+    bench::row("Shape", pairs, bench::time_ns([&](){
+        for(const gmh::Shape& a: shapes) for(const gmh::Shape& b: shapes) sink = sink + gmh::dist(a, b);
+    }, 5));
+    bench::row("Shape dist_many", pairs, bench::time_ns([&](){
+        for(const gmh::Shape& a: shapes){
+            gmh::dist_many(a, shapes.data(), shapes.size(), out.data());
+            sink = sink + out[0];
+        }
+    }, 5));
+    return 0;
+}
@@ -0,0 +1,32 @@
+#include <cmath>
+#include "bench.hpp"
+#include "Graphics/world.hpp"
+#include "scene.hpp"
+
+// Snapshot and restore of a world of drifting crates, a tenth of which touch a neighbour and so
+// have their vertices moved by each step.
+int main(){
+    for(unsigned int n: {1000u, 10000u}){
+        unsigned int side = std::ceil(std::cbrt(n));
+        std::vector<std::unique_ptr<gmh::Polyhedron>> crates;
+        gmh::PhysicsWorld world(1/60.f, 0.5, 1);
+        for(unsigned int i = 0; i < n; i++){
+            crates.push_back(scene::crate(2.0f*glm::vec3(i%side, i/side%side, i/side/side) + glm::vec3(i%10 == 0 ? 1.0f:0.0f, 0, 0)));
+            world.velocity(world.add(crates.back().get()), glm::vec3(0.1f, 0.05f, 0));
+        }
+        world.step();
+        gmh::Snapshot saved;
+        world.snapshot(saved);
+        std::cout << "Crates, " << n << " bodies" << std::endl;
+        bench::row("snapshot", n, bench::time_ns([&](){world.snapshot(saved);}, 20));
+        std::cout << "    " << saved.size()/1024 << " KiB" << std::endl;
+        bench::row("restore, unchanged", n, bench::time_ns([&](){world.restore(saved);}, 20));
+        double ns = 0;
+        for(unsigned int r = 0; r < 20; r++){
+            world.step();
+            ns += bench::time_ns([&](){world.restore(saved);});
+        }
+        bench::row("restore after a step", n, ns/20);
+    }
+    return 0;
+}
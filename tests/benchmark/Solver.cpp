@@ -0,0 +1,40 @@
+#include <cmath>
+#include "bench.hpp"
+#include "Graphics/collision.hpp"
+#include "scene.hpp"
+
+// Towers of crates on a floor under gravity, which the solver has to hold up every frame. Reports
+// the time per frame and how far the towers have sunk, ie how much speed the solver failed to remove.
+int main(){
+    const unsigned int side = 8, height = 8, frames = 60;
+    const float dt = 1/60.f, gravity = 9.8f;
+    struct Run {const char* name; unsigned int iterations, substeps, threads;};
+    std::cout << "Crate towers under gravity, per frame" << std::endl;
+    for(Run run: {Run{"1 iteration", 1, 1, 1}, Run{"1 iteration, 8 substeps", 1, 8, 1},
+                  Run{"8 iterations", 8, 1, 1}, Run{"8 iterations, 4 threads", 8, 1, 4}}){
+        gmh::Polyhedron floor(glm::vec3(-1, -1, -1), glm::vec3(2*side, -1, -1), glm::vec3(-1, 2*side, -1), glm::vec3(2*side, 2*side, -1),
+            glm::vec3(-1, -1, 0), glm::vec3(2*side, -1, 0), glm::vec3(-1, 2*side, 0), glm::vec3(2*side, 2*side, 0));
+        std::vector<std::unique_ptr<gmh::Polyhedron>> crates;
+        gmh::CHandler handler(0, run.threads);
+        handler.iterations(run.iterations);
+        handler.sleeping(0.05, 0);
+        handler.add(&floor, 1, true);
+        for(unsigned int i = 0; i < side*side*height; i++){
+            crates.push_back(scene::crate(glm::vec3(2.0f*(i/height%side), 2.0f*(i/height/side), i%height)));
+            handler.add(crates.back().get());
+        }
+        double ns = bench::time_ns([&](){
+            float h = dt/run.substeps;
+            for(unsigned int s = 0; s < run.substeps; s++){
+                for(std::unique_ptr<gmh::Polyhedron>& c: crates) c->vel.z -= gravity*h;
+                handler();
+                for(std::unique_ptr<gmh::Polyhedron>& c: crates) c->update(h);
+            }
+        }, frames);
+        bench::row(run.name, crates.size(), ns);
+        float sunk = 0;
+        for(unsigned int i = height - 1; i < crates.size(); i += height) sunk += height - 0.5f - crates[i]->pos.z;
+        std::cout << "    top crates sunk by " << std::setprecision(4) << sunk/(side*side) << std::endl;
+    }
+    return 0;
+}
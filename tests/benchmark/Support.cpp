@@ -0,0 +1,35 @@
+#include <cmath>
+#include "bench.hpp"
+#include "Graphics/geometry.hpp"
+
+// Linear scan over every vertex, as done before half-edge hill climbing.
+static unsigned int scan(const gmh::Mesh& m, const glm::vec3& dir){
+    unsigned int best = 0;
+    for(unsigned int i = 1; i < m.verts.size(); i++)
+        if(glm::dot(m.verts[i], dir) > glm::dot(m.verts[best], dir)) best = i;
+    return best;
+}
+
+// Support queries on sphere hulls of growing size, from a cold start and along a slowly rotating direction.
+int main(){
+    const unsigned int steps = 10000;
+    std::vector<glm::vec3> dirs(steps), random(steps);
+    for(unsigned int i = 0; i < steps; i++){
+        dirs[i] = glm::vec3(std::cos(i*0.001f), std::sin(i*0.001f), std::sin(i*0.0007f));
+        random[i] = glm::vec3(std::cos(i*0.7f), std::sin(i*1.3f), std::cos(i*2.1f));
+    }
+    volatile unsigned int sink = 0;
+    for(unsigned int n: {100u, 1000u, 4000u}){
+        std::vector<glm::vec3> points = bench::sphere_points(n);
+        gmh::Polyhedron sphere(std::vector<gmh::Point>(points.begin(), points.end()));
+        const gmh::Mesh& m = sphere.mesh();
+        std::cout << "Sphere hull, " << steps << " queries" << std::endl;
+        bench::row("scan", n, bench::time_ns([&](){for(const glm::vec3& d: dirs) sink = sink + scan(m, d);}));
+        bench::row("hill climb, cold", n, bench::time_ns([&](){for(const glm::vec3& d: random) sink = sink + m.support(d);}));
+        bench::row("hill climb, coherent", n, bench::time_ns([&](){
+            unsigned int start = 0;
+            for(const glm::vec3& d: dirs) sink = sink + (start = m.support(d, start));
+        }));
+    }
+    return 0;
+}
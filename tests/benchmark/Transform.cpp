@@ -0,0 +1,36 @@
+#include <glm/gtc/matrix_transform.hpp>
+#include "bench.hpp"
+#include "Graphics/geometry.hpp"
+
+// Moving a sphere hull every frame, with its vertices brought up to date on every move as
+// before, and left pending until a query needs them.
+int main(){
+    const unsigned int frames = 1000;
+    glm::mat4 spin = glm::rotate(glm::mat4(1), 0.01f, glm::vec3(0, 0, 1));
+    volatile float sink = 0;
+    for(unsigned int n: {50u, 500u, 4000u}){
+        std::vector<glm::vec3> points = bench::sphere_points(n);
+        gmh::Polyhedron sphere(std::vector<gmh::Point>(points.begin(), points.end()));
+        gmh::Point probe(glm::vec3(0, 0, 3));
+        std::cout << "Sphere hull, per frame" << std::endl;
+        bench::row("translate, synced", n, bench::time_ns([&](){
+            sphere.translate(glm::vec3(1e-3f, 0, 0));
+            sphere.sync();
+        }, frames));
+        bench::row("translate", n, bench::time_ns([&](){sphere.translate(glm::vec3(1e-3f, 0, 0));}, frames));
+        bench::row("rotate, synced", n, bench::time_ns([&](){
+            sphere.transform(spin);
+            sphere.sync();
+        }, frames));
+        bench::row("rotate", n, bench::time_ns([&](){sphere.transform(spin);}, frames));
+        bench::row("rotate, support", n, bench::time_ns([&](){
+            sphere.transform(spin);
+            sink = sink + sphere.support(glm::vec3(1, 0, 0)).x;
+        }, frames));
+        bench::row("rotate, dist", n, bench::time_ns([&](){
+            sphere.transform(spin);
+            sink = sink + sphere.dist(probe);
+        }, frames));
+    }
+    return 0;
+}
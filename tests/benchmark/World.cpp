@@ -0,0 +1,34 @@
+#include "bench.hpp"
+#include "Graphics/world.hpp"
+#include "Graphics/geometry.hpp"
+#include "scene.hpp"
+
+// Drifting 64 vertex balls that never touch, stepped by moving every shape and running
+// CHandler, or by a PhysicsWorld which only moves their bounds.
+int main(){
+    const unsigned int frames = 20;
+    const std::vector<glm::vec3> points = bench::sphere_points(64, 0.6);
+    std::cout << "Drifting bodies, per step" << std::endl;
+    for(unsigned int n: {1000u, 4000u}){
+        unsigned int side = std::ceil(std::cbrt(static_cast<float>(n)));
+        std::vector<std::unique_ptr<gmh::Polyhedron>> balls;
+        for(unsigned int i = 0; i < n; i++){
+            balls.push_back(scene::hull(glm::vec3(2.0f*(i%side), 2.0f*(i/side%side), 2.0f*(i/side/side)), points));
+            balls.back()->vel = glm::vec3(0.5, 0.25, 0);
+        }
+        {
+            gmh::CHandler handler(1, 1);
+            for(std::unique_ptr<gmh::Polyhedron>& b: balls) handler.add(b.get());
+            bench::row("update() + CHandler", n, bench::time_ns([&](){
+                for(std::unique_ptr<gmh::Polyhedron>& b: balls) b->update(1/60.f);
+                handler();
+            }, frames));
+        }
+        {
+            gmh::PhysicsWorld world(1/60.f, 1, 1);
+            for(std::unique_ptr<gmh::Polyhedron>& b: balls) world.add(b.get());
+            bench::row("PhysicsWorld", n, bench::time_ns([&](){world.step();}, frames));
+        }
+    }
+    return 0;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <iostream>
+#include <iomanip>
+#include <chrono>
+#include <cmath>
+#include <vector>
+#include <glm/ext/vector_float3.hpp>
+#include <glm/gtc/constants.hpp>
+
+namespace bench {
+    /**
+     * Average wall time of a callable.
+     *
+     * @param f Callable to time.
+     * @param reps Number of times to call f.
+     * @return Average time per call in nanoseconds.
+     */
+    template<typename F>
+    double time_ns(F&& f, unsigned int reps = 1){
+        auto start = std::chrono::high_resolution_clock::now();
+        for(unsigned int i = 0; i < reps; i++) f();
+        auto end = std::chrono::high_resolution_clock::now();
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(end - start).count()/static_cast<double>(reps);
+    }
+
+    /**
+     * Evenly spread points on a sphere (Fibonacci lattice).
+     *
+     * Every point is a strict vertex of the convex hull of the set.
+     */
+    inline std::vector<glm::vec3> sphere_points(unsigned int n, float radius = 1, glm::vec3 center = glm::vec3(0, 0, 0)){
+        std::vector<glm::vec3> out;
+        out.reserve(n);
+        for(unsigned int i = 0; i < n; i++){
+            float z = 1 - 2*(i + 0.5f)/n;
+            float r = std::sqrt(1 - z*z);
+            float theta = i*glm::pi<float>()*(3 - std::sqrt(5.0f));
+            out.push_back(center + radius*glm::vec3(r*std::cos(theta), r*std::sin(theta), z));
+        }
+        return out;
+    }
+
+    inline void row(const char* name, unsigned int n, double ns){
+        std::cout << std::left << std::setw(28) << name << std::right << std::setw(8) << n << std::setw(16) << std::fixed << std::setprecision(1) << ns/1000.0 << " us" << std::endl;
+    }
+}
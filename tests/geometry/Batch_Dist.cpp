@@ -0,0 +1,131 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "Graphics/geometry.hpp"
+#include "Graphics/batch.hpp"
+#include "Graphics/query.hpp"
+
+struct BatchDistTest: public ::testing::Test {
+    gmh::Polygon poly;
+    gmh::Polyhedron polyhed;
+    std::vector<glm::vec3> points;
+
+    virtual void SetUp() override {
+        poly = gmh::Polygon(glm::vec3(2, 2, 0), glm::vec3(-2, 2, 0), glm::vec3(2, -2, 0), glm::vec3(-2, -2, 0));
+        polyhed = gmh::Polyhedron(glm::vec3(0, 0, 1), glm::vec3(-1, 1, 0), glm::vec3(1, -1, 0), glm::vec3(-1, -1, 0), glm::vec3(1, 1, 0));
+        std::mt19937 gen(7);
+        std::uniform_real_distribution<float> dist(-3, 3);
+        for(int i = 0; i < 1001; i++) points.emplace_back(dist(gen), dist(gen), dist(gen));
+        points.emplace_back(0, 0, 0.5);
+        points.emplace_back(1, 1, 0);
+        points.emplace_back(0.5, 0, 0);
+        points.emplace_back(2, 0, 0);
+        points.emplace_back(3, 0, 0);
+    }
+
+    virtual void TearDown() override {
+        gmh::simd_level(gmh::simd_supported());
+    }
+
+    std::vector<gmh::SimdLevel> levels() const {
+        std::vector<gmh::SimdLevel> out{gmh::SimdLevel::Scalar};
+        if(gmh::simd_supported() >= gmh::SimdLevel::SSE) out.push_back(gmh::SimdLevel::SSE);
+        if(gmh::simd_supported() >= gmh::SimdLevel::AVX2) out.push_back(gmh::SimdLevel::AVX2);
+        return out;
+    }
+};
+
+TEST_F(BatchDistTest, PolygonDist){
+    for(gmh::SimdLevel level: levels()){
+        gmh::simd_level(level);
+        ASSERT_EQ(level, gmh::simd_level());
+        std::vector<float> out = gmh::dist_many(poly, points);
+        ASSERT_EQ(points.size(), out.size());
+        for(unsigned int i = 0; i < points.size(); i++) EXPECT_NEAR(gmh::Point(points[i]).dist(poly), out[i], 1e-5);
+    }
+}
+
+TEST_F(BatchDistTest, PolyhedronDist){
+    for(gmh::SimdLevel level: levels()){
+        gmh::simd_level(level);
+        std::vector<float> out = gmh::dist_many(polyhed, points);
+        for(unsigned int i = 0; i < points.size(); i++) EXPECT_NEAR(gmh::Point(points[i]).dist(polyhed), out[i], 1e-5);
+    }
+}
+
+TEST_F(BatchDistTest, Contains){
+    for(gmh::SimdLevel level: levels()){
+        gmh::simd_level(level);
+        std::unique_ptr<bool[]> in(new bool[points.size()]);
+        gmh::contains_many(polyhed, points.data(), points.size(), in.get());
+        for(unsigned int i = 0; i < points.size(); i++) EXPECT_EQ(polyhed.contains(gmh::Point(points[i])), in[i]);
+        gmh::contains_many(poly, points.data(), points.size(), in.get());
+        for(unsigned int i = 0; i < points.size(); i++) EXPECT_EQ(poly.contains(gmh::Point(points[i])), in[i]);
+    }
+}
+
+TEST_F(BatchDistTest, Integrate){
+    std::vector<float> v(points.size());
+    for(unsigned int i = 0; i < points.size(); i++) v[i] = points[i].y;
+    for(gmh::SimdLevel level: levels()){
+        gmh::simd_level(level);
+        std::vector<float> x(points.size());
+        for(unsigned int i = 0; i < points.size(); i++) x[i] = points[i].x;
+        gmh::integrate_many(x.data() + 1, v.data() + 1, x.size() - 1, 0.25);
+        EXPECT_EQ(points[0].x, x[0]);
+        for(unsigned int i = 1; i < points.size(); i++) EXPECT_NEAR(points[i].x + 0.25f*points[i].y, x[i], 1e-5);
+    }
+}
+
+TEST_F(BatchDistTest, Raycast){
+    // Rays from every point, some towards the shapes and some away, some too short to reach them.
+    std::mt19937 gen(11);
+    std::uniform_real_distribution<float> dist(-1, 1);
+    std::vector<float> ray[7], hit[4];
+    for(const glm::vec3& p: points){
+        glm::vec3 d = glm::normalize(glm::vec3(dist(gen), dist(gen), dist(gen)) - 0.5f*p);
+        for(unsigned int k = 0; k < 3; k++){
+            ray[k].push_back(p[k]);
+            ray[k + 3].push_back(d[k]);
+        }
+        ray[6].push_back(dist(gen) < 0.8 ? std::numeric_limits<float>::infinity() : 2);
+    }
+    for(std::vector<float>& h: hit) h.resize(points.size());
+    gmh::RaySpan rays{ray[0].data(), ray[1].data(), ray[2].data(), ray[3].data(), ray[4].data(), ray[5].data(), ray[6].data(), points.size()};
+    gmh::HitSpan hits{hit[0].data(), hit[1].data(), hit[2].data(), hit[3].data()};
+    for(gmh::SimdLevel level: levels()){
+        gmh::simd_level(level);
+        for(const gmh::Point* obj: {static_cast<const gmh::Point*>(&poly), static_cast<const gmh::Point*>(&polyhed)}){
+            if(obj == &poly) gmh::raycast_many(poly, rays, hits);
+            else gmh::raycast_many(polyhed, rays, hits);
+            unsigned int count = 0;
+            for(unsigned int i = 0; i < points.size(); i++){
+                glm::vec3 o(ray[0][i], ray[1][i], ray[2][i]), d(ray[3][i], ray[4][i], ray[5][i]);
+                gmh::RayHit expect = gmh::raycast(gmh::shape(*obj), o, d, ray[6][i]);
+                ASSERT_EQ(static_cast<bool>(expect), !std::isinf(hit[0][i])) << i;
+                if(!expect){
+                    EXPECT_EQ(glm::vec3(0), glm::vec3(hit[1][i], hit[2][i], hit[3][i]));
+                    continue;
+                }
+                count++;
+                EXPECT_NEAR(expect.dist, hit[0][i], 1e-5);
+                EXPECT_GT(1e-5, glm::distance(expect.normal, glm::vec3(hit[1][i], hit[2][i], hit[3][i])));
+            }
+            EXPECT_LT(100, count);
+        }
+    }
+
+    // Straight down onto the top of each shape, from above and from inside the pyramid.
+    float ox[] = {0.5, 0, 0}, oy[] = {0.5, 0, 0}, oz[] = {3, 3, 0.5}, dx[] = {0, 0, 0}, dy[] = {0, 0, 0}, dz[] = {-1, -1, -1};
+    float len[] = {std::numeric_limits<float>::infinity(), 2.5, 1};
+    float t[3], nx[3], ny[3], nz[3];
+    gmh::raycast_many(polyhed, {ox, oy, oz, dx, dy, dz, len, 3}, {t, nx, ny, nz});
+    EXPECT_NEAR(2.5, t[0], 1e-5);
+    EXPECT_NEAR(2, t[1], 1e-5);
+    EXPECT_EQ(0, t[2]);
+    EXPECT_EQ(1, nz[2]);
+    gmh::raycast_many(poly, {ox, oy, oz, dx, dy, dz, len, 3}, {t, nx, ny, nz});
+    EXPECT_NEAR(3, t[0], 1e-5);
+    EXPECT_TRUE(std::isinf(t[1]));
+    EXPECT_NEAR(0.5, t[2], 1e-5);
+    EXPECT_EQ(1, nz[0]);
+}
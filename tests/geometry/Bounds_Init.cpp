@@ -0,0 +1,69 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <glm/gtc/matrix_transform.hpp>
+#include "Graphics/geometry.hpp"
+#include "Graphics/instance.hpp"
+#include "scene.hpp"
+
+struct BoundsInitTest: public ::testing::Test {
+    gmh::Polyhedron cube = *scene::crate(glm::vec3(0));
+};
+
+TEST_F(BoundsInitTest, Extents){
+    gmh::Extent ext = cube.extent();
+    EXPECT_EQ(glm::vec3(0, 0, 0), ext.box.min);
+    EXPECT_EQ(glm::vec3(1, 1, 1), ext.box.max);
+    EXPECT_EQ(glm::vec3(0.5, 0.5, 0.5), ext.sphere.center);
+    EXPECT_NEAR(std::sqrt(0.75), ext.sphere.radius, 1e-6);
+
+    gmh::LinSeg seg(glm::vec3(1, 2, 3), glm::vec3(-1, 2, 5));
+    EXPECT_EQ(glm::vec3(-1, 2, 3), seg.extent().box.min);
+    EXPECT_EQ(glm::vec3(1, 2, 5), seg.extent().box.max);
+    EXPECT_EQ(glm::vec3(4, 5, 6), gmh::Point(glm::vec3(4, 5, 6)).extent().box.max);
+    EXPECT_TRUE(std::isinf(gmh::Line(glm::vec3(0, 0, 0), glm::vec3(1, 0, 0)).extent().box.max.y));
+    EXPECT_TRUE(std::isinf(gmh::Plane(glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0)).extent().sphere.radius));
+}
+
+TEST_F(BoundsInitTest, FollowsMoves){
+    // A pending translation carries the box over exactly, without touching the vertices.
+    std::shared_ptr<gmh::Point> first = cube.vertices[0];
+    cube.translate(glm::vec3(2, 0, 0));
+    EXPECT_EQ(glm::vec3(2, 0, 0), cube.extent().box.min);
+    EXPECT_EQ(glm::vec3(3, 1, 1), cube.extent().box.max);
+    EXPECT_EQ(glm::vec3(0, 0, 0), first->pos);
+
+    // A pending rotation gives a box holding the one the vertices have once moved.
+    cube.transform(glm::rotate(glm::mat4(1), 0.7f, glm::vec3(1, 2, 3)));
+    gmh::Extent pending = cube.extent();
+    cube.sync();
+    gmh::Extent settled = cube.extent();
+    EXPECT_TRUE(pending.box.grown(1e-5).contains(settled.box));
+    for(const std::shared_ptr<gmh::Point>& p: cube.vertices){
+        EXPECT_TRUE(settled.box.grown(1e-5).contains(p->extent().box));
+        EXPECT_GE(pending.sphere.radius + 1e-5, glm::distance(pending.sphere.center, p->pos));
+    }
+
+    std::shared_ptr<const gmh::ShapeTemplate> crate = gmh::ShapeTemplate::make(scene::crate_corners());
+    gmh::Instance placed(crate, glm::translate(glm::mat4(1), glm::vec3(0, 0, 4)));
+    EXPECT_EQ(glm::vec3(0, 0, 4), placed.extent().box.min);
+    EXPECT_EQ(glm::vec3(1, 1, 5), placed.extent().box.max);
+}
+
+TEST_F(BoundsInitTest, EarlyOut){
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<float> spread(-4, 4);
+    for(unsigned int i = 0; i < 50; i++){
+        glm::vec3 c(spread(gen), spread(gen), spread(gen));
+        gmh::Polyhedron other(c + glm::vec3(0, 0, 0), c + glm::vec3(1, 0, 0), c + glm::vec3(0, 1, 0), c + glm::vec3(0, 0, 1));
+        gmh::LinSeg seg(c, c + glm::vec3(1, 1, 1));
+        float d = cube.dist(other);
+        EXPECT_GE(d + 1e-5, cube.gap(other));
+        EXPECT_EQ(d < 0.5, cube.within(other, 0.5));
+        EXPECT_EQ(cube.dist(seg) < 1e-5, static_cast<bool>(cube.intersection(seg)));
+        if(cube.gap(other) >= 1e-5){
+            EXPECT_FALSE(cube.intersection(other));
+            EXPECT_FALSE(other.intersection(cube));
+            EXPECT_FALSE(cube.contains(other));
+        }
+    }
+}
@@ -0,0 +1,61 @@
+#include <gtest/gtest.h>
+#include <random>
+#include "Graphics/broadphase.hpp"
+#include "Graphics/geometry.hpp"
+
+static std::set<std::pair<unsigned int, unsigned int>> brute(const gmh::SweepAndPrune& sap, const std::vector<unsigned int>& ids){
+    std::set<std::pair<unsigned int, unsigned int>> out;
+    for(unsigned int i = 0; i < ids.size(); i++)
+        for(unsigned int j = i + 1; j < ids.size(); j++)
+            if(sap.box(ids[i]).overlaps(sap.box(ids[j]))) out.insert(std::minmax(ids[i], ids[j]));
+    return out;
+}
+
+TEST(BroadphaseInitTest, Bounds){
+    gmh::Polyhedron tetra(glm::vec3(0, 0, 1), glm::vec3(-1, 1, 0), glm::vec3(1, -1, 0), glm::vec3(-1, -1, 0));
+    gmh::AABB box = gmh::bounds(tetra);
+    EXPECT_EQ(glm::vec3(-1, -1, 0), box.min);
+    EXPECT_EQ(glm::vec3(1, 1, 1), box.max);
+    box = gmh::bounds(gmh::Point(glm::vec3(1, 2, 3)), 0.5);
+    EXPECT_EQ(glm::vec3(0.5, 1.5, 2.5), box.min);
+    EXPECT_EQ(glm::vec3(1.5, 2.5, 3.5), box.max);
+}
+
+TEST(BroadphaseInitTest, Touching){
+    gmh::SweepAndPrune sap;
+    unsigned int a = sap.insert({glm::vec3(0, 0, 0), glm::vec3(1, 1, 1)});
+    unsigned int b = sap.insert({glm::vec3(1, 0, 0), glm::vec3(2, 1, 1)});
+    EXPECT_EQ(1, sap.pairs().count({a, b}));
+    sap.update(b, {glm::vec3(1.5, 0, 0), glm::vec3(2.5, 1, 1)});
+    EXPECT_TRUE(sap.pairs().empty());
+    sap.update(b, {glm::vec3(1, 0, 0), glm::vec3(2, 1, 1)});
+    EXPECT_EQ(1, sap.pairs().count({a, b}));
+}
+
+TEST(BroadphaseInitTest, MatchesBruteForce){
+    std::mt19937 gen(3);
+    std::uniform_real_distribution<float> pos(-10, 10), size(0.2, 2), step(-0.3, 0.3);
+    gmh::SweepAndPrune sap;
+    std::vector<unsigned int> ids;
+    auto random_box = [&](){
+        glm::vec3 min(pos(gen), pos(gen), pos(gen));
+        return gmh::AABB{min, min + glm::vec3(size(gen), size(gen), size(gen))};
+    };
+    for(unsigned int i = 0; i < 200; i++) ids.push_back(sap.insert(random_box()));
+    ASSERT_EQ(brute(sap, ids), sap.pairs());
+    for(unsigned int frame = 0; frame < 50; frame++){
+        for(unsigned int id: ids){
+            glm::vec3 move(step(gen), step(gen), step(gen));
+            gmh::AABB box = sap.box(id);
+            sap.update(id, {box.min + move, box.max + move});
+        }
+        ASSERT_EQ(brute(sap, ids), sap.pairs()) << frame;
+    }
+    for(unsigned int i = 0; i < 50; i++){
+        sap.remove(ids.back());
+        ids.pop_back();
+    }
+    EXPECT_EQ(brute(sap, ids), sap.pairs());
+    for(unsigned int i = 0; i < 20; i++) ids.push_back(sap.insert(random_box()));
+    EXPECT_EQ(brute(sap, ids), sap.pairs());
+}
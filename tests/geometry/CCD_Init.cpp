@@ -0,0 +1,88 @@
+#include <gtest/gtest.h>
+#include "Graphics/collision.hpp"
+#include "Graphics/geometry.hpp"
+
+struct CCDInitTest: public ::testing::Test {
+    gmh::Polygon wall{glm::vec3(0, -2, -2), glm::vec3(0, 2, -2), glm::vec3(0, -2, 2), glm::vec3(0, 2, 2)};
+    gmh::Polyhedron cube{glm::vec3(-3, 0, 0), glm::vec3(-2, 0, 0), glm::vec3(-3, 1, 0), glm::vec3(-2, 1, 0),
+        glm::vec3(-3, 0, 1), glm::vec3(-2, 0, 1), glm::vec3(-3, 1, 1), glm::vec3(-2, 1, 1)};
+    gmh::CHandler handler{1, 1};
+};
+
+TEST_F(CCDInitTest, Tunnel){
+    handler.add(&wall, 1, true);
+    handler.add(&cube);
+    cube.vel = glm::vec3(100, 0, 0);
+    handler(0.1);
+    EXPECT_GT(cube.pos.x, 0);
+    EXPECT_EQ(glm::vec3(100, 0, 0), cube.vel);
+}
+
+TEST_F(CCDInitTest, Fast){
+    handler.add(&wall, 1, true);
+    handler.add(&cube, 1, false, true);
+    cube.vel = glm::vec3(100, 0, 0);
+    handler(0.1);
+    // Stopped at the wall after a fifth of the step, then back the other way for the rest of it.
+    EXPECT_NEAR(-8.5, cube.pos.x, 1e-3);
+    EXPECT_NEAR(-100, cube.vel.x, 1e-3);
+    handler(0.1);
+    EXPECT_NEAR(-18.5, cube.pos.x, 1e-3);
+
+    // A body already touching is left to the contact step rather than stopped.
+    cube.vel = glm::vec3(0, 1, 0);
+    gmh::Polyhedron other{glm::vec3(-20, 0, 0), glm::vec3(-19, 0, 0), glm::vec3(-20, 1, 0), glm::vec3(-19, 1, 0),
+        glm::vec3(-20, 0, 1), glm::vec3(-19, 0, 1), glm::vec3(-20, 1, 1), glm::vec3(-19, 1, 1)};
+    handler.add(&other, 1, true);
+    handler(0.1);
+    EXPECT_NEAR(0.1, cube.pos.y - 0.5, 1e-4);
+}
+
+TEST_F(CCDInitTest, RestOfStep){
+    // Bounces between two walls 4 apart three times within the step, each time from where it was stopped.
+    gmh::Polygon back{glm::vec3(-4, -2, -2), glm::vec3(-4, 2, -2), glm::vec3(-4, -2, 2), glm::vec3(-4, 2, 2)};
+    handler.add(&wall, 1, true);
+    handler.add(&back, 1, true);
+    handler.add(&cube, 1, false, true);
+    cube.vel = glm::vec3(100, 0, 0);
+    handler(0.1);
+    EXPECT_NEAR(-2.5, cube.pos.x, 1e-3);
+    EXPECT_NEAR(-100, cube.vel.x, 1e-3);
+
+    // A step with more hits than sweeps drops what is left after the last one, inside the walls.
+    cube.vel = glm::vec3(400, 0, 0);
+    handler(0.1);
+    EXPECT_GT(cube.pos.x, -3.5 - 1e-3);
+    EXPECT_LT(cube.pos.x, -0.5 + 1e-3);
+}
+
+TEST_F(CCDInitTest, Graze){
+    // Passes over the top of the wall, closing in on it only slightly.
+    cube.translate(glm::vec3(0, 2.0013, 0));
+    gmh::Impact hit;
+    EXPECT_FALSE(gmh::toi(cube, glm::vec3(10, -0.001, 0), wall, glm::vec3(0), hit));
+
+    handler.add(&wall, 1, true);
+    handler.add(&cube, 1, false, true);
+    cube.vel = glm::vec3(100, -0.01, 0);
+    handler(0.1);
+    EXPECT_NEAR(7.5, cube.pos.x, 1e-4);
+    EXPECT_EQ(glm::vec3(100, -0.01, 0), cube.vel);
+}
+
+TEST_F(CCDInitTest, ShapeCast){
+    gmh::BodyId target = handler.add(&wall, 1, true);
+    gmh::Polyhedron probe{glm::vec3(-6, 0, 0), glm::vec3(-5, 0, 0), glm::vec3(-6, 1, 0), glm::vec3(-5, 1, 0),
+        glm::vec3(-6, 0, 1), glm::vec3(-5, 0, 1), glm::vec3(-6, 1, 1), glm::vec3(-5, 1, 1)};
+    handler.add(&cube);
+    gmh::Impact hit;
+    EXPECT_EQ(handler.id(&cube), handler.shape_cast(probe, glm::vec3(10, 0, 0), hit));
+    EXPECT_NEAR(0.2, hit.t, 1e-5);
+    EXPECT_NEAR(1, hit.normal.x, 1e-5);
+
+    EXPECT_EQ(target, handler.shape_cast(cube, glm::vec3(10, 0, 0), hit));
+    EXPECT_NEAR(0.2, hit.t, 1e-5);
+
+    EXPECT_EQ(gmh::BodyId{}, handler.shape_cast(probe, glm::vec3(0, 10, 0), hit));
+    EXPECT_NEAR(0.2, hit.t, 1e-5);
+}
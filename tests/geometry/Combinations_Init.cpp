@@ -0,0 +1,45 @@
+#include <gtest/gtest.h>
+#include <list>
+#include <algorithm>
+#include <set>
+#include "Graphics/gmath.hpp"
+
+TEST(CombinationsInitTest, Pairs){
+    std::vector<int> v{0, 1, 2, 3, 4};
+    std::vector<std::pair<int, int>> pairs;
+    for(auto [a, b]: gmh::combinations<2>(v.begin(), v.end())) pairs.emplace_back(*a, *b);
+    ASSERT_EQ(10, pairs.size());
+    EXPECT_EQ(std::make_pair(0, 1), pairs.front());
+    EXPECT_EQ(std::make_pair(3, 4), pairs.back());
+    EXPECT_TRUE(std::is_sorted(pairs.begin(), pairs.end()));
+    EXPECT_EQ(10, gmh::combinations<2>(v.begin(), v.end()).size());
+}
+
+TEST(CombinationsInitTest, Triples){
+    std::list<int> v{0, 1, 2, 3, 4, 5};
+    gmh::Combinations<std::list<int>::iterator, 3> comb = gmh::combinations<3>(v.begin(), v.end());
+    std::set<std::array<int, 3>> seen;
+    for(const std::array<std::list<int>::iterator, 3>& c: comb){
+        EXPECT_LT(*c[0], *c[1]);
+        EXPECT_LT(*c[1], *c[2]);
+        seen.insert({*c[0], *c[1], *c[2]});
+    }
+    EXPECT_EQ(20, seen.size());
+    EXPECT_EQ(20, comb.size());
+}
+
+TEST(CombinationsInitTest, Empty){
+    std::vector<int> v{0};
+    EXPECT_EQ(0, gmh::combinations<2>(v.begin(), v.end()).size());
+    EXPECT_TRUE(gmh::combinations<2>(v.begin(), v.end()).begin() == gmh::combinations<2>(v.begin(), v.end()).end());
+    EXPECT_TRUE(gmh::combinations<2>(v.end(), v.end()).begin() == gmh::combinations<2>(v.end(), v.end()).end());
+}
+
+TEST(CombinationsInitTest, At){
+    std::vector<int> v{0, 1, 2, 3, 4, 5, 6};
+    gmh::Combinations<std::vector<int>::iterator, 3> comb = gmh::combinations<3>(v.begin(), v.end());
+    size_t r = 0;
+    for(auto it = comb.begin(); it != comb.end(); ++it, r++) EXPECT_TRUE(comb.at(r) == it) << r;
+    EXPECT_EQ(comb.size(), r);
+    EXPECT_TRUE(comb.at(r) == comb.end());
+}
@@ -0,0 +1,114 @@
+#include <gtest/gtest.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include "Graphics/geometry.hpp"
+#include "Graphics/gjk.hpp"
+
+struct GJKDistTest: public ::testing::Test {
+    gmh::Polyhedron poly;
+    virtual void SetUp() override {
+        poly = gmh::Polyhedron(glm::vec3(0, 0, 1), glm::vec3(-1, 1, 0), glm::vec3(1, -1, 0), glm::vec3(-1, -1, 0), glm::vec3(1, 1, 0));
+    }
+};
+
+static gmh::Polyhedron cube(glm::vec3 center, float half){
+    std::vector<gmh::Point> vert;
+    for(int i = 0; i < 8; i++)
+        vert.push_back(gmh::Point(center + half*glm::vec3(i & 1 ? 1 : -1, i & 2 ? 1 : -1, i & 4 ? 1 : -1)));
+    return gmh::Polyhedron(vert);
+}
+
+TEST_F(GJKDistTest, PointDist){
+    gmh::Point p(glm::vec3(0, 0, 0.5));
+    EXPECT_FLOAT_EQ(0, gmh::gjk(poly, p).dist);
+
+    p = gmh::Point(glm::vec3(0, 0, 3));
+    gmh::Separation sep = gmh::gjk(p, poly);
+    EXPECT_NEAR(2, sep.dist, 1e-5);
+    EXPECT_NEAR(0, glm::distance(glm::vec3(0, 0, 1), sep.p2), 1e-5);
+
+    p = gmh::Point(glm::vec3(3, 0, -1));
+    EXPECT_NEAR(p.dist(poly), gmh::gjk(p, poly).dist, 1e-5);
+}
+
+TEST_F(GJKDistTest, LinSegDist){
+    gmh::LinSeg l(glm::vec3(-2, 2, 2), glm::vec3(2, 2, 2));
+    EXPECT_NEAR(l.dist(poly), gmh::gjk(l, poly).dist, 1e-5);
+
+    l = gmh::LinSeg(glm::vec3(-2, 0, 0.5), glm::vec3(2, 0, 0.5));
+    EXPECT_FLOAT_EQ(0, gmh::gjk(l, poly).dist);
+}
+
+TEST_F(GJKDistTest, PolygonDist){
+    gmh::Polygon surf(glm::vec3(-1, -1, 2), glm::vec3(1, -1, 2), glm::vec3(1, 1, 2), glm::vec3(-1, 1, 2));
+    EXPECT_NEAR(1, gmh::gjk(surf, poly).dist, 1e-5);
+
+    gmh::Polygon surf2(glm::vec3(-1, -1, 1), glm::vec3(1, -1, 1), glm::vec3(1, 1, 3));
+    EXPECT_NEAR(surf.dist(surf2), gmh::gjk(surf, surf2).dist, 1e-5);
+
+    surf = gmh::Polygon(glm::vec3(-2, -2, 0.5), glm::vec3(2, -2, 0.5), glm::vec3(2, 2, 0.5), glm::vec3(-2, 2, 0.5));
+    EXPECT_FLOAT_EQ(0, gmh::gjk(surf, poly).dist);
+}
+
+TEST_F(GJKDistTest, PolyhedronDist){
+    std::vector<std::vector<gmh::Point>> others{
+        {glm::vec3(0, 0, -0.5), glm::vec3(-1, 1, -1), glm::vec3(1, -1, -1), glm::vec3(-1, -1, -1), glm::vec3(1, 1, -1)},
+        {glm::vec3(3, 0, 1), glm::vec3(2, 1, 0), glm::vec3(4, -1, 0), glm::vec3(2, -1, 0), glm::vec3(4, 1, 0)},
+        {glm::vec3(3, 3, 1), glm::vec3(4, 4, 0), glm::vec3(4, 2, 0), glm::vec3(2, 2, 0), glm::vec3(2, 4, 0)},
+        {glm::vec3(2, 0, 2), glm::vec3(1, 1, 1), glm::vec3(3, -1, 1), glm::vec3(1, -1, 1), glm::vec3(3, 1, 1)},
+        {glm::vec3(2, 2, 2), glm::vec3(3, 3, 1), glm::vec3(3, 1, 1), glm::vec3(1, 1, 1), glm::vec3(1, 3, 1)},
+        {glm::vec3(0, 0, 0.5), glm::vec3(-1, 1, -1), glm::vec3(1, -1, -1), glm::vec3(-1, -1, -1), glm::vec3(1, 1, -1)}
+    };
+    for(const std::vector<gmh::Point>& vert: others){
+        gmh::Polyhedron other(vert);
+        gmh::Separation sep = gmh::gjk(poly, other);
+        EXPECT_NEAR(poly.dist(other), sep.dist, 1e-5);
+        EXPECT_NEAR(sep.dist, glm::distance(sep.p1, sep.p2), 1e-5);
+        EXPECT_NEAR(sep.dist, gmh::gjk(other, poly).dist, 1e-5);
+    }
+}
+
+TEST_F(GJKDistTest, WarmStart){
+    gmh::Polyhedron other = cube(glm::vec3(4, 0, 0.5), 0.5);
+    gmh::Simplex cache;
+    float step = 0.25;
+    for(int i = 0; i < 10; i++){
+        float cached = gmh::gjk(poly, other, &cache).dist;
+        EXPECT_NEAR(gmh::gjk(poly, other).dist, cached, 1e-5);
+        other.transform(glm::translate(glm::mat4(1), glm::vec3(-step, 0, 0)));
+    }
+    EXPECT_FLOAT_EQ(0, gmh::gjk(poly, other, &cache).dist);
+}
+
+TEST_F(GJKDistTest, Penetration){
+    gmh::Polyhedron a = cube(glm::vec3(0, 0, 0), 1);
+    gmh::Polyhedron b = cube(glm::vec3(1.5, 0.2, 0.1), 1);
+    gmh::Penetration pen;
+    ASSERT_TRUE(gmh::epa(a, b, pen));
+    EXPECT_NEAR(0.5, pen.depth, 1e-4);
+    EXPECT_NEAR(1, pen.normal.x, 1e-4);
+    EXPECT_NEAR(0, glm::length(glm::vec3(0, pen.normal.y, pen.normal.z)), 1e-4);
+
+    b = cube(glm::vec3(3, 0, 0), 1);
+    EXPECT_FALSE(gmh::epa(a, b, pen));
+}
+
+TEST_F(GJKDistTest, TimeOfImpact){
+    gmh::Polyhedron a = cube(glm::vec3(-5, 0, 0), 0.5), b = cube(glm::vec3(5, 0, 0), 0.5);
+    gmh::Impact hit;
+    ASSERT_TRUE(gmh::toi(a, glm::vec3(20, 0, 0), b, glm::vec3(0), hit));
+    EXPECT_NEAR(9.0/20, hit.t, 1e-5);
+    EXPECT_NEAR(1, hit.normal.x, 1e-5);
+    EXPECT_NEAR(4.5, hit.p2.x, 1e-4);
+
+    ASSERT_TRUE(gmh::toi(a, glm::vec3(5, 0, 0), b, glm::vec3(-5, 0, 0), hit));
+    EXPECT_NEAR(0.9, hit.t, 1e-5);
+
+    EXPECT_FALSE(gmh::toi(a, glm::vec3(5, 0, 0), b, glm::vec3(0), hit));
+    EXPECT_FALSE(gmh::toi(a, glm::vec3(-20, 0, 0), b, glm::vec3(0), hit));
+    EXPECT_FALSE(gmh::toi(a, glm::vec3(20, 5, 0), b, glm::vec3(0), hit));
+
+    gmh::Polygon wall(glm::vec3(0, -2, -2), glm::vec3(0, 2, -2), glm::vec3(0, -2, 2), glm::vec3(0, 2, 2));
+    ASSERT_TRUE(gmh::toi(a, glm::vec3(100, 0, 0), wall, glm::vec3(0), hit));
+    EXPECT_NEAR(4.5/100, hit.t, 1e-5);
+    EXPECT_EQ(-5, a.pos.x);
+}
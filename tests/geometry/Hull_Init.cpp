@@ -0,0 +1,83 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "Graphics/geometry.hpp"
+#include "Graphics/hull.hpp"
+#include "Graphics/hash.hpp"
+
+struct HullInitTest: public ::testing::Test {
+    std::vector<glm::vec3> cube;
+
+    virtual void SetUp() override {
+        for(int i = 0; i < 8; i++) cube.emplace_back(i&1, (i>>1)&1, (i>>2)&1);
+    }
+};
+
+TEST_F(HullInitTest, FailCases){
+    gmh::Hull h;
+    EXPECT_EQ(gmh::HullStatus::TooFewPoints, gmh::quickhull({glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0)}, h));
+    EXPECT_EQ(gmh::HullStatus::Coincident, gmh::quickhull({glm::vec3(1, 1, 1), glm::vec3(1, 1, 1), glm::vec3(1, 1, 1), glm::vec3(1, 1, 1)}, h));
+    EXPECT_EQ(gmh::HullStatus::Collinear, gmh::quickhull({glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(2, 0, 0), glm::vec3(3, 0, 0)}, h));
+    EXPECT_EQ(gmh::HullStatus::Coplanar, gmh::quickhull({glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(1, 1, 0)}, h));
+    EXPECT_TRUE(h.faces.empty());
+    EXPECT_TRUE(h.vertices.empty());
+}
+
+TEST_F(HullInitTest, Cube){
+    gmh::Hull h;
+    ASSERT_EQ(gmh::HullStatus::Ok, gmh::quickhull(cube, h));
+    EXPECT_EQ(8, h.vertices.size());
+    ASSERT_EQ(6, h.faces.size());
+    glm::vec3 center(0.5, 0.5, 0.5);
+    for(const std::vector<unsigned int>& face: h.faces){
+        ASSERT_EQ(4, face.size());
+        glm::vec3 n = glm::cross(cube[face[1]] - cube[face[0]], cube[face[2]] - cube[face[0]]);
+        EXPECT_LT(0, glm::dot(n, center - cube[face[0]]));
+    }
+}
+
+TEST_F(HullInitTest, InteriorPoints){
+    std::vector<glm::vec3> points = cube;
+    points.emplace_back(0.5, 0.5, 0.5);
+    points.emplace_back(0.5, 0.5, 0);
+    points.emplace_back(1, 0.5, 0);
+    gmh::Hull h;
+    ASSERT_EQ(gmh::HullStatus::Ok, gmh::quickhull(points, h));
+    EXPECT_EQ(std::vector<unsigned int>({0, 1, 2, 3, 4, 5, 6, 7}), h.vertices);
+    EXPECT_EQ(6, h.faces.size());
+}
+
+TEST_F(HullInitTest, Sphere){
+    std::vector<glm::vec3> points;
+    const unsigned int n = 500;
+    for(unsigned int i = 0; i < n; i++){
+        float z = 1 - 2*(i + 0.5f)/n;
+        float r = std::sqrt(1 - z*z);
+        float theta = i*glm::pi<float>()*(3 - std::sqrt(5.0f));
+        points.emplace_back(r*std::cos(theta), r*std::sin(theta), z);
+    }
+    gmh::Hull h;
+    ASSERT_EQ(gmh::HullStatus::Ok, gmh::quickhull(points, h));
+    EXPECT_EQ(n, h.vertices.size());
+    EXPECT_EQ(2*n - 4, h.faces.size());
+}
+
+TEST_F(HullInitTest, PolyhedronFromHull){
+    std::vector<gmh::Point> vert(cube.begin(), cube.end());
+    gmh::Polyhedron polyhed(vert);
+    EXPECT_EQ(8, polyhed.vertices.size());
+    EXPECT_EQ(12, polyhed.edges.size());
+    EXPECT_EQ(6, polyhed.faces.size());
+    EXPECT_FLOAT_EQ(1, polyhed.volume());
+    for(std::shared_ptr<gmh::Polygon> face: polyhed.faces){
+        EXPECT_EQ(4, face->vertices.size());
+        EXPECT_LT(0, face->sign_dist(gmh::Point(polyhed.pos)));
+    }
+
+    std::vector<std::shared_ptr<gmh::Point>> points;
+    for(glm::vec3 p: cube) points.push_back(std::make_shared<gmh::Point>(p));
+    gmh::Polyhedron shared(points);
+    EXPECT_EQ(polyhed, shared);
+    for(std::shared_ptr<gmh::Polygon> face: shared.faces)
+        for(std::shared_ptr<gmh::Point> p: face->vertices)
+            EXPECT_NE(points.end(), std::find(points.begin(), points.end(), p));
+}
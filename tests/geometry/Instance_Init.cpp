@@ -0,0 +1,232 @@
+#include <gtest/gtest.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include "Graphics/instance.hpp"
+#include "Graphics/collision.hpp"
+#include "Graphics/broadphase.hpp"
+#include "scene.hpp"
+
+struct InstanceInitTest: public ::testing::Test {
+    std::vector<glm::vec3> corners = scene::crate_corners();
+    std::shared_ptr<const gmh::ShapeTemplate> crate = gmh::ShapeTemplate::make(corners);
+    glm::mat4 place = glm::rotate(glm::translate(glm::mat4(1), glm::vec3(2, -1, 3)), 0.6f, glm::vec3(1, 1, 0));
+
+    // The crate built in place as a Polyhedron of its own.
+    gmh::Polyhedron built(const glm::mat4& model){
+        std::vector<gmh::Point> moved;
+        for(const glm::vec3& p: corners) moved.emplace_back(glm::vec3(model*glm::vec4(p, 1)));
+        return gmh::Polyhedron(moved);
+    }
+};
+
+TEST_F(InstanceInitTest, MassProperties){
+    EXPECT_NEAR(1, crate->volume(), 1e-5);
+    EXPECT_NEAR(2.5, crate->mass(2.5), 1e-5);
+    for(unsigned int i = 0; i < 3; i++){
+        EXPECT_NEAR(0.5, crate->centroid()[i], 1e-5);
+        for(unsigned int j = 0; j < 3; j++) EXPECT_NEAR(i == j ? 1/6.0:0, crate->inertia()[i][j], 1e-5);
+    }
+    EXPECT_EQ(36, crate->triangles().size());
+
+    std::shared_ptr<const gmh::ShapeTemplate> wedge = gmh::ShapeTemplate::make({glm::vec3(0, 0, 0), glm::vec3(2, 0, 0), glm::vec3(0, 2, 0), glm::vec3(0, 0, 2)});
+    EXPECT_NEAR(4/3.0, wedge->volume(), 1e-5);
+    for(unsigned int i = 0; i < 3; i++) EXPECT_NEAR(0.5, wedge->centroid()[i], 1e-5);
+}
+
+TEST_F(InstanceInitTest, SharesTemplate){
+    std::vector<gmh::Instance> crates;
+    for(unsigned int i = 0; i < 10; i++) crates.emplace_back(crate, glm::translate(glm::mat4(1), glm::vec3(2*i, 0, 0)));
+    EXPECT_EQ(11, crate.use_count());
+    EXPECT_EQ(&crates[0].geometry(), &crates[9].geometry());
+    EXPECT_TRUE(crates[3].vertices.empty());
+
+    crates[3].translate(glm::vec3(0, 0, 5));
+    EXPECT_EQ(glm::vec3(6.5, 0.5, 5.5), crates[3].pos);
+    EXPECT_EQ(glm::vec3(0.5, 0.5, 0.5), crates[0].pos);
+    EXPECT_EQ(glm::vec3(7, 1, 6), crates[3].support(glm::vec3(1, 1, 1)));
+    EXPECT_EQ(glm::vec3(1, 1, 1), crates[0].support(glm::vec3(1, 1, 1)));
+}
+
+TEST_F(InstanceInitTest, QueriesMatchPolyhedron){
+    gmh::Instance inst(crate, place);
+    gmh::Polyhedron poly = built(place);
+    gmh::AABB a = gmh::bounds(inst, 0), b = gmh::bounds(poly, 0);
+    EXPECT_TRUE(a.grown(1e-5).contains(b));
+    for(unsigned int i = 0; i < 3; i++) EXPECT_NEAR(poly.pos[i], inst.pos[i], 1e-5);
+
+    gmh::Point inside(place*glm::vec4(0.5, 0.5, 0.5, 1)), outside(glm::vec3(-3, 4, 1));
+    gmh::LinSeg seg(gmh::Point(glm::vec3(-3, 0, 0)), gmh::Point(glm::vec3(-3, 0, 6)));
+    gmh::Plane plane(gmh::Point(glm::vec3(0, 0, -2)), gmh::Point(glm::vec3(1, 0, -2)), gmh::Point(glm::vec3(0, 1, -2)));
+    gmh::Polyhedron other = built(glm::translate(glm::mat4(1), glm::vec3(-1, 4, 0)));
+    EXPECT_NEAR(0, gmh::dist(gmh::shape(inst), gmh::shape(inside)), 1e-5);
+    EXPECT_NEAR(poly.dist(outside), gmh::dist(gmh::shape(outside), gmh::shape(inst)), 1e-4);
+    EXPECT_NEAR(poly.dist(seg), inst.dist(seg), 1e-4);
+    EXPECT_NEAR(poly.dist(plane), inst.dist(plane), 1e-4);
+    EXPECT_NEAR(poly.dist(other), gmh::dist(gmh::shape(other), gmh::shape(inst)), 1e-4);
+
+    gmh::Instance copy(crate, glm::translate(glm::mat4(1), glm::vec3(-1, 4, 0)));
+    EXPECT_NEAR(poly.dist(other), inst.dist(copy), 1e-4);
+    EXPECT_EQ(poly.intersection(other).size(), inst.intersection(copy).size());
+}
+
+TEST_F(InstanceInitTest, Handler){
+    gmh::Polyhedron floor(scene::floor_corners());
+    for(gmh::ContactMethod method: {gmh::ContactMethod::Clip, gmh::ContactMethod::SAT}){
+        gmh::Instance box(crate);
+        gmh::CHandler handler(0.5, 1);
+        handler.contact_method(method);
+        gmh::BodyId ground = handler.add(&floor, 1, true), body = handler.add(&box, crate->mass());
+        box.vel = glm::vec3(0, 0, -1);
+        handler();
+        EXPECT_NEAR(0.5, box.vel.z, 1e-5);
+        const gmh::Manifold* contact = handler.manifold(ground, body);
+        ASSERT_NE(nullptr, contact);
+        EXPECT_NEAR(1, contact->normal.z, 1e-5);
+        EXPECT_EQ(4, contact->count);
+        for(unsigned int i = 0; i < contact->count; i++) EXPECT_NEAR(0, contact->points[i].z, 1e-5);
+    }
+}
+
+TEST_F(InstanceInitTest, Containment){
+    gmh::Instance inst(crate, place);
+    gmh::Polyhedron poly = built(place);
+    // A box around the crate holds its extent but not the rotated crate itself.
+    gmh::Extent ext = inst.extent();
+    glm::vec3 lo = ext.box.min - glm::vec3(0.1), hi = ext.box.max + glm::vec3(0.1);
+    gmh::Polyhedron around(lo, glm::vec3(hi.x, lo.y, lo.z), glm::vec3(lo.x, hi.y, lo.z), glm::vec3(hi.x, hi.y, lo.z),
+        glm::vec3(lo.x, lo.y, hi.z), glm::vec3(hi.x, lo.y, hi.z), glm::vec3(lo.x, hi.y, hi.z), hi);
+    EXPECT_TRUE(around.contains(inst));
+    EXPECT_TRUE(poly.contains(inst));
+    EXPECT_TRUE(inst.contains(poly));
+    EXPECT_TRUE(inst.equals(poly));
+    EXPECT_TRUE(poly.equals(inst));
+
+    gmh::Instance shrunk(crate, glm::scale(place, glm::vec3(0.5)));
+    EXPECT_TRUE(inst.contains(shrunk));
+    EXPECT_FALSE(shrunk.contains(inst));
+    EXPECT_FALSE(inst.equals(shrunk));
+    // The box of the turned crate holds the small one, which sits in a corner the crate leaves empty.
+    gmh::Instance big(crate, glm::translate(glm::scale(glm::rotate(glm::mat4(1), glm::pi<float>()/4, glm::vec3(0, 0, 1)), glm::vec3(2)), glm::vec3(-0.5)));
+    gmh::Instance corner(crate, glm::scale(glm::translate(glm::mat4(1), glm::vec3(-1.4, -1.4, -0.25)), glm::vec3(0.5)));
+    ASSERT_TRUE(big.extent().box.contains(corner.extent().box));
+    EXPECT_FALSE(big.contains(corner));
+    EXPECT_FALSE(big.equals(corner));
+    EXPECT_FALSE(corner.equals(big));
+    EXPECT_TRUE(inst.equals(gmh::Instance(crate, place)));
+}
+
+TEST_F(InstanceInitTest, Symmetric){
+    gmh::Instance inst(crate, place);
+    gmh::Point outside(glm::vec3(-3, 4, 1));
+    gmh::Line line(gmh::Point(glm::vec3(-3, 0, 0)), gmh::Point(glm::vec3(-3, 1, 0)));
+    gmh::LinSeg seg(gmh::Point(glm::vec3(-3, 0, 0)), gmh::Point(glm::vec3(-3, 0, 6)));
+    gmh::Plane plane(gmh::Point(glm::vec3(0, 0, -2)), gmh::Point(glm::vec3(1, 0, -2)), gmh::Point(glm::vec3(0, 1, -2)));
+    gmh::Polygon square(std::vector<gmh::Point>{glm::vec3(-4, 3, 0), glm::vec3(-2, 3, 0), glm::vec3(-2, 5, 0), glm::vec3(-4, 5, 0)});
+    gmh::Polyhedron other = built(glm::translate(glm::mat4(1), glm::vec3(-1, 4, 0)));
+    EXPECT_NEAR(inst.dist(outside), outside.dist(inst), 1e-5);
+    EXPECT_NEAR(inst.dist(line), line.dist(inst), 1e-5);
+    EXPECT_NEAR(inst.dist(seg), seg.dist(inst), 1e-5);
+    EXPECT_NEAR(inst.dist(plane), plane.dist(inst), 1e-5);
+    EXPECT_NEAR(inst.dist(square), square.dist(inst), 1e-5);
+    EXPECT_NEAR(inst.dist(other), other.dist(inst), 1e-5);
+    EXPECT_GT(other.dist(inst), 0.1);
+    EXPECT_LT(other.dist(inst), other.dist(gmh::Point(inst.pos)));
+
+    gmh::Polyhedron touching = built(glm::translate(place, glm::vec3(0.5, 0, 0)));
+    gmh::Intersection a = inst.intersection(touching), b = touching.intersection(inst);
+    EXPECT_EQ(a.kind(), b.kind());
+    EXPECT_EQ(a.size(), b.size());
+    EXPECT_GT(a.size(), 0);
+    EXPECT_EQ(inst.intersection(plane).size(), plane.intersection(inst).size());
+}
+
+TEST_F(InstanceInitTest, PolyhedronFromMesh){
+    gmh::Instance inst(crate, place);
+    gmh::Polyhedron poly = inst.polyhedron(), hull = built(place);
+    // The faces come from the template as they are, in the same order.
+    for(unsigned int i = 0; i < poly.mesh().face_count(); i++) EXPECT_EQ(crate->mesh().face(i).size(), poly.mesh().face(i).size());
+    EXPECT_NEAR(1, poly.volume(), 1e-4);
+    EXPECT_EQ(hull.mesh().face_count(), poly.mesh().face_count());
+    EXPECT_EQ(hull.mesh().edge_count(), poly.mesh().edge_count());
+    for(unsigned int i = 0; i < 3; i++) EXPECT_NEAR(hull.pos[i], poly.pos[i], 1e-5);
+    EXPECT_TRUE(poly.equals(hull));
+    EXPECT_EQ(hull.faces.size(), poly.faces.size());
+}
+
+TEST_F(InstanceInitTest, DispatchOnDynamicType){
+    gmh::Instance inst(crate, place);
+    gmh::Polyhedron poly = built(place);
+    gmh::Plane plane(gmh::Point(glm::vec3(0, 0, -2)), gmh::Point(glm::vec3(1, 0, -2)), gmh::Point(glm::vec3(0, 1, -2)));
+    gmh::Line line(gmh::Point(glm::vec3(-3, 0, 0)), gmh::Point(glm::vec3(-3, 1, 0)));
+    gmh::Plane far(gmh::Point(glm::vec3(50, 0, 0)), gmh::Point(glm::vec3(50, 1, 0)), gmh::Point(glm::vec3(50, 0, 1)));
+    const gmh::Point &as_plane = plane, &as_line = line, &as_poly = poly, &as_far = far;
+    EXPECT_NEAR(poly.dist(plane), inst.dist(as_plane), 1e-4);
+    EXPECT_NEAR(poly.dist(line), inst.dist(as_line), 1e-4);
+    EXPECT_NEAR(0, inst.dist(as_poly), 1e-5);
+    // Planes and lines are unbounded, so one beside the crate is close however far its points are.
+    gmh::Line across(gmh::Point(glm::vec3(-100, 0.5, 0.5)), gmh::Point(glm::vec3(-99, 0.5, 0.5)));
+    const gmh::Point& as_across = across;
+    EXPECT_NEAR(0, gmh::Instance(crate).dist(as_across), 1e-5);
+    EXPECT_NEAR(poly.dist(far), inst.dist(as_far), 1e-4);
+    EXPECT_EQ(poly.intersection(plane).size(), inst.intersection(as_plane).size());
+    EXPECT_EQ(gmh::Intersection::Kind::Segment, gmh::Instance(crate).intersection(as_across).kind());
+}
+
+TEST_F(InstanceInitTest, IntersectionsMatchPolyhedron){
+    gmh::Instance inst(crate, place);
+    gmh::Polyhedron poly = built(place);
+    glm::vec3 center = place*glm::vec4(0.5, 0.5, 0.5, 1);
+    gmh::Line line(gmh::Point(center), gmh::Point(center + glm::vec3(0.3, 1, 0.2)));
+    gmh::LinSeg seg(gmh::Point(center), gmh::Point(center + glm::vec3(2, 1, -1)));
+    gmh::Plane plane(gmh::Point(center), gmh::Point(center + glm::vec3(1, 0, 0)), gmh::Point(center + glm::vec3(0, 1, 0.2)));
+    gmh::Polygon square(std::vector<gmh::Point>{center + glm::vec3(-1, -1, 0), center + glm::vec3(1, -1, 0), center + glm::vec3(1, 1, 0), center + glm::vec3(-1, 1, 0)});
+    glm::mat4 shifted = glm::translate(glm::mat4(1), glm::vec3(0.4, 0.3, 0.2))*place;
+    gmh::Polyhedron other = built(shifted);
+    gmh::Instance copy(crate, shifted);
+
+    auto same = [](const gmh::Intersection& expected, const gmh::Intersection& actual){
+        EXPECT_EQ(expected.kind(), actual.kind());
+        ASSERT_EQ(expected.size(), actual.size());
+        for(const glm::vec3& p: expected)
+            EXPECT_TRUE(std::any_of(actual.begin(), actual.end(), [&p](const glm::vec3& q){return glm::distance(p, q) < 1e-4;}));
+    };
+    same(poly.intersection(line), inst.intersection(line));
+    same(poly.intersection(seg), inst.intersection(seg));
+    same(poly.intersection(plane), inst.intersection(plane));
+    same(poly.intersection(square), inst.intersection(square));
+    same(poly.intersection(other), inst.intersection(other));
+    same(poly.intersection(other), inst.intersection(copy));
+    same(poly.intersection(other), copy.intersection(inst));
+
+    gmh::Line apart(gmh::Point(center + glm::vec3(0, 0, 3)), gmh::Point(center + glm::vec3(1, 0.2, 3)));
+    EXPECT_NEAR(poly.dist(apart), inst.dist(apart), 1e-4);
+    EXPECT_FALSE(inst.intersection(apart));
+}
+
+TEST_F(InstanceInitTest, InstanceArray){
+    gmh::InstanceArray crates(crate);
+    crates.reserve(10);
+    for(unsigned int i = 0; i < 10; i++) crates.add(glm::translate(place, glm::vec3(2*i, 0, 0)), glm::vec3(0, 0, i));
+    ASSERT_EQ(10, crates.size());
+    EXPECT_EQ(2, crate.use_count());
+    EXPECT_EQ(sizeof(gmh::InstanceArray) + 10*60, crates.footprint());
+
+    gmh::Instance third(crate, glm::translate(place, glm::vec3(4, 0, 0)));
+    gmh::Instance made = crates.instance(2);
+    for(int i = 0; i < 16; i++) EXPECT_NEAR(glm::value_ptr(third.placement())[i], glm::value_ptr(made.placement())[i], 1e-5);
+    EXPECT_EQ(glm::vec3(0, 0, 2), made.vel);
+    gmh::Point probe(glm::vec3(-3, 4, 1));
+    EXPECT_NEAR(third.dist(probe), made.dist(probe), 1e-5);
+    EXPECT_TRUE(crates.extent(2).box.grown(1e-5).contains(third.extent().box));
+
+    crates.update(0.5);
+    crates.translate(3, glm::vec3(1, 0, 0));
+    glm::vec3 moved = glm::vec3(place*glm::vec4(6, 0, 0, 1)) + glm::vec3(1, 0, 1.5);
+    for(int i = 0; i < 3; i++) EXPECT_NEAR(moved[i], crates.placement(3)[3][i], 1e-5);
+
+    made.transform(glm::rotate(glm::mat4(1), 0.3f, glm::vec3(0, 0, 1)));
+    made.vel = glm::vec3(1, 2, 3);
+    crates.store(2, made);
+    EXPECT_EQ(glm::vec3(1, 2, 3), crates.velocity(2));
+    for(int i = 0; i < 16; i++) EXPECT_NEAR(glm::value_ptr(made.placement())[i], glm::value_ptr(crates.placement(2))[i], 1e-5);
+    EXPECT_THROW(gmh::InstanceArray(nullptr), std::invalid_argument);
+}
@@ -0,0 +1,130 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "Graphics/geometry.hpp"
+
+using Kind = gmh::Intersection::Kind;
+
+TEST(IntersectionInitTest, Kinds){
+    gmh::Intersection none;
+    EXPECT_FALSE(none);
+    EXPECT_EQ(Kind::Empty, none.kind());
+    EXPECT_EQ(0, none.size());
+
+    gmh::Intersection p = gmh::Intersection::point(glm::vec3(1, 2, 3));
+    ASSERT_TRUE(p);
+    EXPECT_EQ(Kind::Point, p.kind());
+    EXPECT_EQ(glm::vec3(1, 2, 3), p[0]);
+    EXPECT_TRUE(p.object()->equals(gmh::Point({1, 2, 3})));
+
+    gmh::Intersection s = gmh::Intersection::segment(glm::vec3(0, 0, 0), glm::vec3(1, 0, 0));
+    EXPECT_EQ(Kind::Segment, s.kind());
+    EXPECT_EQ(2, s.size());
+    EXPECT_TRUE(s.object()->equals(gmh::LinSeg(glm::vec3(0, 0, 0), glm::vec3(1, 0, 0))));
+}
+
+TEST(IntersectionInitTest, Resolve){
+    gmh::Intersection points;
+    EXPECT_EQ(Kind::Empty, points.resolve().kind());
+    points.add(glm::vec3(1, 0, 0));
+    points.add(glm::vec3(1, 0, 0));
+    EXPECT_EQ(Kind::Point, points.resolve().kind());
+    points.add(glm::vec3(0, 1, 0));
+    points.add(glm::vec3(0, 0, 0));
+    EXPECT_EQ(Kind::Polygon, points.resolve().kind());
+    EXPECT_EQ(3, points.size());
+    EXPECT_TRUE(points.object()->equals(gmh::Polygon(glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0))));
+    points.add(glm::vec3(0, 0, 1));
+    EXPECT_EQ(Kind::Polygon, gmh::Intersection(points).resolve().kind());
+    EXPECT_EQ(Kind::Polyhedron, gmh::Intersection(points).resolve(~0u, true).kind());
+    EXPECT_EQ(Kind::Segment, points.resolve(2).kind());
+    EXPECT_EQ(2, points.size());
+}
+
+TEST(IntersectionInitTest, PolygonOrder){
+    // More vertices than fit inline, added out of order around the circle.
+    gmh::Intersection points;
+    unsigned int n = 2*gmh::Intersection::capacity + 1;
+    for(unsigned int i = 0; i < n; i++){
+        float theta = (7*i%n)*2*glm::pi<float>()/n;
+        points.add(glm::vec3(std::cos(theta), std::sin(theta), 0));
+    }
+    ASSERT_EQ(n, points.size());
+    ASSERT_EQ(Kind::Polygon, points.resolve().kind());
+    glm::vec3 normal = glm::cross(points[1] - points[0], points[2] - points[0]);
+    for(unsigned int i = 0; i < n; i++){
+        const glm::vec3& a = points[i];
+        const glm::vec3& b = points[(i + 1)%n];
+        const glm::vec3& c = points[(i + 2)%n];
+        EXPECT_GT(glm::dot(glm::cross(b - a, c - a), normal), 0);
+    }
+    std::vector<gmh::Point> vert(points.begin(), points.end());
+    EXPECT_TRUE(points.object()->equals(gmh::Polygon(vert)));
+}
+
+TEST(IntersectionInitTest, MatchesIntersect){
+    gmh::Polyhedron cube(glm::vec3(1, 1, 1), glm::vec3(1, 1, -1), glm::vec3(1, -1, 1), glm::vec3(1, -1, -1),
+        glm::vec3(-1, 1, 1), glm::vec3(-1, 1, -1), glm::vec3(-1, -1, 1), glm::vec3(-1, -1, -1));
+    gmh::LinSeg through(glm::vec3(-2, 0.5, 0), glm::vec3(2, 0.5, 0));
+    gmh::Intersection inter = cube.intersection(through);
+    ASSERT_EQ(Kind::Segment, inter.kind());
+    EXPECT_TRUE(inter.object()->equals(gmh::LinSeg(glm::vec3(-1, 0.5, 0), glm::vec3(1, 0.5, 0))));
+    EXPECT_TRUE(cube.intersect(through)->equals(*inter.object()));
+
+    gmh::Line touch(glm::vec3(1, 1, 1), glm::vec3(2, 2, 0));
+    EXPECT_EQ(Kind::Point, cube.intersection(touch).kind());
+    EXPECT_EQ(Kind::Point, touch.intersection(cube).kind());
+
+    gmh::Plane plane(glm::vec3(0, 0, 0.5), glm::vec3(1, 0, 0.5), glm::vec3(0, 1, 0.5));
+    inter = plane.intersection(cube);
+    ASSERT_EQ(Kind::Polygon, inter.kind());
+    EXPECT_EQ(4, inter.size());
+    EXPECT_EQ(Kind::Line, plane.intersection(gmh::Plane(glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 0, 1))).kind());
+    EXPECT_EQ(Kind::Plane, plane.intersection(plane).kind());
+
+    gmh::Polyhedron shifted(glm::vec3(2, 1, 1), glm::vec3(2, 1, -1), glm::vec3(2, -1, 1), glm::vec3(2, -1, -1),
+        glm::vec3(0, 1, 1), glm::vec3(0, 1, -1), glm::vec3(0, -1, 1), glm::vec3(0, -1, -1));
+    EXPECT_EQ(Kind::Polyhedron, cube.intersection(shifted).kind());
+    EXPECT_FALSE(cube.intersection(gmh::Point({3, 0, 0})));
+}
+
+TEST(IntersectionInitTest, Clip){
+    gmh::Polygon square(glm::vec3(1, 1, 0), glm::vec3(-1, 1, 0), glm::vec3(1, -1, 0), glm::vec3(-1, -1, 0));
+    gmh::Polygon diamond(glm::vec3(1.2, 0, 0), glm::vec3(0, 1.2, 0), glm::vec3(-1.2, 0, 0), glm::vec3(0, -1.2, 0));
+    gmh::Intersection octagon = square.intersection(diamond);
+    ASSERT_EQ(Kind::Polygon, octagon.kind());
+    ASSERT_EQ(8, octagon.size());
+    glm::vec3 normal = glm::cross(octagon[1] - octagon[0], octagon[2] - octagon[0]);
+    for(unsigned int i = 0; i < octagon.size(); i++){
+        EXPECT_NEAR(0, diamond.dist(gmh::Point(octagon[i])), 1e-5);
+        EXPECT_NEAR(0, square.dist(gmh::Point(octagon[i])), 1e-5);
+        const glm::vec3& a = octagon[i];
+        const glm::vec3& b = octagon[(i + 1)%octagon.size()];
+        const glm::vec3& c = octagon[(i + 2)%octagon.size()];
+        EXPECT_GT(glm::dot(glm::cross(b - a, c - a), normal), 0);
+    }
+
+    gmh::Polyhedron cube(glm::vec3(1, 1, 1), glm::vec3(1, 1, -1), glm::vec3(1, -1, 1), glm::vec3(1, -1, -1),
+        glm::vec3(-1, 1, 1), glm::vec3(-1, 1, -1), glm::vec3(-1, -1, 1), glm::vec3(-1, -1, -1));
+    gmh::Polygon big(glm::vec3(3, 3, 0.5), glm::vec3(-3, 3, 0.5), glm::vec3(3, -3, 0.5), glm::vec3(-3, -3, 0.5));
+    gmh::Intersection inter = big.intersection(cube);
+    ASSERT_EQ(Kind::Polygon, inter.kind());
+    EXPECT_EQ(4, inter.size());
+    EXPECT_TRUE(inter.object()->equals(gmh::Polygon(glm::vec3(1, 1, 0.5), glm::vec3(-1, 1, 0.5), glm::vec3(1, -1, 0.5), glm::vec3(-1, -1, 0.5))));
+    EXPECT_EQ(Kind::Polygon, cube.intersection(big).kind());
+
+    gmh::Polygon corner(glm::vec3(1, 1, 1), glm::vec3(2, 1, 1), glm::vec3(1, 2, 1));
+    EXPECT_EQ(Kind::Point, corner.intersection(cube).kind());
+    gmh::Polygon edge(glm::vec3(1, 1, 1), glm::vec3(1, -1, 1), glm::vec3(2, 0, 2));
+    EXPECT_EQ(Kind::Segment, edge.intersection(cube).kind());
+
+    gmh::Polygon cross(glm::vec3(0, 0, -2), glm::vec3(0, 0, 2), glm::vec3(0, 2, 0));
+    inter = square.intersection(cross);
+    ASSERT_EQ(Kind::Segment, inter.kind());
+    EXPECT_TRUE(inter.object()->equals(gmh::LinSeg(glm::vec3(0, 0, 0), glm::vec3(0, 1, 0))));
+
+    const glm::vec4* planes = cube.mesh().planes.data();
+    unsigned int faces = cube.mesh().face_count();
+    EXPECT_EQ(Kind::Segment, gmh::Intersection::clip(glm::vec3(-3, 0, 0), glm::vec3(3, 0, 0), planes, faces).kind());
+    EXPECT_EQ(Kind::Point, gmh::Intersection::clip(glm::vec3(1, 1, 1), glm::vec3(3, 3, 3), planes, faces).kind());
+    EXPECT_FALSE(gmh::Intersection::clip(glm::vec3(2, 0, 0), glm::vec3(3, 0, 0), planes, faces));
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "Graphics/collision.hpp"
+#include "Graphics/geometry.hpp"
+#include "scene.hpp"
+
+struct IslandInitTest: public ::testing::Test {
+    gmh::Polyhedron floor{scene::floor_corners()};
+    std::unique_ptr<gmh::Polyhedron> lower = scene::crate(glm::vec3(0, 0, 0)), upper = scene::crate(glm::vec3(0, 0, 1)), apart = scene::crate(glm::vec3(3, 3, 0));
+    gmh::CHandler handler{0.5, 1};
+    gmh::BodyId ground, low, up, far;
+
+    virtual void SetUp() override {
+        handler.sleeping(0.05, 5);
+        ground = handler.add(&floor, 1, true);
+        low = handler.add(lower.get());
+        up = handler.add(upper.get());
+        far = handler.add(apart.get());
+    }
+
+    void step(){
+        for(gmh::Polyhedron* p: {lower.get(), upper.get(), apart.get()}) p->update(1/60.f);
+        handler();
+    }
+};
+
+TEST_F(IslandInitTest, Sleep){
+    upper->vel = glm::vec3(0.01, 0, 0);
+    for(unsigned int i = 0; i < 4; i++) step();
+    EXPECT_FALSE(handler.get(low)->asleep);
+    step();
+    EXPECT_TRUE(handler.get(low)->asleep);
+    EXPECT_TRUE(handler.get(up)->asleep);
+    EXPECT_TRUE(handler.get(far)->asleep);
+    EXPECT_FALSE(handler.get(ground)->asleep);
+    EXPECT_EQ(glm::vec3(0), upper->vel);
+    // The stack sleeps as one island, apart from the lone cube.
+    EXPECT_EQ(handler.get(low)->island, handler.get(up)->island);
+    EXPECT_NE(handler.get(low)->island, handler.get(far)->island);
+    EXPECT_NE(nullptr, handler.manifold(low, up));
+}
+
+TEST_F(IslandInitTest, Wake){
+    for(unsigned int i = 0; i < 5; i++) step();
+    ASSERT_TRUE(handler.get(up)->asleep);
+    handler.velocity(up, glm::vec3(0, 0, 1));
+    EXPECT_FALSE(handler.get(up)->asleep);
+    EXPECT_FALSE(handler.get(low)->asleep);
+    EXPECT_TRUE(handler.get(far)->asleep);
+    EXPECT_EQ(glm::vec3(0, 0, 1), upper->vel);
+}
+
+TEST_F(IslandInitTest, WakeOnContact){
+    for(unsigned int i = 0; i < 5; i++) step();
+    ASSERT_TRUE(handler.get(far)->asleep);
+    std::unique_ptr<gmh::Polyhedron> thrown = scene::crate(glm::vec3(3, 3, 1.01));
+    gmh::BodyId id = handler.add(thrown.get());
+    thrown->vel = glm::vec3(0, 0, -1);
+    for(unsigned int i = 0; i < 3; i++){
+        thrown->update(1/60.f);
+        handler();
+    }
+    EXPECT_FALSE(handler.get(far)->asleep);
+    EXPECT_TRUE(handler.get(low)->asleep);
+    EXPECT_LT(0, thrown->vel.z);
+    EXPECT_NE(nullptr, handler.get(id));
+}
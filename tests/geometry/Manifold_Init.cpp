@@ -0,0 +1,47 @@
+#include <gtest/gtest.h>
+#include "Graphics/collision.hpp"
+#include "Graphics/geometry.hpp"
+#include "scene.hpp"
+
+struct ManifoldInitTest: public ::testing::Test {
+    gmh::Polyhedron floor{scene::floor_corners()};
+    gmh::Polyhedron cube{glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(1, 1, 0),
+        glm::vec3(0, 0, 1), glm::vec3(1, 0, 1), glm::vec3(0, 1, 1), glm::vec3(1, 1, 1)};
+    gmh::CHandler handler{0.5, 1};
+    gmh::BodyId ground, box;
+
+    virtual void SetUp() override {
+        ground = handler.add(&floor, 1, true);
+        box = handler.add(&cube);
+    }
+};
+
+TEST_F(ManifoldInitTest, Resting){
+    handler();
+    const gmh::Manifold* contact = handler.manifold(box, ground);
+    ASSERT_NE(nullptr, contact);
+    ASSERT_NE(gmh::Manifold::none, contact->feature);
+    EXPECT_EQ(0, contact->owner);
+    EXPECT_NEAR(1, contact->normal.z, 1e-5);
+    ASSERT_EQ(4, contact->count);
+    for(unsigned int i = 0; i < contact->count; i++) EXPECT_NEAR(0, contact->points[i].z, 1e-5);
+    EXPECT_EQ(0, contact->impulse);
+    unsigned int feature = contact->feature;
+    for(unsigned int i = 0; i < 3; i++) handler();
+    EXPECT_EQ(feature, handler.manifold(ground, box)->feature);
+    EXPECT_EQ(glm::vec3(0), cube.vel);
+}
+
+TEST_F(ManifoldInitTest, Impact){
+    cube.vel = glm::vec3(0, 0, -1);
+    handler();
+    EXPECT_NEAR(0.5, cube.vel.z, 1e-5);
+    const gmh::Manifold* contact = handler.manifold(ground, box);
+    ASSERT_NE(nullptr, contact);
+    EXPECT_NEAR(1.5, contact->impulse, 1e-5);
+    EXPECT_EQ(4, contact->count);
+
+    cube.update(4);
+    handler();
+    EXPECT_EQ(nullptr, handler.manifold(ground, box));
+}
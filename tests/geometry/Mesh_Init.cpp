@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+#include <glm/gtc/matrix_transform.hpp>
+#include "Graphics/geometry.hpp"
+#include "Graphics/hash.hpp"
+
+struct MeshInitTest: public ::testing::Test {
+    gmh::Polygon poly;
+    gmh::Polyhedron polyhed;
+
+    virtual void SetUp() override {
+        poly = gmh::Polygon(glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(1, 1, 0));
+        polyhed = gmh::Polyhedron(glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(1, 1, 0), glm::vec3(0.5, 0.5, 1));
+    }
+};
+
+TEST_F(MeshInitTest, PolygonMesh){
+    const gmh::Mesh& m = poly.mesh();
+    ASSERT_EQ(4, m.verts.size());
+    ASSERT_EQ(4, m.edge_count());
+    ASSERT_EQ(1, m.face_count());
+    for(unsigned int i = 0; i < m.verts.size(); i++) EXPECT_EQ(poly.vertices[i]->pos, m.verts[i]);
+    for(unsigned int i = 0; i < m.edge_count(); i++){
+        EXPECT_EQ(poly.edges[i]->vertices[0]->pos, m.edge(i).a());
+        EXPECT_EQ(poly.edges[i]->vertices[1]->pos, m.edge(i).b());
+    }
+    EXPECT_EQ(4, m.face(0).size());
+    EXPECT_EQ(poly.normVec(), m.face(0).normal());
+}
+
+TEST_F(MeshInitTest, PolyhedronMesh){
+    const gmh::Mesh& m = polyhed.mesh();
+    ASSERT_EQ(5, m.verts.size());
+    ASSERT_EQ(8, m.edge_count());
+    ASSERT_EQ(5, m.face_count());
+    for(unsigned int i = 0; i < m.face_count(); i++){
+        ASSERT_EQ(polyhed.faces[i]->vertices.size(), m.face(i).size());
+        for(unsigned int k = 0; k < m.face(i).size(); k++) EXPECT_EQ(polyhed.faces[i]->vertices[k]->pos, m.face(i)[k]);
+        EXPECT_LT(0, m.face(i).sign_dist(polyhed.pos));
+    }
+    for(unsigned int i = 0; i < m.edge_count(); i++) EXPECT_FLOAT_EQ(polyhed.edges[i]->length(), glm::distance(m.edge(i).a(), m.edge(i).b()));
+}
+
+TEST_F(MeshInitTest, Refresh){
+    polyhed.transform(glm::translate(glm::mat4(1), glm::vec3(1, 2, 3)));
+    const gmh::Mesh& m = polyhed.mesh();
+    for(unsigned int i = 0; i < m.verts.size(); i++) EXPECT_EQ(polyhed.vertices[i]->pos, m.verts[i]);
+    for(std::shared_ptr<gmh::Polygon> face: polyhed.faces)
+        for(unsigned int i = 0; i < face->vertices.size(); i++) EXPECT_EQ(face->vertices[i]->pos, face->mesh().verts[i]);
+    EXPECT_FLOAT_EQ(1.0f/3.0f, polyhed.volume());
+    EXPECT_FLOAT_EQ(0, polyhed.dist(gmh::Point({1.5, 2.5, 3.5})));
+
+    polyhed.vel = glm::vec3(0, 0, -1);
+    polyhed.update(3);
+    EXPECT_FLOAT_EQ(0, polyhed.dist(gmh::Point({1.5, 2.5, 0.5})));
+    EXPECT_FLOAT_EQ(1, polyhed.dist(gmh::Point({1.5, 2.5, -1})));
+}
+
+TEST_F(MeshInitTest, PlaneEquation){
+    EXPECT_FLOAT_EQ(0, poly.sign_dist(gmh::Point({3, -2, 0})));
+    EXPECT_FLOAT_EQ(2, std::abs(poly.sign_dist(gmh::Point({3, -2, 2}))));
+    poly.transform(glm::rotate(glm::mat4(1), glm::pi<float>()/2, glm::vec3(1, 0, 0)));
+    EXPECT_NEAR(0, glm::length(glm::cross(poly.normVec(), glm::vec3(0, 1, 0))), 1e-5);
+    EXPECT_NEAR(0, poly.sign_dist(gmh::Point({3, 0, 5})), 1e-5);
+    EXPECT_NEAR(0, poly.mesh().face(0).sign_dist({3, 0, 5}), 1e-5);
+    EXPECT_NEAR(1, poly.dist(gmh::Point({0.5, 1, 0.5})), 1e-5);
+    EXPECT_NEAR(1, poly.dist(gmh::Point({2, 0, 0.5})), 1e-5);
+
+    for(unsigned int i = 0; i < polyhed.mesh().face_count(); i++)
+        EXPECT_GT(polyhed.mesh().face(i).sign_dist(polyhed.pos), 0);
+    polyhed.transform(glm::rotate(glm::mat4(1), 1.0f, glm::vec3(1, 2, 3)));
+    for(unsigned int i = 0; i < polyhed.mesh().face_count(); i++){
+        gmh::Mesh::Face face = polyhed.mesh().face(i);
+        EXPECT_GT(face.sign_dist(polyhed.pos), 0);
+        for(unsigned int k = 0; k < face.size(); k++) EXPECT_NEAR(0, face.sign_dist(face[k]), 1e-5);
+    }
+}
+
+TEST_F(MeshInitTest, HalfEdge){
+    const gmh::Mesh& m = polyhed.mesh();
+    ASSERT_TRUE(m.linked());
+    ASSERT_EQ(2*m.edge_count(), m.half.size());
+    for(unsigned int h = 0; h < m.half.size(); h++){
+        const gmh::Mesh::HalfEdge& half = m.half[h];
+        ASSERT_NE(gmh::Mesh::none, half.twin);
+        EXPECT_EQ(h, m.half[half.twin].twin);
+        EXPECT_EQ(half.origin, m.target(half.twin));
+        EXPECT_EQ(m.half[half.next].face, half.face);
+        EXPECT_NE(half.face, m.half[half.twin].face);
+    }
+    for(unsigned int v = 0; v < m.verts.size(); v++){
+        unsigned int degree = 0;
+        for(unsigned int i = 0; i < m.edge_count(); i++) degree += m.edge_idx[i][0] == v || m.edge_idx[i][1] == v;
+        std::vector<unsigned int> ring;
+        m.vertex_ring(v, [&ring](unsigned int n){ring.push_back(n);});
+        EXPECT_EQ(degree, ring.size());
+    }
+    unsigned int neighbors = 0;
+    for(unsigned int i = 0; i < m.face_count(); i++) m.face_ring(i, [&neighbors](unsigned int){neighbors++;});
+    EXPECT_EQ(m.half.size(), neighbors);
+    for(unsigned int i = 0; i < m.edge_count(); i++){
+        std::array<unsigned int, 2> faces = m.edge_faces(i);
+        EXPECT_NE(faces[0], faces[1]);
+        EXPECT_NE(gmh::Mesh::none, faces[1]);
+    }
+    EXPECT_FALSE(poly.mesh().linked());
+}
+
+TEST_F(MeshInitTest, Support){
+    std::vector<glm::vec3> points;
+    for(unsigned int i = 0; i < 200; i++){
+        float z = 1 - 2*(i + 0.5f)/200;
+        float theta = i*glm::pi<float>()*(3 - std::sqrt(5.0f));
+        points.emplace_back(std::sqrt(1 - z*z)*std::cos(theta), std::sqrt(1 - z*z)*std::sin(theta), z);
+    }
+    gmh::Polyhedron sphere(std::vector<gmh::Point>(points.begin(), points.end()));
+    const gmh::Mesh& m = sphere.mesh();
+    for(unsigned int i = 0; i < 100; i++){
+        glm::vec3 dir(std::cos(i*0.7f), std::sin(i*1.3f), std::cos(i*2.1f));
+        float max = -std::numeric_limits<float>::infinity();
+        for(const glm::vec3& p: m.verts) max = std::max(max, glm::dot(p, dir));
+        EXPECT_FLOAT_EQ(max, glm::dot(m.verts[m.support(dir, (37*i)%m.verts.size())], dir));
+        EXPECT_FLOAT_EQ(max, glm::dot(sphere.support(dir), dir));
+    }
+    EXPECT_EQ(glm::vec3(0.5, 0.5, 1), polyhed.support(glm::vec3(0, 0, 1)));
+    EXPECT_EQ(glm::vec3(1, 1, 0), poly.support(glm::vec3(1, 1, 0)));
+}
+
+TEST_F(MeshInitTest, GraphOnDemand){
+    gmh::Polyhedron crate{glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(1, 1, 0),
+        glm::vec3(0, 0, 1), glm::vec3(1, 0, 1), glm::vec3(0, 1, 1), glm::vec3(1, 1, 1)};
+    gmh::Polyhedron twin = crate;
+    glm::mat4 turn = glm::rotate(glm::translate(glm::mat4(1), glm::vec3(2, 0, 1)), 0.6f, glm::vec3(1, 1, 0));
+    crate.transform(turn);
+    EXPECT_NEAR(1, crate.volume(), 1e-5);
+    EXPECT_NEAR(0, crate.dist(gmh::Point(crate.pos)), 1e-5);
+
+    // The graph is built from the mesh as it stands, and follows it from then on.
+    const gmh::Mesh& m = crate.mesh();
+    ASSERT_EQ(m.verts.size(), crate.vertices.size());
+    ASSERT_EQ(m.edge_count(), crate.edges.size());
+    ASSERT_EQ(m.face_count(), crate.faces.size());
+    for(unsigned int i = 0; i < m.edge_count(); i++){
+        EXPECT_EQ(m.edge(i).a(), crate.edges[i]->vertices[0]->pos);
+        EXPECT_EQ(m.edge(i).b(), crate.edges[i]->vertices[1]->pos);
+    }
+    for(unsigned int i = 0; i < m.face_count(); i++){
+        ASSERT_EQ(m.face(i).size(), crate.faces[i]->vertices.size());
+        for(unsigned int k = 0; k < m.face(i).size(); k++) EXPECT_EQ(crate.vertices[m.face(i).index(k)], crate.faces[i]->vertices[k]);
+        EXPECT_NEAR(0, glm::distance(m.face(i).normal(), crate.faces[i]->normVec()), 1e-5);
+    }
+    crate.translate(glm::vec3(0, 3, 0));
+    for(unsigned int i = 0; i < m.verts.size(); i++) EXPECT_EQ(crate.mesh().verts[i], crate.vertices[i]->pos);
+    EXPECT_NEAR(0, crate.faces[0]->dist(*crate.vertices[m.face(0).index(0)]), 1e-5);
+
+    // Copies made before the graph was built do not share it.
+    twin.translate(glm::vec3(0, 0, -5));
+    EXPECT_EQ(glm::vec3(0, 0, -5), twin.mesh().verts[0]);
+    EXPECT_EQ(turn*glm::vec4(0, 0, 0, 1) + glm::vec4(0, 3, 0, 0), glm::vec4(crate.vertices[0]->pos, 1));
+
+    gmh::Polyhedron tetra;
+    EXPECT_FLOAT_EQ(1.0f/6.0f, tetra.volume());
+    ASSERT_EQ(6, tetra.edges.size());
+    for(unsigned int i = 0; i < 6; i++) EXPECT_EQ(tetra.mesh().edge(i).a(), tetra.edges[i]->vertices[0]->pos);
+    EXPECT_EQ(glm::vec3(0, 0, 1), gmh::Polygon().normVec());
+    EXPECT_EQ(3, gmh::Polygon().edges.size());
+}
+
+TEST_F(MeshInitTest, HashFromMesh){
+    gmh::Polyhedron crate{glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(1, 1, 0),
+        glm::vec3(0, 0, 1), glm::vec3(1, 0, 1), glm::vec3(0, 1, 1), glm::vec3(1, 1, 1)};
+    crate.translate(glm::vec3(0, 2, 0));
+    size_t sparse = std::hash<gmh::Point>()(crate);
+    gmh::Polyhedron twin = crate;
+    ASSERT_EQ(8, twin.vertices.size());
+    EXPECT_EQ(sparse, std::hash<gmh::Point>()(twin));
+    EXPECT_TRUE(crate == twin);
+    twin.translate(glm::vec3(1, 0, 0));
+    EXPECT_TRUE(crate != twin);
+    EXPECT_EQ(std::hash<gmh::Point>()(poly), std::hash<gmh::Point>()(gmh::Polygon(poly.vertices)));
+}
@@ -0,0 +1,51 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <cstring>
+#include "Graphics/collision.hpp"
+#include "Graphics/geometry.hpp"
+#include "scene.hpp"
+
+TEST(NarrowphaseInitTest, ThreadPool){
+    for(unsigned int threads: {1u, 4u}){
+        gmh::ThreadPool pool(threads);
+        EXPECT_EQ(threads, pool.size());
+        std::vector<unsigned int> hits(1000, 0);
+        std::vector<bool> used(threads, false);
+        pool.run(hits.size(), 7, [&](size_t begin, size_t end, unsigned int worker){
+            ASSERT_LT(worker, threads);
+            for(size_t i = begin; i < end; i++) hits[i]++;
+        });
+        EXPECT_TRUE(std::all_of(hits.begin(), hits.end(), [](unsigned int h){return h == 1;}));
+        pool.run(0, 7, [&](size_t, size_t, unsigned int){FAIL();});
+    }
+}
+
+// Velocities after stepping a crowd of drifting cubes, by number of threads.
+static std::vector<glm::vec3> simulate(unsigned int threads){
+    std::mt19937 gen(5);
+    std::uniform_real_distribution<float> drift(-1, 1);
+    std::vector<std::unique_ptr<gmh::Polyhedron>> cubes;
+    gmh::CHandler handler(0.5, threads);
+    for(unsigned int i = 0; i < 216; i++){
+        glm::vec3 c = 1.1f*glm::vec3(i%6, i/6%6, i/36);
+        cubes.push_back(scene::crate(c));
+        cubes.back()->vel = glm::vec3(drift(gen), drift(gen), drift(gen));
+        handler.add(cubes.back().get(), 1 + i%3);
+    }
+    for(unsigned int frame = 0; frame < 30; frame++){
+        for(std::unique_ptr<gmh::Polyhedron>& cube: cubes) cube->update(1/30.f);
+        handler();
+    }
+    std::vector<glm::vec3> out;
+    for(std::unique_ptr<gmh::Polyhedron>& cube: cubes) out.push_back(cube->vel);
+    return out;
+}
+
+TEST(NarrowphaseInitTest, Deterministic){
+    std::vector<glm::vec3> serial = simulate(1);
+    for(unsigned int threads: {2u, 8u}){
+        std::vector<glm::vec3> parallel = simulate(threads);
+        ASSERT_EQ(serial.size(), parallel.size());
+        EXPECT_EQ(0, std::memcmp(serial.data(), parallel.data(), serial.size()*sizeof(glm::vec3))) << threads << " threads";
+    }
+}
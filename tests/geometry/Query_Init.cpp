@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <memory>
+#include <algorithm>
+#include <glm/gtc/matrix_transform.hpp>
+#include "Graphics/query.hpp"
+#include "Graphics/instance.hpp"
+
+struct QueryInitTest: public ::testing::Test {
+    std::shared_ptr<const gmh::ShapeTemplate> crate = gmh::ShapeTemplate::make({glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(1, 1, 0),
+        glm::vec3(0, 0, 1), glm::vec3(1, 0, 1), glm::vec3(0, 1, 1), glm::vec3(1, 1, 1)});
+    std::vector<std::unique_ptr<gmh::Polyhedron>> cubes;
+    std::vector<gmh::Instance> crates;
+    gmh::Polygon floor{glm::vec3(-20, -20, -12), glm::vec3(20, -20, -12), glm::vec3(20, 20, -12), glm::vec3(-20, 20, -12)};
+    gmh::Plane ground{glm::vec3(0, 0, -15), glm::vec3(1, 0, -15), glm::vec3(0, 1, -15)};
+    std::vector<const gmh::Point*> shapes;
+    std::mt19937 gen{3};
+    std::uniform_real_distribution<float> spread{-10, 10};
+
+    QueryInitTest(){
+        crates.reserve(150);
+        for(unsigned int i = 0; i < 150; i++){
+            glm::vec3 c(spread(gen), spread(gen), spread(gen));
+            cubes.push_back(std::make_unique<gmh::Polyhedron>(c, c + glm::vec3(1, 0, 0), c + glm::vec3(0, 1, 0), c + glm::vec3(0, 0, 1)));
+            crates.emplace_back(crate, glm::rotate(glm::translate(glm::mat4(1), glm::vec3(spread(gen), spread(gen), spread(gen))), spread(gen), glm::vec3(1, 2, 3)));
+        }
+        for(const std::unique_ptr<gmh::Polyhedron>& obj: cubes) shapes.push_back(obj.get());
+        for(const gmh::Instance& obj: crates) shapes.push_back(&obj);
+        shapes.push_back(&floor);
+        shapes.push_back(&ground);
+    }
+
+    gmh::RayHit brute(const glm::vec3& origin, const glm::vec3& dir, float max){
+        gmh::RayHit best;
+        for(const gmh::Point* obj: shapes)
+            if(gmh::RayHit h = gmh::raycast(gmh::shape(*obj), origin, dir, max); h && h.dist < best.dist) best = h;
+        return best;
+    }
+    glm::vec3 direction(){
+        return glm::normalize(glm::vec3(spread(gen), spread(gen), spread(gen)));
+    }
+};
+
+TEST_F(QueryInitTest, SingleShapes){
+    std::shared_ptr<gmh::Polyhedron> cube = std::make_shared<gmh::Polyhedron>(glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(1, 1, 0),
+        glm::vec3(0, 0, 1), glm::vec3(1, 0, 1), glm::vec3(0, 1, 1), glm::vec3(1, 1, 1));
+    gmh::RayHit h = gmh::raycast(gmh::shape(*cube), glm::vec3(0.5, 0.5, 3), glm::vec3(0, 0, -1));
+    ASSERT_TRUE(h);
+    EXPECT_EQ(cube.get(), h.shape);
+    EXPECT_NEAR(2, h.dist, 1e-5);
+    EXPECT_NEAR(1, h.point.z, 1e-5);
+    EXPECT_NEAR(1, h.normal.z, 1e-5);
+    EXPECT_FALSE(gmh::raycast(gmh::shape(*cube), glm::vec3(0.5, 0.5, 3), glm::vec3(0, 0, -1), 1.5));
+    EXPECT_FALSE(gmh::raycast(gmh::shape(*cube), glm::vec3(0.5, 0.5, 3), glm::vec3(0, 0, 1)));
+    // A ray from inside a solid hits it where it starts.
+    EXPECT_NEAR(0, gmh::raycast(gmh::shape(*cube), glm::vec3(0.5, 0.5, 0.5), glm::vec3(1, 0, 0)).dist, 1e-6);
+
+    // An Instance is hit where the Polyhedron it stands for would be.
+    glm::mat4 place = glm::rotate(glm::translate(glm::mat4(1), glm::vec3(2, -1, 3)), 0.6f, glm::vec3(1, 1, 0));
+    gmh::Instance placed(crate, place);
+    std::vector<gmh::Point> moved;
+    for(const std::shared_ptr<gmh::Point>& p: cube->vertices) moved.emplace_back(glm::vec3(place*glm::vec4(p->pos, 1)));
+    cube = std::make_shared<gmh::Polyhedron>(moved);
+    for(unsigned int i = 0; i < 50; i++){
+        glm::vec3 origin(spread(gen), spread(gen), spread(gen)), dir = glm::normalize(glm::vec3(2, -1, 3) - origin + 0.1f*direction());
+        gmh::RayHit a = gmh::raycast(gmh::shape(*cube), origin, dir), b = gmh::raycast(gmh::shape(placed), origin, dir);
+        ASSERT_EQ(static_cast<bool>(a), static_cast<bool>(b));
+        if(!a) continue;
+        EXPECT_NEAR(a.dist, b.dist, 1e-4);
+        EXPECT_GT(0.01, glm::distance(a.normal, b.normal));
+    }
+
+    EXPECT_FALSE(gmh::raycast(gmh::shape(gmh::LinSeg(glm::vec3(0, 0, 0), glm::vec3(0, 0, 1))), glm::vec3(0, 0, -1), glm::vec3(0, 0, 1)));
+    EXPECT_FALSE(gmh::raycast(gmh::shape(floor), glm::vec3(30, 0, 0), glm::vec3(0, 0, -1)));
+    EXPECT_NEAR(12, gmh::raycast(gmh::shape(floor), glm::vec3(0, 0, 0), glm::vec3(0, 0, -1)).dist, 1e-5);
+}
+
+TEST_F(QueryInitTest, Raycast){
+    gmh::SceneQuery scene(shapes);
+    EXPECT_EQ(shapes.size(), scene.size());
+    unsigned int hits = 0;
+    for(unsigned int i = 0; i < 300; i++){
+        glm::vec3 origin(spread(gen), spread(gen), spread(gen)), dir = direction();
+        float max = i % 3 == 0 ? 8 : std::numeric_limits<float>::infinity();
+        gmh::RayHit a = brute(origin, dir, max), b = scene.raycast(origin, 3.0f*dir, max);
+        ASSERT_EQ(static_cast<bool>(a), static_cast<bool>(b));
+        if(!a) continue;
+        hits++;
+        EXPECT_NEAR(a.dist, b.dist, 1e-5*(1 + a.dist));
+        EXPECT_EQ(a.shape, b.shape);
+        EXPECT_NEAR(0, glm::dot(b.normal, b.normal) - 1, 1e-5);
+        EXPECT_GE(1e-5, glm::dot(b.normal, dir));
+    }
+    EXPECT_LT(100, hits);
+}
+
+TEST_F(QueryInitTest, Overlap){
+    gmh::SceneQuery scene(shapes);
+    for(unsigned int i = 0; i < 30; i++){
+        glm::vec3 c(spread(gen), spread(gen), spread(gen));
+        gmh::AABB box{c - 2.0f, c + 2.0f};
+        std::vector<const gmh::Point*> found, expect;
+        scene.overlap(box, found);
+        for(const gmh::Point* obj: shapes)
+            if(obj == &ground ? c.z - 2 <= -15 : obj->extent().box.overlaps(box)) expect.push_back(obj);
+        std::sort(found.begin(), found.end());
+        std::sort(expect.begin(), expect.end());
+        EXPECT_EQ(expect, found);
+
+        found.clear();
+        expect.clear();
+        scene.overlap(gmh::Sphere{c, 3}, found);
+        gmh::Point probe(c);
+        for(const gmh::Point* obj: shapes) if(gmh::dist(gmh::shape(*obj), &probe) <= 3) expect.push_back(obj);
+        std::sort(found.begin(), found.end());
+        std::sort(expect.begin(), expect.end());
+        EXPECT_EQ(expect, found);
+    }
+}
+
+TEST_F(QueryInitTest, Nearest){
+    gmh::SceneQuery scene(shapes);
+    for(unsigned int i = 0; i < 50; i++){
+        glm::vec3 p(spread(gen), spread(gen), spread(gen));
+        gmh::Point probe(p);
+        float expect = std::numeric_limits<float>::infinity(), d = -1;
+        for(const gmh::Point* obj: shapes) expect = std::min(expect, gmh::dist(gmh::shape(*obj), &probe));
+        const gmh::Point* found = scene.nearest(p, std::numeric_limits<float>::infinity(), &d);
+        ASSERT_NE(nullptr, found);
+        EXPECT_NEAR(expect, d, 1e-5);
+        EXPECT_NEAR(expect, gmh::dist(gmh::shape(*found), &probe), 1e-5);
+        if(expect > 0.5) EXPECT_EQ(nullptr, scene.nearest(p, 0.5));
+    }
+    EXPECT_EQ(nullptr, gmh::SceneQuery().nearest(glm::vec3(0)));
+    EXPECT_FALSE(gmh::SceneQuery().raycast(glm::vec3(0), glm::vec3(1, 0, 0)));
+}
+
+TEST_F(QueryInitTest, Refit){
+    gmh::SceneQuery scene(shapes);
+    glm::vec3 offset(0, 0, 40);
+    for(const std::unique_ptr<gmh::Polyhedron>& obj: cubes) obj->translate(offset);
+    for(gmh::Instance& obj: crates) obj.translate(offset);
+    scene.refit();
+    for(unsigned int i = 0; i < 100; i++){
+        glm::vec3 origin = offset + glm::vec3(spread(gen), spread(gen), spread(gen)), dir = direction();
+        gmh::RayHit a = brute(origin, dir, std::numeric_limits<float>::infinity()), b = scene.raycast(origin, dir);
+        ASSERT_EQ(static_cast<bool>(a), static_cast<bool>(b));
+        if(a) EXPECT_NEAR(a.dist, b.dist, 1e-5*(1 + a.dist));
+    }
+    std::vector<const gmh::Point*> found;
+    scene.overlap(gmh::AABB{glm::vec3(-20), glm::vec3(20, 20, 11)}, found);
+    std::sort(found.begin(), found.end());
+    std::vector<const gmh::Point*> expect{&floor, &ground};
+    std::sort(expect.begin(), expect.end());
+    EXPECT_EQ(expect, found);
+}
@@ -0,0 +1,54 @@
+#include <gtest/gtest.h>
+#include "Graphics/collision.hpp"
+#include "Graphics/geometry.hpp"
+
+TEST(RegistryInitTest, SlotMap){
+    gmh::SlotMap<int> map;
+    gmh::SlotId a = map.insert(1), b = map.insert(2), c = map.insert(3);
+    EXPECT_EQ(3, map.size());
+    EXPECT_TRUE(map.erase(a));
+    EXPECT_FALSE(map.erase(a));
+    EXPECT_EQ(nullptr, map.get(a));
+    EXPECT_EQ(2, *map.get(b));
+    EXPECT_EQ(3, *map.get(c));
+    EXPECT_EQ(2, map.size());
+    // The freed slot is reused with a new generation.
+    gmh::SlotId d = map.insert(4);
+    EXPECT_EQ(a.index, d.index);
+    EXPECT_NE(a, d);
+    EXPECT_EQ(nullptr, map.get(a));
+    EXPECT_EQ(4, *map.get(d));
+    int sum = 0;
+    for(unsigned int i = 0; i < map.size(); i++){
+        sum += map[i];
+        EXPECT_EQ(&map[i], map.get(map.id(i)));
+    }
+    EXPECT_EQ(9, sum);
+}
+
+TEST(RegistryInitTest, MovedBodies){
+    gmh::Polyhedron cube1(glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(1, 1, 0),
+        glm::vec3(0, 0, 1), glm::vec3(1, 0, 1), glm::vec3(0, 1, 1), glm::vec3(1, 1, 1));
+    gmh::Polyhedron cube2(glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(1, 1, 0),
+        glm::vec3(0, 0, 1), glm::vec3(1, 0, 1), glm::vec3(0, 1, 1), glm::vec3(1, 1, 1));
+    gmh::CHandler handler;
+    // Identical geometry no longer merges bodies.
+    gmh::BodyId id1 = handler.add(&cube1, 2);
+    gmh::BodyId id2 = handler.add(&cube2);
+    EXPECT_NE(id1, id2);
+    EXPECT_EQ(id1, handler.add(&cube1));
+    EXPECT_EQ(2, handler.size());
+    EXPECT_EQ(2, handler.get(id1)->mass);
+
+    cube1.vel = glm::vec3(1, 2, 3);
+    cube1.update(1);
+    handler();
+    EXPECT_NEAR(1, handler.get(id1)->bounds.min.x, 1e-4);
+    EXPECT_NEAR(3, handler.get(id1)->bounds.min.z, 1e-4);
+    EXPECT_NEAR(4, handler.get(id1)->bounds.max.z, 1e-4);
+    handler.remove(&cube1);
+    EXPECT_EQ(1, handler.size());
+    EXPECT_EQ(nullptr, handler.get(id1));
+    EXPECT_EQ(&cube2, handler.get(id2)->obj);
+    EXPECT_EQ(gmh::BodyId{}, handler.id(&cube1));
+}
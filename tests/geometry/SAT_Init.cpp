@@ -0,0 +1,112 @@
+#include <gtest/gtest.h>
+#include <cmath>
+#include "Graphics/geometry.hpp"
+#include "Graphics/collision.hpp"
+#include "Graphics/sat.hpp"
+#include "scene.hpp"
+
+static gmh::Polyhedron cube(glm::vec3 center, float half){
+    std::vector<gmh::Point> vert;
+    for(int i = 0; i < 8; i++)
+        vert.push_back(gmh::Point(center + half*glm::vec3(i & 1 ? 1 : -1, i & 2 ? 1 : -1, i & 4 ? 1 : -1)));
+    return gmh::Polyhedron(vert);
+}
+
+TEST(SATInitTest, Faces){
+    gmh::Polyhedron a = cube(glm::vec3(0), 1), b = cube(glm::vec3(3, 0, 0), 1);
+    gmh::SatAxis axis;
+    gmh::SatContact found = gmh::sat(a.mesh(), b.mesh(), axis);
+    EXPECT_NEAR(1, found.separation, 1e-5);
+    EXPECT_NEAR(1, found.normal.x, 1e-5);
+    EXPECT_EQ(gmh::SatAxis::Kind::Face1, axis.kind);
+    EXPECT_EQ(0, found.count);
+
+    // The cached axis still separates, so it is kept.
+    gmh::SatAxis cached = axis;
+    b.translate(glm::vec3(0.5, 0, 0));
+    found = gmh::sat(a.mesh(), b.mesh(), axis);
+    EXPECT_NEAR(1.5, found.separation, 1e-5);
+    EXPECT_EQ(cached.i, axis.i);
+
+    b.translate(glm::vec3(-2, 0.2, 0.1));
+    found = gmh::sat(a.mesh(), b.mesh(), axis);
+    EXPECT_NEAR(-0.5, found.separation, 1e-5);
+    EXPECT_NEAR(1, found.normal.x, 1e-5);
+    ASSERT_EQ(4, found.count);
+    for(unsigned int i = 0; i < found.count; i++){
+        EXPECT_NEAR(0.5, found.points[i].x, 1e-5);
+        EXPECT_LE(std::abs(found.points[i].y), 1 + 1e-5);
+        EXPECT_LE(std::abs(found.points[i].z), 1 + 1e-5);
+    }
+
+    found = gmh::sat(b.mesh(), a.mesh(), axis);
+    EXPECT_NEAR(-0.5, found.separation, 1e-5);
+    EXPECT_NEAR(-1, found.normal.x, 1e-5);
+}
+
+TEST(SATInitTest, CachedOverlap){
+    gmh::Polyhedron a = cube(glm::vec3(0), 1), b = cube(glm::vec3(1.9995, 0, 0), 1);
+    gmh::SatAxis axis;
+    gmh::SatContact found = gmh::sat(a.mesh(), b.mesh(), axis);
+    EXPECT_NEAR(-0.0005, found.separation, 1e-5);
+    EXPECT_NEAR(1, found.normal.x, 1e-5);
+
+    // Still overlapping along the cached axis, but apart along another.
+    b.translate(glm::vec3(0, 3, 0));
+    found = gmh::sat(a.mesh(), b.mesh(), axis);
+    EXPECT_NEAR(1, found.separation, 1e-5);
+    EXPECT_NEAR(1, found.normal.y, 1e-5);
+    EXPECT_EQ(0, found.count);
+}
+
+TEST(SATInitTest, Edges){
+    const float r = std::sqrt(2.0f), c = 2*r - 0.1f;
+    std::vector<gmh::Point> va, vb;
+    for(float s: {-1.0f, 1.0f}){
+        for(glm::vec3 p: {glm::vec3(r, s, 0), glm::vec3(-r, s, 0), glm::vec3(0, s, r), glm::vec3(0, s, -r)}) va.emplace_back(p);
+        for(glm::vec3 p: {glm::vec3(s, r, c), glm::vec3(s, -r, c), glm::vec3(s, 0, c + r), glm::vec3(s, 0, c - r)}) vb.emplace_back(p);
+    }
+    gmh::Polyhedron a(va), b(vb);
+    gmh::SatAxis axis;
+    gmh::SatContact found = gmh::sat(a.mesh(), b.mesh(), axis);
+    EXPECT_EQ(gmh::SatAxis::Kind::Edges, axis.kind);
+    EXPECT_NEAR(-0.1, found.separation, 1e-5);
+    EXPECT_NEAR(1, found.normal.z, 1e-5);
+    ASSERT_EQ(1, found.count);
+    EXPECT_NEAR(0, glm::distance(glm::vec3(0, 0, r - 0.05f), found.points[0]), 1e-5);
+}
+
+struct SATHandlerTest: public ::testing::Test {
+    gmh::Polyhedron floor{scene::floor_corners()};
+    gmh::Polyhedron box{glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(1, 1, 0),
+        glm::vec3(0, 0, 1), glm::vec3(1, 0, 1), glm::vec3(0, 1, 1), glm::vec3(1, 1, 1)};
+    gmh::CHandler handler{0.5, 1};
+    gmh::BodyId ground, body;
+
+    virtual void SetUp() override {
+        handler.contact_method(gmh::ContactMethod::SAT);
+        ground = handler.add(&floor, 1, true);
+        body = handler.add(&box);
+    }
+};
+
+TEST_F(SATHandlerTest, Impact){
+    box.vel = glm::vec3(0, 0, -1);
+    handler();
+    EXPECT_NEAR(0.5, box.vel.z, 1e-5);
+    const gmh::Manifold* contact = handler.manifold(ground, body);
+    ASSERT_NE(nullptr, contact);
+    EXPECT_NEAR(1.5, contact->impulse, 1e-5);
+    EXPECT_NEAR(1, contact->normal.z, 1e-5);
+    EXPECT_EQ(4, contact->count);
+    for(unsigned int i = 0; i < contact->count; i++) EXPECT_NEAR(0, contact->points[i].z, 1e-5);
+
+    // Apart but with overlapping bounds: the pair keeps the axis that separates it.
+    box.translate(glm::vec3(0, 0, 1.5e-5));
+    handler();
+    contact = handler.manifold(ground, body);
+    ASSERT_NE(nullptr, contact);
+    EXPECT_EQ(gmh::Manifold::none, contact->feature);
+    EXPECT_NE(gmh::SatAxis::Kind::None, contact->axis.kind);
+    EXPECT_NEAR(0.5, box.vel.z, 1e-5);
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "Graphics/shape.hpp"
+
+struct ShapeDistTest: public ::testing::Test {
+    gmh::Point point{glm::vec3(0.5, 0, 2)};
+    gmh::Line line{glm::vec3(-3, 0.5, 0.5), glm::vec3(3, 0.5, 0.5)};
+    gmh::LinSeg seg{glm::vec3(2, 2, -1), glm::vec3(2, 2, 3)};
+    gmh::Plane plane{glm::vec3(0, 0, -0.5), glm::vec3(1, 0, -0.5), glm::vec3(0, 1, -0.5)};
+    gmh::Polygon poly{glm::vec3(3, 1, 1), glm::vec3(3, -1, -1), glm::vec3(3, 1, -1), glm::vec3(3, -1, 1)};
+    gmh::Polyhedron polyhed{glm::vec3(0, 0, 1), glm::vec3(-1, 1, 0), glm::vec3(1, -1, 0), glm::vec3(-1, -1, 0), glm::vec3(1, 1, 0)};
+    std::vector<const gmh::Point*> objects{&point, &line, &seg, &plane, &poly, &polyhed};
+};
+
+TEST_F(ShapeDistTest, Resolve){
+    for(unsigned int i = 0; i < objects.size(); i++) EXPECT_EQ(i, gmh::shape(*objects[i]).index());
+    EXPECT_EQ(&poly, gmh::shape_cast<gmh::Polygon>(gmh::shape(poly)));
+    EXPECT_EQ(nullptr, gmh::shape_cast<gmh::Plane>(gmh::shape(poly)));
+
+    struct Derived: public gmh::Polyhedron {
+        using gmh::Polyhedron::Polyhedron;
+    } derived(glm::vec3(0, 0, 1), glm::vec3(-1, 1, 0), glm::vec3(1, -1, 0), glm::vec3(-1, -1, 0), glm::vec3(1, 1, 0));
+    EXPECT_EQ(&derived, gmh::shape_cast<gmh::Polyhedron>(gmh::shape(derived)));
+
+    // Classes whose dimension would pass for another type's still resolve to what they derive from.
+    struct Flat: public gmh::Polyhedron {
+        using gmh::Polyhedron::Polyhedron;
+        unsigned int dim() const override {return 2;}
+    } flat(glm::vec3(0, 0, 1), glm::vec3(-1, 1, 0), glm::vec3(1, -1, 0), glm::vec3(-1, -1, 0), glm::vec3(1, 1, 0));
+    EXPECT_EQ(&flat, gmh::shape_cast<gmh::Polyhedron>(gmh::shape(flat)));
+
+    struct Marker: public gmh::Point {
+        using gmh::Point::Point;
+        unsigned int dim() const override {return 3;}
+    } marker(glm::vec3(0));
+    EXPECT_THROW(gmh::shape(marker), std::invalid_argument);
+}
+
+TEST_F(ShapeDistTest, MatchesVirtual){
+    // Through base pointers the virtual overloads only see a Point, so compare against calls on the static types.
+    for(const gmh::Point* a: objects){
+        for(const gmh::Point* b: objects){
+            gmh::Shape sa = gmh::shape(*a), sb = gmh::shape(*b);
+            float expected = std::visit([](auto* x, auto* y){return x->dist(*y);}, sa, sb);
+            EXPECT_NEAR(expected, gmh::dist(sa, sb), 1e-5) << *a << std::endl << *b;
+            EXPECT_FLOAT_EQ(gmh::dist(sa, sb), gmh::dist(sb, sa));
+            gmh::Intersection inter = std::visit([](auto* x, auto* y){return x->intersection(*y);}, sa, sb);
+            EXPECT_EQ(inter.kind(), gmh::intersection(sa, sb).kind()) << *a << std::endl << *b;
+            EXPECT_EQ(inter.size(), gmh::intersection(sa, sb).size());
+        }
+    }
+}
+
+TEST_F(ShapeDistTest, DistMany){
+    std::vector<gmh::Shape> shapes;
+    for(const gmh::Point* obj: objects) shapes.push_back(gmh::shape(*obj));
+    std::vector<float> out(shapes.size());
+    gmh::dist_many(gmh::shape(polyhed), shapes.data(), shapes.size(), out.data());
+    EXPECT_FLOAT_EQ(polyhed.dist(point), out[0]);
+    EXPECT_FLOAT_EQ(polyhed.dist(line), out[1]);
+    EXPECT_FLOAT_EQ(polyhed.dist(seg), out[2]);
+    EXPECT_FLOAT_EQ(polyhed.dist(plane), out[3]);
+    EXPECT_FLOAT_EQ(polyhed.dist(poly), out[4]);
+    EXPECT_FLOAT_EQ(polyhed.dist(polyhed), out[5]);
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include <random>
+#include <cstring>
+#include "Graphics/world.hpp"
+#include "Graphics/geometry.hpp"
+#include "scene.hpp"
+
+struct SnapshotInitTest: public ::testing::Test {
+    gmh::Polyhedron floor{scene::floor_corners()};
+    std::vector<std::unique_ptr<gmh::Polyhedron>> crates;
+    std::vector<gmh::BodyId> ids;
+    gmh::PhysicsWorld world{1/60.f, 0.5, 1};
+
+    virtual void SetUp() override {
+        std::mt19937 gen(3);
+        std::uniform_real_distribution<float> drift(-2, 2);
+        world.sleeping(0.05, 10);
+        world.add(&floor, 1, true);
+        for(unsigned int i = 0; i < 27; i++){
+            glm::vec3 c = 1.1f*glm::vec3(i%3, i/3%3, i/9);
+            crates.push_back(scene::crate(c));
+            ids.push_back(world.add(crates.back().get()));
+            world.velocity(ids.back(), glm::vec3(drift(gen), drift(gen), drift(gen)));
+        }
+    }
+
+    // Positions and velocities of the crates after each of some frames.
+    std::vector<glm::vec3> run(unsigned int frames){
+        std::vector<glm::vec3> out;
+        for(unsigned int f = 0; f < frames; f++){
+            world.update(1/50.f);
+            for(gmh::BodyId id: ids){
+                out.push_back(world.position(id));
+                out.push_back(world.velocity(id));
+            }
+        }
+        return out;
+    }
+};
+
+TEST_F(SnapshotInitTest, Replay){
+    run(10);
+    gmh::Snapshot saved;
+    world.snapshot(saved);
+    std::vector<glm::vec3> first = run(60);
+    world.restore(saved);
+
+    gmh::Snapshot again;
+    world.snapshot(again);
+    ASSERT_EQ(saved.size(), again.size());
+    EXPECT_EQ(0, std::memcmp(saved.data(), again.data(), saved.size()));
+
+    std::vector<glm::vec3> second = run(60);
+    ASSERT_EQ(first.size(), second.size());
+    EXPECT_EQ(0, std::memcmp(first.data(), second.data(), first.size()*sizeof(glm::vec3)));
+}
+
+TEST_F(SnapshotInitTest, DifferentBodies){
+    gmh::Snapshot saved;
+    world.snapshot(saved);
+    world.remove(ids.back());
+    EXPECT_THROW(world.restore(saved), std::invalid_argument);
+    EXPECT_EQ(27, world.size());
+}
@@ -0,0 +1,66 @@
+#include <gtest/gtest.h>
+#include "Graphics/collision.hpp"
+#include "Graphics/geometry.hpp"
+#include "scene.hpp"
+
+// Fastest crate after pressing the top of a resting stack down, by solver iterations.
+static float press(unsigned int iterations, unsigned int threads){
+    gmh::Polyhedron floor(scene::floor_corners());
+    std::vector<std::unique_ptr<gmh::Polyhedron>> stack;
+    gmh::CHandler handler(0, threads);
+    handler.iterations(iterations);
+    handler.add(&floor, 1, true);
+    for(unsigned int i = 0; i < 6; i++){
+        stack.push_back(scene::crate(glm::vec3(0, 0, i)));
+        handler.add(stack.back().get());
+    }
+    stack.back()->vel = glm::vec3(0, 0, -1);
+    handler();
+    float fastest = 0;
+    for(const std::unique_ptr<gmh::Polyhedron>& c: stack) fastest = std::max(fastest, glm::length(c->vel));
+    return fastest;
+}
+
+TEST(SolverInitTest, Stack){
+    EXPECT_LT(0.2, press(1, 1));
+    EXPECT_GT(press(1, 1), press(8, 1));
+    EXPECT_GT(1e-2, press(64, 1));
+    EXPECT_EQ(press(64, 1), press(64, 4));
+}
+
+TEST(SolverInitTest, Restitution){
+    for(float elasticity: {0.0f, 0.5f, 1.0f}){
+        std::unique_ptr<gmh::Polyhedron> a = scene::crate(glm::vec3(0)), b = scene::crate(glm::vec3(1, 0, 0));
+        gmh::CHandler handler(elasticity, 1);
+        handler.add(a.get());
+        handler.add(b.get());
+        a->vel = glm::vec3(1, 0, 0);
+        b->vel = glm::vec3(-1, 0, 0);
+        handler();
+        EXPECT_NEAR(-elasticity, a->vel.x, 1e-5);
+        EXPECT_NEAR(elasticity, b->vel.x, 1e-5);
+        // Momentum is kept whatever the number of iterations.
+        EXPECT_NEAR(0, a->vel.x + b->vel.x, 1e-5);
+    }
+}
+
+TEST(SolverInitTest, WarmStart){
+    gmh::Polyhedron floor(scene::floor_corners());
+    std::vector<std::unique_ptr<gmh::Polyhedron>> stack;
+    gmh::CHandler handler(0, 1);
+    handler.iterations(2);
+    handler.add(&floor, 1, true);
+    for(unsigned int i = 0; i < 6; i++){
+        stack.push_back(scene::crate(glm::vec3(0, 0, i)));
+        handler.add(stack.back().get());
+    }
+    // Too few iterations to hold the stack up in one step, but each step starts from the last one's impulses.
+    for(unsigned int step = 0; step < 40; step++){
+        for(const std::unique_ptr<gmh::Polyhedron>& c: stack) c->vel.z -= 0.1f;
+        handler();
+    }
+    float fastest = 0;
+    for(const std::unique_ptr<gmh::Polyhedron>& c: stack) fastest = std::max(fastest, glm::length(c->vel));
+    EXPECT_GT(0.1, fastest);
+    EXPECT_LT(0.5, handler.manifold(handler.id(&floor), handler.id(stack[0].get()))->impulse);
+}
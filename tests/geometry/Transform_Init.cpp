@@ -0,0 +1,134 @@
+#include <gtest/gtest.h>
+#include <thread>
+#include <glm/gtc/matrix_transform.hpp>
+#include "Graphics/geometry.hpp"
+
+struct TransformInitTest: public ::testing::Test {
+    gmh::Polyhedron crate{glm::vec3(0, 0, 0), glm::vec3(1, 0, 0), glm::vec3(0, 1, 0), glm::vec3(1, 1, 0),
+        glm::vec3(0, 0, 1), glm::vec3(1, 0, 1), glm::vec3(0, 1, 1), glm::vec3(1, 1, 1)};
+    glm::mat4 turn = glm::rotate(glm::translate(glm::mat4(1), glm::vec3(3, -1, 2)), 0.7f, glm::vec3(1, 2, 3));
+
+    static void expect_near(const glm::vec3& expected, const glm::vec3& actual){
+        EXPECT_NEAR(expected.x, actual.x, 1e-5);
+        EXPECT_NEAR(expected.y, actual.y, 1e-5);
+        EXPECT_NEAR(expected.z, actual.z, 1e-5);
+    }
+};
+
+TEST_F(TransformInitTest, VerticesMoveOnQuery){
+    std::shared_ptr<gmh::Point> first = crate.vertices[0];
+    glm::vec3 corner = first->pos;
+    crate.translate(glm::vec3(5, 0, 0));
+    crate.translate(glm::vec3(0, 5, 0));
+    EXPECT_EQ(corner, first->pos);
+    expect_near(glm::vec3(5.5, 5.5, 0.5), crate.pos);
+
+    EXPECT_NEAR(0, crate.dist(gmh::Point(glm::vec3(5.5, 5.5, 0.5))), 1e-5);
+    expect_near(corner + glm::vec3(5, 5, 0), first->pos);
+    expect_near(corner + glm::vec3(5, 5, 0), crate.mesh().verts[0]);
+}
+
+TEST_F(TransformInitTest, AccessorsApplyPendingMove){
+    glm::vec3 corner = crate.vertices[0]->pos;
+    crate.translate(glm::vec3(0, 0, 4));
+    expect_near(corner + glm::vec3(0, 0, 4), crate.vertices[0]->pos);
+
+    crate.transform(turn);
+    for(const std::shared_ptr<gmh::LinSeg>& edge: crate.edges)
+        EXPECT_NEAR(1, glm::distance(edge->vertices[0]->pos, edge->vertices[1]->pos), 1e-5);
+    for(const std::shared_ptr<gmh::Polygon>& face: crate.faces){
+        for(const std::shared_ptr<gmh::Point>& p: face->vertices)
+            EXPECT_NEAR(0, face->sign_dist(*p), 1e-5);
+        EXPECT_NEAR(0, face->dist(*face->vertices[0]), 1e-5);
+    }
+    expect_near(crate.mesh().verts[0], crate.vertices[0]->pos);
+}
+
+TEST_F(TransformInitTest, TranslateInWorldSpace){
+    std::vector<glm::vec3> local = crate.mesh().verts;
+    gmh::Point marker;
+    marker.transform(turn);
+    marker.vel = glm::vec3(0, 0, 4);
+    marker.update(0.5);
+    crate.transform(turn);
+    crate.translate(glm::vec3(0, 0, 2));
+    glm::mat4 expected = glm::translate(glm::mat4(1), glm::vec3(0, 0, 2))*turn;
+    for(int i = 0; i < 16; i++){
+        EXPECT_NEAR(glm::value_ptr(expected)[i], crate.model_ptr()[i], 1e-5);
+        EXPECT_NEAR(glm::value_ptr(expected)[i], marker.model_ptr()[i], 1e-5);
+    }
+    for(unsigned int i = 0; i < local.size(); i++) expect_near(expected*glm::vec4(local[i], 1), crate.mesh().verts[i]);
+}
+
+TEST_F(TransformInitTest, AccessorsFollowCopies){
+    std::unique_ptr<gmh::Polyhedron> original = std::make_unique<gmh::Polyhedron>(crate);
+    original->translate(glm::vec3(0, 3, 0));
+    gmh::Polyhedron copy(*original);
+    gmh::Polygon side = *copy.faces[0];
+    original.reset();
+    EXPECT_EQ(8, copy.vertices.size());
+    EXPECT_EQ(12, copy.edges.size());
+    EXPECT_EQ(6, copy.faces.size());
+    expect_near(copy.mesh().verts[0], copy.vertices[0]->pos);
+    const std::vector<std::shared_ptr<gmh::LinSeg>>& edges = side.edges;
+    EXPECT_EQ(side.vertices.size(), edges.size());
+    side = *crate.faces[1];
+    EXPECT_EQ(crate.faces[1]->vertices[0], side.vertices[0]);
+}
+
+TEST_F(TransformInitTest, SupportThroughPendingMove){
+    gmh::Polyhedron moved = crate;
+    std::shared_ptr<gmh::Point> first = moved.vertices[0];
+    moved.transform(turn);
+    std::vector<glm::vec3> lazy;
+    unsigned int start = 0;
+    for(glm::vec3 dir: {glm::vec3(1, 0, 0), glm::vec3(-1, 2, 0), glm::vec3(0.3, -0.2, 1), glm::vec3(-1, -1, -1)})
+        lazy.push_back(moved.support(dir, start));
+    EXPECT_EQ(crate.vertices[0]->pos, first->pos);
+
+    moved.sync();
+    std::vector<glm::vec3> eager;
+    for(glm::vec3 dir: {glm::vec3(1, 0, 0), glm::vec3(-1, 2, 0), glm::vec3(0.3, -0.2, 1), glm::vec3(-1, -1, -1)})
+        eager.push_back(moved.support(dir, start));
+    for(unsigned int i = 0; i < lazy.size(); i++) expect_near(eager[i], lazy[i]);
+}
+
+TEST_F(TransformInitTest, QueriesMatchBuiltInPlace){
+    std::vector<gmh::Point> corners;
+    for(const std::shared_ptr<gmh::Point>& p: crate.vertices) corners.emplace_back(glm::vec3(turn*glm::vec4(p->pos, 1)));
+    gmh::Polyhedron built(corners);
+    gmh::Polygon face{glm::vec3(3, 3, -2), glm::vec3(8, 3, -2), glm::vec3(3, 8, -2)};
+    gmh::Point probe(glm::vec3(6, 4, -3));
+    crate.transform(turn);
+    face.translate(glm::vec3(0, 0, 4));
+    EXPECT_NEAR(built.dist(probe), crate.dist(probe), 1e-5);
+    EXPECT_NEAR(built.dist(face), crate.dist(face), 1e-5);
+    EXPECT_NEAR(built.volume(), crate.volume(), 1e-5);
+    expect_near(built.pos, crate.pos);
+}
+
+TEST_F(TransformInitTest, ConcurrentQueriesOnPendingMove){
+    gmh::Polyhedron built = crate;
+    built.transform(turn);
+    built.sync();
+    gmh::Point probe(glm::vec3(6, 4, -3));
+    float expected = built.dist(probe);
+    std::vector<gmh::Point> corners(crate.mesh().verts.begin(), crate.mesh().verts.end());
+    for(int round = 0; round < 20; round++){
+        gmh::Polyhedron moved(corners);
+        moved.transform(turn);
+        std::vector<float> dists(4);
+        std::vector<size_t> faces(4);
+        std::vector<std::thread> readers;
+        for(unsigned int i = 0; i < dists.size(); i++) readers.emplace_back([&, i](){
+            if(i%2) moved.support(glm::vec3(1, 1, 1));
+            dists[i] = moved.dist(probe);
+            faces[i] = moved.faces.size();
+        });
+        for(std::thread& reader: readers) reader.join();
+        for(unsigned int i = 0; i < dists.size(); i++){
+            EXPECT_NEAR(expected, dists[i], 1e-5);
+            EXPECT_EQ(6, faces[i]);
+        }
+    }
+}
@@ -0,0 +1,64 @@
+#include <gtest/gtest.h>
+#include "Graphics/world.hpp"
+#include "Graphics/geometry.hpp"
+#include "scene.hpp"
+
+struct WorldInitTest: public ::testing::Test {
+    gmh::Polyhedron floor{scene::floor_corners()};
+    gmh::Polyhedron cube{glm::vec3(0, 0, 2), glm::vec3(1, 0, 2), glm::vec3(0, 1, 2), glm::vec3(1, 1, 2),
+        glm::vec3(0, 0, 3), glm::vec3(1, 0, 3), glm::vec3(0, 1, 3), glm::vec3(1, 1, 3)};
+    gmh::PhysicsWorld world{0.1, 0.5, 1, 4};
+};
+
+TEST_F(WorldInitTest, FixedStep){
+    gmh::BodyId box = world.add(&cube);
+    world.velocity(box, glm::vec3(1, 0, 0));
+    EXPECT_EQ(0, world.update(0.05));
+    EXPECT_NEAR(0.5, world.alpha(), 1e-5);
+    EXPECT_NEAR(0.5, world.position(box).x, 1e-5);
+
+    EXPECT_EQ(2, world.update(0.2));
+    EXPECT_NEAR(0.5, world.alpha(), 1e-5);
+    EXPECT_NEAR(0.65, world.position(box).x, 1e-5);
+    EXPECT_NEAR(0.15, world.model(box)[3].x, 1e-5);
+
+    // Nothing touched the cube, so its vertices have not moved yet.
+    EXPECT_EQ(0.5, cube.pos.x);
+    world.materialize();
+    EXPECT_NEAR(0.7, cube.pos.x, 1e-5);
+    EXPECT_NEAR(0.2, cube.mesh().verts[0].x, 1e-5);
+    EXPECT_NEAR(0.15, world.model(box)[3].x, 1e-5);
+
+    EXPECT_EQ(4, world.update(1));
+    EXPECT_LT(world.alpha(), 1);
+}
+
+TEST_F(WorldInitTest, Contact){
+    world.add(&floor, 1, true);
+    gmh::BodyId box = world.add(&cube);
+    world.velocity(box, glm::vec3(0, 0, -10));
+    world.step();
+    world.step();
+    EXPECT_NEAR(5, world.velocity(box).z, 1e-4);
+    EXPECT_NEAR(0, cube.mesh().verts[0].z, 1e-4);
+    world.step();
+    EXPECT_NEAR(0.5, world.position(box).z, 1e-4);
+    world.update(0.05);
+    EXPECT_NEAR(0.75, world.position(box).z, 1e-4);
+}
+
+TEST_F(WorldInitTest, Remove){
+    gmh::BodyId ground = world.add(&floor, 1, true);
+    gmh::BodyId box = world.add(&cube);
+    EXPECT_EQ(box, world.add(&cube));
+    world.velocity(box, glm::vec3(0, 1, 0));
+    world.step();
+    world.remove(ground);
+    EXPECT_EQ(1, world.size());
+    EXPECT_NEAR(0.5, world.position(box).y, 1e-5);
+    world.update(0.1);
+    EXPECT_NEAR(0.6, world.position(box).y, 1e-5);
+    world.remove(box);
+    EXPECT_EQ(0, world.size());
+    EXPECT_NEAR(0.7, cube.pos.y, 1e-5);
+}
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+#include <glm/ext/vector_float3.hpp>
+#include "Graphics/geometry.hpp"
+
+namespace scene {
+    /**
+     * Convex hull of points moved to c.
+     */
+    inline std::unique_ptr<gmh::Polyhedron> hull(glm::vec3 c, const std::vector<glm::vec3>& points){
+        std::vector<gmh::Point> vert;
+        vert.reserve(points.size());
+        for(const glm::vec3& p: points) vert.emplace_back(c + p);
+        return std::make_unique<gmh::Polyhedron>(vert);
+    }
+
+    /**
+     * Corners of an axis aligned box from the origin to size, a unit crate by default.
+     */
+    inline std::vector<glm::vec3> crate_corners(glm::vec3 size = glm::vec3(1)){
+        return {glm::vec3(0, 0, 0), glm::vec3(size.x, 0, 0), glm::vec3(0, size.y, 0), glm::vec3(size.x, size.y, 0),
+            glm::vec3(0, 0, size.z), glm::vec3(size.x, 0, size.z), glm::vec3(0, size.y, size.z), size};
+    }
+
+    /**
+     * Axis aligned box with its lowest corner at c, see crate_corners().
+     */
+    inline std::unique_ptr<gmh::Polyhedron> crate(glm::vec3 c, glm::vec3 size = glm::vec3(1)){
+        return hull(c, crate_corners(size));
+    }
+
+    /**
+     * Corners of the 10 by 10 slab scenes stand on, its top face at z = 0.
+     */
+    inline std::vector<gmh::Point> floor_corners(){
+        return {glm::vec3(-5, -5, -1), glm::vec3(5, -5, -1), glm::vec3(-5, 5, -1), glm::vec3(5, 5, -1),
+            glm::vec3(-5, -5, 0), glm::vec3(5, -5, 0), glm::vec3(-5, 5, 0), glm::vec3(5, 5, 0)};
+    }
+}